@@ -38,14 +38,16 @@ from common import ObjectList
 from common import HMC
 
 def create_mem_intf(intf, r, i, intlv_bits, intlv_size,
-                    xor_low_bit):
+                    xor_low_bit, mapper=None):
     """
     Helper function for creating a single memoy controller from the given
     options.  This function is invoked multiple times in config_mem function
-    to create an array of controllers.
+    to create an array of controllers. If given a channel mapper, the
+    controller is its channel i rather than an interleaved part of r.
     """
 
     import math
+    from m5.util import fatal, warn
     intlv_low_bit = int(math.log(intlv_size, 2))
 
     # Use basic hashing for the channel selection, and preferably use
@@ -92,6 +94,29 @@ def create_mem_intf(intf, r, i, intlv_bits, intlv_size,
 
             intlv_low_bit = int(math.log(buffer_size, 2))
 
+    # The mapper spreads its range at the same granularity as the
+    # interleaving would, over whole periods of a granule per channel, so
+    # the range is rounded down to them
+    if mapper is not None:
+        granularity = 2 ** intlv_low_bit
+        period_size = int(mapper.channels) * granularity
+        size = r.size() // period_size * period_size
+        if size == 0:
+            fatal("The memory range %s is smaller than a granule of %d "
+                  "bytes for each of %d channels", r, granularity,
+                  int(mapper.channels))
+        if i == 0 and size != r.size():
+            warn("Leaving the top %d bytes of the memory range %s without "
+                 "memory, to spread it over whole periods of a %d byte "
+                 "granule for each of %d channels", r.size() - size, r,
+                 granularity, int(mapper.channels))
+        mapper.granularity = granularity
+        mapper.range = m5.objects.AddrRange(r.start, size=size)
+        interface.range = mapper.range
+        interface.channel_mapper = mapper
+        interface.channel = i
+        return interface
+
     # We got all we need to configure the appropriate address
     # range
     interface.range = m5.objects.AddrRange(r.start, size = r.size(),
@@ -134,6 +159,7 @@ def config_mem(options, system):
     opt_dram_powerdown = getattr(options, "enable_dram_powerdown", None)
     opt_mem_channels_intlv = getattr(options, "mem_channels_intlv", 128)
     opt_xor_low_bit = getattr(options, "xor_low_bit", 0)
+    opt_mem_channels_hash = getattr(options, "mem_channels_hash", None)
 
     if opt_mem_type == "HMC_2500_1x32":
         HMChost = HMC.config_hmc_host_ctrl(options, system)
@@ -166,8 +192,16 @@ def config_mem(options, system):
     import math
     from m5.util import fatal
     intlv_bits = int(math.log(nbr_mem_ctrls, 2))
-    if 2 ** intlv_bits != nbr_mem_ctrls:
-        fatal("Number of memory channels must be a power of 2")
+
+    # Interleaved ranges only split a range across a power of 2 of
+    # channels, so channel mappers take over for any other number of
+    # channels, or to hash the channels
+    use_mappers = 2 ** intlv_bits != nbr_mem_ctrls or opt_mem_channels_hash
+    if use_mappers and opt_mem_type == "HMC_2500_1x32":
+        fatal("The HMC does not support channel mappers")
+    hash_masks = [int(m, 0) for m in opt_mem_channels_hash.split(',')] \
+        if opt_mem_channels_hash else []
+    mappers = []
 
     if opt_mem_type:
         intf = ObjectList.mem_list.get(opt_mem_type)
@@ -196,11 +230,18 @@ def config_mem(options, system):
         # to DRAM and NVM if both configured, starting with DRAM
         range_iter += 1
 
+        mapper = None
+        if use_mappers:
+            mapper = m5.objects.ChannelMapper(range=r,
+                                              channels=nbr_mem_ctrls,
+                                              hash_masks=hash_masks)
+            mappers.append(mapper)
+
         for i in range(nbr_mem_ctrls):
             if opt_mem_type and (not opt_nvm_type or range_iter % 2 != 0):
                 # Create the DRAM interface
                 dram_intf = create_mem_intf(intf, r, i,
-                    intlv_bits, intlv_size, opt_xor_low_bit)
+                    intlv_bits, intlv_size, opt_xor_low_bit, mapper)
 
                 # Set the number of ranks based on the command-line
                 # options if it was explicitly set
@@ -224,7 +265,7 @@ def config_mem(options, system):
 
             elif opt_nvm_type and (not opt_mem_type or range_iter % 2 == 0):
                 nvm_intf = create_mem_intf(n_intf, r, i,
-                    intlv_bits, intlv_size, opt_xor_low_bit)
+                    intlv_bits, intlv_size, opt_xor_low_bit, mapper)
 
                 # Set the number of ranks based on the command-line
                 # options if it was explicitly set
@@ -259,3 +300,9 @@ def config_mem(options, system):
             mem_ctrls[i].port = xbar.mem_side_ports
 
     subsystem.mem_ctrls = mem_ctrls
+
+    # The channels are connected in order, which the crossbar numbers
+    # them by
+    if mappers:
+        subsystem.channel_mappers = mappers
+        xbar.channel_mappers = mappers
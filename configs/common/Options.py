@@ -121,7 +121,10 @@ def addNoISAOptions(parser):
                         choices=ObjectList.mem_list.get_names(),
                         help="type of memory to use")
     parser.add_argument("--mem-channels", type=int, default=1,
-                        help="number of memory channels")
+                        help="number of memory channels; other than a "
+                        "power of 2, each memory range is rounded down to "
+                        "a multiple of the channels times the interleaving "
+                        "granularity")
     parser.add_argument("--mem-ranks", type=int, default=None,
                         help="number of memory ranks per channel")
     parser.add_argument(
@@ -131,6 +134,13 @@ def addNoISAOptions(parser):
                         help="Enable low-power states in DRAMInterface")
     parser.add_argument("--mem-channels-intlv", type=int, default=0,
                         help="Memory channels interleave")
+    parser.add_argument("--mem-channels-hash", type=str, default=None,
+                        help="Comma-separated masks of the bits of the "
+                        "channel period index XOR-folded into each bit of "
+                        "the channel hash (any number of channels is "
+                        "mapped, hashed or not, each memory range being "
+                        "rounded down to a multiple of the channels times "
+                        "the interleaving granularity)")
 
     parser.add_argument("--memchecker", action="store_true")
 
@@ -0,0 +1,327 @@
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import argparse
+import itertools
+import json
+import os
+import time
+
+import m5
+import _m5.stats
+from m5.objects import *
+from m5.util import addToPath, fatal, inform
+
+addToPath('../')
+
+from common import ObjectList
+
+# This script benchmarks a memory controller configuration with a
+# closed-loop traffic generator: the generator keeps at most a given
+# number of requests outstanding, and is swept across the request rate,
+# the read/write mix, the stride and the bank locality of its traffic.
+# Every point of the sweep is warmed up, then measured on its own, and
+# reports the bandwidth and latency seen by the generator, the row hits
+# of the memory, and the number of transactions simulated per host
+# second. The points are written to a JSON file, so that runs of
+# different versions can be compared for regressions of either the
+# simulated memory or the simulator itself.
+#
+# Plotting the latency against the bandwidth of the points of a given
+# pattern and mix gives the loaded latency curve of the memory.
+
+parser = argparse.ArgumentParser()
+
+def int_list(arg):
+    return [int(x) for x in arg.split(',')]
+
+def float_list(arg):
+    return [float(x) for x in arg.split(',')]
+
+parser.add_argument("--mem-type", default="DDR4_2400_8x8",
+                    choices=ObjectList.mem_list.get_names(),
+                    help="type of memory to use, a DRAM or an NVM interface")
+
+parser.add_argument("--mem-ranks", "-r", type=int, default=None,
+                    help="number of ranks of the memory")
+
+parser.add_argument("--hbm-ctrl", action="store_true",
+                    help="drive two interfaces of the memory type as the "
+                    "pseudo channels of an HBMCtrl")
+
+parser.add_argument("--addr-map",
+                    choices=ObjectList.dram_addr_map_list.get_names(),
+                    default="RoRaBaCoCh", help="DRAM address map policy")
+
+parser.add_argument("--patterns", default="linear,random,strided,bank",
+                    help="comma-separated traffic patterns: linear, random, "
+                    "strided (swept over --strides) and bank (DRAM-aware, "
+                    "swept over --seq-bursts and --banks)")
+
+parser.add_argument("--rates", type=float_list,
+                    default=[0.1, 0.25, 0.5, 0.75, 0.9, 1.0, 1.25],
+                    help="request rates to sweep, as fractions of the peak "
+                    "bandwidth of the memory")
+
+parser.add_argument("--rd-percs", type=int_list, default=[100, 67, 0],
+                    help="percentages of reads to sweep")
+
+parser.add_argument("--strides", type=int_list, default=None,
+                    help="strides of the strided pattern, in bytes "
+                    "(default: 1, 4 and 16 bursts)")
+
+parser.add_argument("--seq-bursts", type=int_list, default=[1, 4],
+                    help="sequential bursts per bank access of the bank "
+                    "pattern, which sets its row locality")
+
+parser.add_argument("--banks", type=int_list, default=None,
+                    help="numbers of banks targeted by the bank pattern "
+                    "(default: 1, 4 and all of them)")
+
+parser.add_argument("--max-outstanding", type=int, default=64,
+                    help="requests the generator keeps in flight at most, "
+                    "which closes the loop")
+
+parser.add_argument("--warmup", type=float, default=10.0,
+                    help="warmup of each point, in microseconds")
+
+parser.add_argument("--duration", type=float, default=100.0,
+                    help="measurement of each point, in microseconds")
+
+parser.add_argument("--output", default="bench.json",
+                    help="file the results are written to, relative to the "
+                    "output directory")
+
+args = parser.parse_args()
+
+# a 2.0 GHz crossbar wide enough not to be the bottleneck
+system = System(membus=IOXBar(width=64))
+system.clk_domain = SrcClockDomain(clock='2.0GHz',
+                                   voltage_domain=VoltageDomain(voltage='1V'))
+
+mem_range = AddrRange('256MB')
+system.mem_ranges = [mem_range]
+
+# do not worry about reserving space for the backing store
+system.mmap_using_noreserve = True
+
+intf_class = ObjectList.mem_list.get(args.mem_type)
+is_dram = issubclass(intf_class, DRAMInterface)
+if not is_dram and not issubclass(intf_class, NVMInterface):
+    fatal("This script benchmarks DRAMInterface and NVMInterface memories")
+
+if args.hbm_ctrl:
+    if not is_dram:
+        fatal("The pseudo channels of an HBMCtrl are DRAM interfaces")
+    # the HBMCtrl interleaves its pseudo channels on address bit 6
+    intfs = [intf_class(range=AddrRange(mem_range.start,
+                                        size=mem_range.size(),
+                                        intlvHighBit=6, intlvBits=1,
+                                        intlvMatch=i))
+             for i in range(2)]
+    system.mem_ctrl = HBMCtrl(dram=intfs[0], dram_2=intfs[1])
+else:
+    intfs = [intf_class(range=mem_range)]
+    system.mem_ctrl = intfs[0].controller()
+
+for intf in intfs:
+    # there is no point slowing things down by saving any data
+    intf.null = True
+    if is_dram:
+        intf.addr_mapping = args.addr_map
+    if args.mem_ranks:
+        intf.ranks_per_channel = args.mem_ranks
+
+system.mem_ctrl.port = system.membus.mem_side_ports
+
+intf = intfs[0]
+nbr_banks = intf.banks_per_rank.value
+nbr_ranks = intf.ranks_per_channel.value
+
+# determine the burst length in bytes
+burst_size = int((intf.devices_per_rank.value *
+                  intf.device_bus_width.value *
+                  intf.burst_length.value) / 8)
+
+# next, get the page (or NVM buffer) size in bytes
+page_size = intf.devices_per_rank.value * \
+    intf.device_rowbuffer_size.value
+
+# the peak bandwidth of the memory, in bytes per tick (ps)
+t_burst = getattr(intf.tBURST_MIN, 'value', intf.tBURST.value) \
+    if is_dram else intf.tBURST.value
+peak_bw = len(intfs) * burst_size / (t_burst * 1e12)
+
+strides = args.strides or [burst_size, 4 * burst_size, 16 * burst_size]
+banks = args.banks or sorted({1, min(4, nbr_banks), nbr_banks})
+
+system.tgen = PyTrafficGen(max_outstanding_reqs=args.max_outstanding)
+system.tgen.port = system.membus.cpu_side_ports
+
+# connect the system port even if it is not used in this example
+system.system_port = system.membus.cpu_side_ports
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = 'timing'
+
+m5.instantiate()
+
+warmup = int(args.warmup * 1e6)
+duration = int(args.duration * 1e6)
+max_addr = mem_range.end
+addr_map = ObjectList.dram_addr_map_list.get(args.addr_map)
+
+def points():
+    """The points of the sweep, each with its pattern parameters."""
+    for pattern in args.patterns.split(','):
+        if pattern in ("linear", "random"):
+            shapes = [{}]
+        elif pattern == "strided":
+            shapes = [{"stride": s} for s in strides]
+        elif pattern == "bank":
+            shapes = [{"seq_bursts": s, "banks": b}
+                      for s, b in itertools.product(args.seq_bursts, banks)]
+        else:
+            fatal("Unknown traffic pattern %s" % pattern)
+        for shape, rd_perc, rate in itertools.product(
+                shapes, args.rd_percs, args.rates):
+            point = {"pattern": pattern, "rd_perc": rd_perc, "rate": rate}
+            point.update(shape)
+            yield point
+
+def create(point, duration):
+    """Creates the generator of a point, for the given duration."""
+    tgen = system.tgen
+    period = max(1, int(round(burst_size / (point["rate"] * peak_bw))))
+    rd_perc = point["rd_perc"]
+    pattern = point["pattern"]
+    if pattern == "linear":
+        return tgen.createLinear(duration, 0, max_addr, burst_size,
+                                 period, period, rd_perc, 0)
+    if pattern == "random":
+        return tgen.createRandom(duration, 0, max_addr, burst_size,
+                                 period, period, rd_perc, 0)
+    if pattern == "strided":
+        return tgen.createStrided(duration, 0, max_addr, burst_size,
+                                  point["stride"], 0,
+                                  period, period, rd_perc, 0)
+    generator = tgen.createDram if is_dram else tgen.createNvm
+    return generator(duration, 0, max_addr, burst_size, period, period,
+                     rd_perc, 0, point["seq_bursts"], page_size,
+                     nbr_banks, point["banks"], addr_map, nbr_ranks)
+
+def trace(sweep):
+    # each point runs its warmup and its measurement as states of their
+    # own, each followed by an exit so that the stats can be handled
+    for point in sweep:
+        yield create(point, warmup)
+        yield system.tgen.createExit(0)
+        yield create(point, duration)
+        yield system.tgen.createExit(0)
+
+def scalars(obj):
+    """@return The scalar stats of a SimObject, by name."""
+    return { stat.name: stat.value
+             for stat in obj.getCCObject().getStats()
+             if isinstance(stat, _m5.stats.ScalarInfo) }
+
+def measure(point):
+    """Runs the measurement of a point, and adds its results to it."""
+    start_tick = m5.curTick()
+    start_time = time.time()
+    m5.simulate()
+    host_seconds = time.time() - start_time
+    sim_seconds = (m5.curTick() - start_tick) / 1e12
+
+    gen = scalars(system.tgen)
+    reads, writes = gen["totalReads"], gen["totalWrites"]
+    transactions = reads + writes
+    bytes_moved = gen["bytesRead"] + gen["bytesWritten"]
+
+    bursts = row_hits = 0
+    for intf in intfs:
+        mem = scalars(intf)
+        bursts += mem["readBursts"] + mem["writeBursts"]
+        if is_dram:
+            row_hits += mem["readRowHits"] + mem["writeRowHits"]
+
+    # latencies are in ns, bandwidths in GB/s
+    point.update({
+        "offered_bw": point["rate"] * peak_bw * 1e3,
+        "bw": bytes_moved / sim_seconds / 1e9,
+        "read_bw": gen["bytesRead"] / sim_seconds / 1e9,
+        "write_bw": gen["bytesWritten"] / sim_seconds / 1e9,
+        "read_latency":
+            gen["totalReadLatency"] / reads / 1e3 if reads else None,
+        "write_latency":
+            gen["totalWriteLatency"] / writes / 1e3 if writes else None,
+        "row_hit_rate": row_hits / bursts if is_dram and bursts else None,
+        "transactions": transactions,
+        "host_seconds": host_seconds,
+        "host_tps": transactions / host_seconds if host_seconds else None,
+    })
+
+sweep = list(points())
+system.tgen.start(trace(sweep))
+
+total_time = time.time()
+for point in sweep:
+    # run the warmup, and drop what it counted
+    m5.simulate()
+    m5.stats.reset()
+    measure(point)
+    inform("%s rd %d%% at %.2f of peak: %.2f GB/s, %s ns reads" %
+           (point["pattern"], point["rd_perc"], point["rate"], point["bw"],
+            "%.1f" % point["read_latency"] if point["read_latency"]
+            else "no"))
+total_time = time.time() - total_time
+
+results = {
+    "config": {
+        "mem_type": args.mem_type,
+        "controller": type(system.mem_ctrl).__name__,
+        "interfaces": len(intfs),
+        "ranks": nbr_ranks,
+        "banks": nbr_banks,
+        "addr_map": args.addr_map if is_dram else None,
+        "burst_size": burst_size,
+        "page_size": page_size,
+        "peak_bw": peak_bw * 1e3,
+        "max_outstanding": args.max_outstanding,
+        "warmup_us": args.warmup,
+        "duration_us": args.duration,
+    },
+    "points": sweep,
+    "host_seconds": total_time,
+    "host_tps": sum(p["transactions"] for p in sweep) / total_time,
+}
+
+output = os.path.join(m5.options.outdir, args.output)
+with open(output, 'w') as f:
+    json.dump(results, f, indent=2)
+
+print("Memory benchmark of %d points written to %s, %.0f transactions per "
+      "host second" % (len(sweep), output, results["host_tps"]))
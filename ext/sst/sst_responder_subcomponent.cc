@@ -203,7 +203,7 @@ SSTResponderSubComponent::portEventHandler(
 
         // make Req/Pkt for Snoop/no response needed
         // presently no consideration for masterId, packet type, flags...
-        gem5::RequestPtr req = std::make_shared<gem5::Request>(
+        gem5::RequestPtr req = gem5::Request::create(
             request->addr, request->size, 0, 0
         );
 
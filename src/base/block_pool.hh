@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BLOCK_POOL_HH__
+#define __BASE_BLOCK_POOL_HH__
+
+#include <cstddef>
+#include <new>
+
+namespace gem5
+{
+
+/**
+ * A per-thread pool of memory blocks of a fixed size, for objects that
+ * are created and destroyed at a high rate, such as packets and requests.
+ * Freed blocks are kept on a free list threaded through the blocks
+ * themselves, and handed out again before new blocks are carved from a
+ * chunk, so that once the pool is warm allocating and freeing a block are
+ * a couple of loads and stores.
+ *
+ * A block freed by another thread than the one that allocated it simply
+ * joins the free list of that other thread. Chunks are deliberately never
+ * returned to the system, so that objects with static storage duration
+ * can still free their blocks when they are destroyed at exit.
+ *
+ * @tparam Size The size of a block, in bytes.
+ * @tparam Align The alignment of a block.
+ */
+template <std::size_t Size, std::size_t Align = alignof(std::max_align_t)>
+class BlockPool
+{
+  public:
+    /** @return An uninitialized block. */
+    static void *
+    allocate()
+    {
+        FreeList &list = freeList();
+        if (list.head == nullptr)
+            refill(list);
+        Block *block = list.head;
+        list.head = block->next;
+        return block;
+    }
+
+    /** Returns a block obtained through allocate() to the pool. */
+    static void
+    deallocate(void *ptr)
+    {
+        if (ptr == nullptr)
+            return;
+        FreeList &list = freeList();
+        Block *block = static_cast<Block *>(ptr);
+        block->next = list.head;
+        list.head = block;
+    }
+
+  private:
+    union Block
+    {
+        Block *next;
+        alignas(Align) unsigned char storage[Size];
+    };
+
+    /** Number of blocks carved from a chunk at once. */
+    static constexpr std::size_t blocksPerChunk =
+        Size >= 4096 ? 8 : 32 * 1024 / sizeof(Block);
+
+    struct FreeList
+    {
+        Block *head;
+    };
+
+    static FreeList &
+    freeList()
+    {
+        // Trivially destructible, so that it outlives any static object
+        thread_local FreeList list = { nullptr };
+        return list;
+    }
+
+    static void
+    refill(FreeList &list)
+    {
+        Block *chunk = static_cast<Block *>(::operator new(
+            sizeof(Block) * blocksPerChunk, std::align_val_t(alignof(Block))));
+        for (std::size_t i = 0; i < blocksPerChunk; ++i) {
+            chunk[i].next = i + 1 < blocksPerChunk ? &chunk[i + 1] : nullptr;
+        }
+        list.head = chunk;
+    }
+};
+
+/**
+ * Pools of blocks of 8 bytes up to MaxSize bytes, in powers of two, for
+ * buffers of varying size. Larger buffers come from the heap.
+ *
+ * @tparam MaxSize The size of the largest pooled buffer, a power of two.
+ */
+template <std::size_t MaxSize>
+class SizeClassPools
+{
+    static_assert(MaxSize >= 8 && (MaxSize & (MaxSize - 1)) == 0,
+                  "Size classes are powers of two of at least 8 bytes");
+
+  public:
+    /** @return An uninitialized buffer of at least size bytes. */
+    static void *allocate(std::size_t size) { return allocateFrom<8>(size); }
+
+    /**
+     * Returns a buffer obtained through allocate() to its pool.
+     * @param size The size the buffer was allocated with.
+     */
+    static void
+    deallocate(void *ptr, std::size_t size)
+    {
+        deallocateTo<8>(ptr, size);
+    }
+
+  private:
+    template <std::size_t Size>
+    static void *
+    allocateFrom(std::size_t size)
+    {
+        if constexpr (Size < MaxSize) {
+            if (size > Size)
+                return allocateFrom<Size * 2>(size);
+        } else if (size > Size) {
+            return ::operator new(size);
+        }
+        return BlockPool<Size, 8>::allocate();
+    }
+
+    template <std::size_t Size>
+    static void
+    deallocateTo(void *ptr, std::size_t size)
+    {
+        if constexpr (Size < MaxSize) {
+            if (size > Size)
+                return deallocateTo<Size * 2>(ptr, size);
+        } else if (size > Size) {
+            return ::operator delete(ptr);
+        }
+        BlockPool<Size, 8>::deallocate(ptr);
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_BLOCK_POOL_HH__
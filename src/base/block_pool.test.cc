@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+
+#include "base/block_pool.hh"
+
+using namespace gem5;
+
+TEST(BlockPoolTest, ReusesFreedBlocks)
+{
+    typedef BlockPool<48> Pool;
+
+    std::set<void *> blocks;
+    for (int i = 0; i < 100; i++) {
+        void *block = Pool::allocate();
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(block) %
+                  alignof(std::max_align_t), 0);
+        ASSERT_TRUE(blocks.insert(block).second);
+    }
+
+    // The last block freed is the first handed out again
+    for (auto block : blocks)
+        Pool::deallocate(block);
+    Pool::deallocate(nullptr);
+    void *reused = Pool::allocate();
+    ASSERT_EQ(reused, *blocks.rbegin());
+    Pool::deallocate(reused);
+}
+
+TEST(BlockPoolTest, SizeClasses)
+{
+    typedef SizeClassPools<64> Pools;
+
+    // Buffers of the same size class share their pool
+    void *small = Pools::allocate(20);
+    Pools::deallocate(small, 20);
+    void *same_class = Pools::allocate(32);
+    ASSERT_EQ(same_class, small);
+    Pools::deallocate(same_class, 32);
+
+    void *other_class = Pools::allocate(33);
+    ASSERT_NE(other_class, small);
+    Pools::deallocate(other_class, 33);
+
+    // Larger buffers come from the heap
+    void *large = Pools::allocate(1000);
+    static_cast<char *>(large)[999] = 0;
+    Pools::deallocate(large, 1000);
+}
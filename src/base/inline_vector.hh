@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_INLINE_VECTOR_HH__
+#define __BASE_INLINE_VECTOR_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * A vector that keeps its first N elements inside the object itself, and
+ * only spills to the heap when it grows beyond them. Spilled buffers come
+ * from, and return to, a per-thread pool of buffers of the same element
+ * type and inline size, so that a vector that repeatedly grows and
+ * shrinks, or many short lived ones, stop hitting the allocator once the
+ * pool is warm.
+ *
+ * Elements are only ever copy or move constructed and destroyed, never
+ * assigned, so types with const members can be held. Iterators are plain
+ * pointers and, as for std::vector, are invalidated by insertions that
+ * grow the vector and by erasures before them.
+ *
+ * @tparam T The element type.
+ * @tparam N The number of elements held inline.
+ */
+template <class T, std::size_t N>
+class InlineVector
+{
+    static_assert(N > 0, "An inline vector needs inline storage");
+
+  public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    InlineVector()
+        : _data(inlineData()), _size(0), _capacity(N), spillClass(0)
+    {}
+
+    InlineVector(const InlineVector &other) : InlineVector()
+    {
+        reserve(other.size());
+        for (const auto &elem : other)
+            emplace_back(elem);
+    }
+
+    InlineVector(InlineVector &&other) : InlineVector()
+    {
+        take(std::move(other));
+    }
+
+    InlineVector &
+    operator=(const InlineVector &other)
+    {
+        if (this != &other) {
+            clear();
+            reserve(other.size());
+            for (const auto &elem : other)
+                emplace_back(elem);
+        }
+        return *this;
+    }
+
+    InlineVector &
+    operator=(InlineVector &&other)
+    {
+        if (this != &other) {
+            clear();
+            take(std::move(other));
+        }
+        return *this;
+    }
+
+    ~InlineVector()
+    {
+        clear();
+        releaseSpill();
+    }
+
+    iterator begin() { return _data; }
+    iterator end() { return _data + _size; }
+    const_iterator begin() const { return _data; }
+    const_iterator end() const { return _data + _size; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    size_type size() const { return _size; }
+    size_type capacity() const { return _capacity; }
+    bool empty() const { return _size == 0; }
+
+    /** @return Whether the elements live outside the object. */
+    bool spilled() const { return _data != inlineData(); }
+
+    reference operator[](size_type idx) { return _data[idx]; }
+    const_reference operator[](size_type idx) const { return _data[idx]; }
+
+    reference front() { assert(_size); return _data[0]; }
+    const_reference front() const { assert(_size); return _data[0]; }
+    reference back() { assert(_size); return _data[_size - 1]; }
+    const_reference back() const { assert(_size); return _data[_size - 1]; }
+
+    template <typename... Args>
+    reference
+    emplace_back(Args&&... args)
+    {
+        if (_size == _capacity) {
+            // The arguments may refer to an element about to move
+            T elem(std::forward<Args>(args)...);
+            grow(_size + 1);
+            new (_data + _size) T(std::move(elem));
+            return _data[_size++];
+        }
+        T *elem = new (_data + _size) T(std::forward<Args>(args)...);
+        ++_size;
+        return *elem;
+    }
+
+    void push_back(const T &elem) { emplace_back(elem); }
+    void push_back(T &&elem) { emplace_back(std::move(elem)); }
+
+    void
+    pop_back()
+    {
+        assert(_size);
+        _data[--_size].~T();
+    }
+
+    /**
+     * Removes the elements in [first, last), shifting the following ones
+     * down.
+     * @return An iterator to the element that followed the last one
+     * removed.
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        T *dst = const_cast<T *>(first);
+        T *src = const_cast<T *>(last);
+        assert(_data <= dst && dst <= src && src <= end());
+        if (dst == src)
+            return dst;
+
+        for (T *it = dst; it != src; ++it)
+            it->~T();
+        for (T *it = src; it != end(); ++it, ++dst) {
+            new (dst) T(std::move(*it));
+            it->~T();
+        }
+        const T *ret = first;
+        _size -= src - first;
+        return const_cast<T *>(ret);
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    /** Destroys all elements, keeping the storage. */
+    void
+    clear()
+    {
+        for (auto &elem : *this)
+            elem.~T();
+        _size = 0;
+    }
+
+    void
+    reserve(size_type count)
+    {
+        if (count > _capacity)
+            grow(count);
+    }
+
+  private:
+    /**
+     * Free spill buffers, by size class: class k holds room for N << k
+     * elements. The pool is deliberately never destroyed, so that vectors
+     * with static storage duration can still return their buffers to it
+     * when they are destroyed at exit.
+     */
+    struct SpillPool
+    {
+        static constexpr unsigned numClasses = 32;
+        std::vector<T *> free[numClasses];
+    };
+
+    static SpillPool &
+    pool()
+    {
+        thread_local SpillPool *spill_pool = new SpillPool;
+        return *spill_pool;
+    }
+
+    T *inlineData() { return reinterpret_cast<T *>(inlineStorage); }
+    const T *
+    inlineData() const
+    {
+        return reinterpret_cast<const T *>(inlineStorage);
+    }
+
+    /** Moves the elements to a spill buffer holding at least count. */
+    void
+    grow(size_type count)
+    {
+        unsigned new_class = spillClass + 1;
+        while ((N << new_class) < count)
+            ++new_class;
+        assert(new_class < SpillPool::numClasses);
+
+        auto &free_list = pool().free[new_class];
+        T *new_data;
+        if (free_list.empty()) {
+            new_data = static_cast<T *>(
+                ::operator new(sizeof(T) * (N << new_class)));
+        } else {
+            new_data = free_list.back();
+            free_list.pop_back();
+        }
+
+        for (size_type i = 0; i < _size; ++i) {
+            new (new_data + i) T(std::move(_data[i]));
+            _data[i].~T();
+        }
+
+        releaseSpill();
+        _data = new_data;
+        _capacity = N << new_class;
+        spillClass = new_class;
+    }
+
+    /** Returns the spill buffer, if any, to the pool. */
+    void
+    releaseSpill()
+    {
+        if (spilled()) {
+            pool().free[spillClass].push_back(_data);
+            _data = inlineData();
+            _capacity = N;
+            spillClass = 0;
+        }
+    }
+
+    /** Takes the elements of an empty-handed other vector. */
+    void
+    take(InlineVector &&other)
+    {
+        assert(empty());
+        if (other.spilled()) {
+            // Steal the buffer instead of moving the elements
+            releaseSpill();
+            _data = other._data;
+            _size = other._size;
+            _capacity = other._capacity;
+            spillClass = other.spillClass;
+            other._data = other.inlineData();
+            other._size = 0;
+            other._capacity = N;
+            other.spillClass = 0;
+        } else {
+            reserve(other.size());
+            for (auto &elem : other)
+                emplace_back(std::move(elem));
+            other.clear();
+        }
+    }
+
+    alignas(T) unsigned char inlineStorage[N * sizeof(T)];
+    T *_data;
+    size_type _size;
+    size_type _capacity;
+    /** Size class of the spill buffer, 0 while inline. */
+    uint8_t spillClass;
+};
+
+} // namespace gem5
+
+#endif // __BASE_INLINE_VECTOR_HH__
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "base/inline_vector.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** An element that cannot be assigned, and counts its live instances. */
+struct Element
+{
+    static int live;
+
+    const int value;
+    std::unique_ptr<int> owned;
+
+    Element(int v) : value(v), owned(new int(v)) { live++; }
+    Element(const Element &other)
+        : value(other.value), owned(new int(*other.owned))
+    {
+        live++;
+    }
+    Element(Element &&other)
+        : value(other.value), owned(std::move(other.owned))
+    {
+        live++;
+    }
+    ~Element() { live--; }
+};
+
+int Element::live = 0;
+
+} // anonymous namespace
+
+TEST(InlineVectorTest, StaysInline)
+{
+    InlineVector<int, 4> vec;
+    ASSERT_TRUE(vec.empty());
+    ASSERT_EQ(vec.capacity(), 4);
+
+    for (int i = 0; i < 4; i++)
+        vec.push_back(i);
+    ASSERT_EQ(vec.size(), 4);
+    ASSERT_FALSE(vec.spilled());
+    ASSERT_EQ(vec.front(), 0);
+    ASSERT_EQ(vec.back(), 3);
+}
+
+TEST(InlineVectorTest, SpillsAndReusesBuffers)
+{
+    int *spill_buffer;
+    {
+        InlineVector<int, 2> vec;
+        for (int i = 0; i < 5; i++)
+            vec.push_back(i);
+        ASSERT_TRUE(vec.spilled());
+        ASSERT_GE(vec.capacity(), 5);
+        for (int i = 0; i < 5; i++)
+            ASSERT_EQ(vec[i], i);
+        spill_buffer = vec.begin();
+    }
+
+    // The buffer went back to the pool, and is handed out again
+    InlineVector<int, 2> vec;
+    for (int i = 0; i < 5; i++)
+        vec.push_back(i);
+    ASSERT_EQ(vec.begin(), spill_buffer);
+}
+
+TEST(InlineVectorTest, Erase)
+{
+    InlineVector<Element, 2> vec;
+    for (int i = 0; i < 6; i++)
+        vec.emplace_back(i);
+
+    // Erase a range in the middle, then the front
+    auto it = vec.erase(vec.begin() + 1, vec.begin() + 3);
+    ASSERT_EQ(it->value, 3);
+    it = vec.erase(vec.begin());
+    ASSERT_EQ(it->value, 3);
+
+    ASSERT_EQ(vec.size(), 3);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(vec[i].value, i + 3);
+        ASSERT_EQ(*vec[i].owned, i + 3);
+    }
+    ASSERT_EQ(Element::live, 3);
+
+    vec.clear();
+    ASSERT_EQ(Element::live, 0);
+}
+
+TEST(InlineVectorTest, CopyAndMove)
+{
+    {
+        InlineVector<Element, 2> small, large;
+        small.emplace_back(1);
+        for (int i = 0; i < 3; i++)
+            large.emplace_back(i);
+
+        InlineVector<Element, 2> small_copy(small), large_copy(large);
+        ASSERT_EQ(small_copy.size(), 1);
+        ASSERT_EQ(large_copy.size(), 3);
+        ASSERT_EQ(*large_copy[2].owned, 2);
+
+        // Moving a spilled vector steals its buffer
+        const Element *large_data = large.begin();
+        InlineVector<Element, 2> large_moved(std::move(large));
+        ASSERT_EQ(large_moved.begin(), large_data);
+        ASSERT_TRUE(large.empty());
+        ASSERT_FALSE(large.spilled());
+
+        InlineVector<Element, 2> small_moved;
+        small_moved = std::move(small);
+        ASSERT_EQ(small_moved.size(), 1);
+        ASSERT_EQ(*small_moved[0].owned, 1);
+        ASSERT_TRUE(small.empty());
+
+        // Growing from one of its own elements
+        small_moved.push_back(small_moved[0]);
+        small_moved.push_back(small_moved[0]);
+        ASSERT_EQ(small_moved.size(), 3);
+        ASSERT_EQ(*small_moved[2].owned, 1);
+    }
+    ASSERT_EQ(Element::live, 0);
+}
@@ -41,6 +41,8 @@
 #ifndef __BASE_REFCNT_HH__
 #define __BASE_REFCNT_HH__
 
+#include <cstddef>
+#include <functional>
 #include <type_traits>
 
 /**
@@ -260,6 +262,9 @@ class RefCountingPtr
 
     /// Check if the pointer is non-empty
     operator bool() const { return data != 0; }
+
+    /// Drop the reference, if any, leaving the pointer empty
+    void reset() { set(nullptr); }
 };
 
 /// Check for equality of two reference counting pointers.
@@ -314,6 +319,52 @@ operator!=(const T *l, const RefCountingPtr<T> &r)
     return l != r.get();
 }
 
+/// Check if a reference counting pointer is empty
+template<class T>
+inline bool
+operator==(const RefCountingPtr<T> &l, std::nullptr_t)
+{
+    return !l;
+}
+
+template<class T>
+inline bool
+operator==(std::nullptr_t, const RefCountingPtr<T> &r)
+{
+    return !r;
+}
+
+/// Check if a reference counting pointer is non-empty
+template<class T>
+inline bool
+operator!=(const RefCountingPtr<T> &l, std::nullptr_t)
+{
+    return bool(l);
+}
+
+template<class T>
+inline bool
+operator!=(std::nullptr_t, const RefCountingPtr<T> &r)
+{
+    return bool(r);
+}
+
 } // namespace gem5
 
+namespace std
+{
+
+/// Hash reference counting pointers by the object they point to
+template<class T>
+struct hash<gem5::RefCountingPtr<T>>
+{
+    size_t
+    operator()(const gem5::RefCountingPtr<T> &ptr) const
+    {
+        return hash<T *>()(ptr.get());
+    }
+};
+
+} // namespace std
+
 #endif // __BASE_REFCNT_HH__
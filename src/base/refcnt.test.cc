@@ -32,6 +32,7 @@
 #include <gtest/gtest.h>
 
 #include <list>
+#include <unordered_set>
 
 #include "base/refcnt.hh"
 
@@ -172,3 +173,26 @@ TEST(RefcntTest, EqualityOperators)
     EXPECT_TRUE(equalTestAPtr != equalTestB);
     EXPECT_TRUE(equalTestAPtr != equalTestBPtr);
 }
+
+TEST(RefcntTest, NullptrComparisonAndReset)
+{
+    Ptr nullTest;
+    EXPECT_TRUE(nullTest == nullptr);
+    EXPECT_FALSE(nullptr != nullTest);
+
+    Ptr resetTest = new TestRC();
+    EXPECT_TRUE(resetTest != nullptr);
+    EXPECT_EQ(1, liveListSize());
+    resetTest.reset();
+    EXPECT_TRUE(nullptr == resetTest);
+    EXPECT_EQ(0, liveListSize());
+}
+
+TEST(RefcntTest, Hash)
+{
+    Ptr hashTest = new TestRC();
+    std::unordered_set<Ptr> hashSet;
+    hashSet.insert(hashTest);
+    EXPECT_EQ(1, hashSet.count(hashTest));
+    EXPECT_EQ(0, hashSet.count(Ptr()));
+}
@@ -39,6 +39,7 @@
 from m5.defines import buildEnv
 from m5.params import *
 from m5.proxy import *
+from m5.SimObject import *
 
 from m5.objects.BaseCPU import BaseCPU
 from m5.objects.FUPool import *
@@ -54,11 +55,21 @@ class SMTQueuePolicy(ScopedEnum):
 class CommitPolicy(ScopedEnum):
     vals = [ 'RoundRobin', 'OldestReady' ]
 
+class MemDepPredictorType(ScopedEnum):
+    vals = [ 'StoreSet', 'StoreVector' ]
+
+class StoreSetClearPolicy(ScopedEnum):
+    vals = [ 'Wipe', 'Decay' ]
+
 class BaseO3CPU(BaseCPU):
     type = 'BaseO3CPU'
     cxx_class = 'gem5::o3::CPU'
     cxx_header = 'cpu/o3/dyn_inst.hh'
 
+    cxx_exports = [
+        PyBindMethod("warmLoadValuesFrom"),
+    ]
+
     @classmethod
     def memory_mode(cls):
         return 'timing'
@@ -137,6 +148,22 @@ class BaseO3CPU(BaseCPU):
             "should be invalidated")
     LFSTSize = Param.Unsigned(1024, "Last fetched store table size")
     SSITSize = Param.Unsigned(1024, "Store set ID table size")
+    SSITAssoc = Param.Unsigned(1, "Store set ID table associativity")
+    SSITTagBits = Param.Unsigned(0,
+            "Store set ID table tag width (0 leaves the table untagged)")
+    SSITConfBits = Param.Unsigned(2,
+            "Store set ID table per-entry confidence counter width")
+    store_set_clear_policy = Param.StoreSetClearPolicy('Wipe',
+            "Whether the store set clear period wipes the SSIT or only "
+            "decays the entry confidences")
+    memDepPredictor = Param.MemDepPredictorType('StoreSet',
+            "Memory dependence predictor used by the memory dependence unit")
+    storeVectorTableSize = Param.Unsigned(1024,
+            "Store vector predictor table size")
+    storeVectorLength = Param.Unsigned(32,
+            "Number of older stores tracked by each store vector (max 64)")
+    storeVectorHashes = Param.Unsigned(2,
+            "Number of hashes indexing the store vector table")
 
     numRobs = Param.Unsigned(1, "Number of Reorder Buffers");
 
@@ -152,6 +179,9 @@ class BaseO3CPU(BaseCPU):
     numPhysCCRegs = Param.Unsigned(0, "Number of physical cc registers")
     numIQEntries = Param.Unsigned(64, "Number of instruction queue entries")
     numROBEntries = Param.Unsigned(192, "Number of reorder buffer entries")
+    numRenameCheckpoints = Param.Unsigned(0, "Number of rename map "
+            "checkpoints per thread, taken at branches to restore the map "
+            "on a mispredict (0 to walk the history buffer instead)")
 
     smtNumFetchingThreads = Param.Unsigned(1, "SMT Number of Fetching Threads")
     smtFetchPolicy = Param.SMTFetchPolicy('RoundRobin', "SMT Fetch policy")
@@ -171,6 +201,9 @@ class BaseO3CPU(BaseCPU):
                                        "Branch Predictor")
     needsTSO = Param.Bool(False, "Enable TSO Memory model")
 
+    profileHostTime = Param.Bool(False, "Count the host time spent in each "
+            "pipeline stage (not available in gem5.fast)")
+
     
     LCTEntries = Param.Unsigned(1024, "Number  of LCT entries")
     LCTCtrBits = Param.Unsigned(2, "Bits per counter")
@@ -148,6 +148,15 @@ namespace o3
         tids.resize(numThreads);
     }
 
+    if (params.profileHostTime) {
+#ifndef NDEBUG
+        hostProfile.reset(new HostProfile(this));
+#else
+        warn("%s: Host time profiling is not available in gem5.fast.\n",
+             name());
+#endif
+    }
+
     // The stages also need their CPU pointer setup.  However this
     // must be done at the upper level CPU because they have pointers
     // to the upper level CPU, and not this CPU.
@@ -316,6 +325,9 @@ CPU::regProbePoints()
     ppDataAccessComplete = new ProbePointArg<
         std::pair<DynInstPtr, PacketPtr>>(
                 getProbeManager(), "DataAccessComplete");
+    ppConstantLoad = new probing::ConstantLoad(
+            getProbeManager(), "ConstantLoad");
+    ppLoadValue = new probing::LoadValue(getProbeManager(), "LoadValue");
 
     fetch.regProbePoints();
     rename.regProbePoints();
@@ -462,16 +474,23 @@ CPU::tick()
 
 //    activity = false;
 
+    HostProfileTimer profile_timer(hostProfile.get());
+
     //Tick each of the stages
     fetch.tick();
+    profile_timer.lap(HostProfile::Fetch);
 
     decode.tick();
+    profile_timer.lap(HostProfile::Decode);
 
     rename.tick();
+    profile_timer.lap(HostProfile::Rename);
 
     iew.tick();
+    profile_timer.lap(HostProfile::IEW);
 
     commit.tick();
+    profile_timer.lap(HostProfile::Commit);
 
     // Now advance the time buffers
     timeBuffer.advance();
@@ -995,6 +1014,7 @@ CPU::takeOverFrom(BaseCPU *oldCPU)
     rename.takeOverFrom();
     iew.takeOverFrom();
     commit.takeOverFrom();
+    lvpunit.takeOverFrom();
 
     assert(!tickEvent.scheduled());
 
@@ -1006,6 +1026,30 @@ CPU::takeOverFrom(BaseCPU *oldCPU)
     _status = Idle;
 }
 
+void
+CPU::warmLoadValuesFrom(SimObject *obj)
+{
+    // The threads of the other CPU train the predictor of the ones they
+    // are switched with, which have the same ids
+    BaseCPU *other = dynamic_cast<BaseCPU *>(obj);
+    fatal_if(!other || other->numThreads != numThreads,
+             "%s: can only warm load values from a CPU with as many "
+             "threads, not from %s\n", name(), obj->name());
+
+    loadValueWarmers.emplace_back(
+        new LoadValueWarmer(*this, obj->getProbeManager(), "LoadValue"));
+}
+
+void
+CPU::LoadValueWarmer::notify(const probing::LoadValueInfo &info)
+{
+    // Only the loads the other CPU executes on our behalf are of interest
+    if (cpu.switchedOut() && !info.predicted) {
+        cpu.lvpunit.warm(info.tid, info.pc, info.addr, info.value,
+                         info.size);
+    }
+}
+
 void
 CPU::verifyMemoryMode() const
 {
@@ -1543,7 +1587,7 @@ CPU::htmSendAbortSignal(ThreadID tid, uint64_t htm_uid,
 
     // notify l1 d-cache (ruby) that core has aborted transaction
     RequestPtr req =
-        std::make_shared<Request>(addr, size, flags, _dataRequestorId);
+        Request::create(addr, size, flags, _dataRequestorId);
 
     req->taskId(taskId());
     req->setContext(thread[tid]->contextId());
@@ -45,6 +45,7 @@
 
 #include <iostream>
 #include <list>
+#include <memory>
 #include <queue>
 #include <set>
 #include <vector>
@@ -58,6 +59,7 @@
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/fetch.hh"
 #include "cpu/o3/free_list.hh"
+#include "cpu/o3/host_profile.hh"
 #include "cpu/o3/iew.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/rename.hh"
@@ -69,6 +71,7 @@
 #include "cpu/simple_thread.hh"
 #include "cpu/timebuf.hh"
 #include "params/BaseO3CPU.hh"
+#include "sim/probe/mem.hh"
 #include "sim/process.hh"
 
 #include "lvp_unit.hh"
@@ -176,9 +179,24 @@ class CPU : public BaseCPU
     ProbePointArg<PacketPtr> *ppInstAccessComplete;
     ProbePointArg<std::pair<DynInstPtr, PacketPtr> > *ppDataAccessComplete;
 
+    /** Loads the LVP unit has found to hold a constant value. */
+    probing::ConstantLoad *ppConstantLoad;
+
+    /** Load values predicted, and then returned, for the LVP unit. */
+    probing::LoadValue *ppLoadValue;
+
     /** Register probe points. */
     void regProbePoints() override;
 
+    /**
+     * Trains the LVP unit with the load values another CPU reports
+     * through its LoadValue probe point while this CPU is switched out,
+     * e.g., an atomic CPU functionally warming the predictor. Each
+     * thread of the other CPU trains the thread of the same id.
+     * @param obj The CPU to listen to, with as many threads.
+     */
+    void warmLoadValuesFrom(SimObject *obj);
+
     void
     demapPage(Addr vaddr, uint64_t asn)
     {
@@ -400,10 +418,33 @@ class CPU : public BaseCPU
      */
     bool removeInstsThisCycle;
 
+    /** Per-stage host time counters, only allocated if host time
+     *  profiling is enabled.
+     */
+    std::unique_ptr<HostProfile> hostProfile;
+
   protected:
     /** The load value predictor **/
     LVPUnit lvpunit; // change
 
+    /** Warms the LVP unit with the load values of another CPU. */
+    class LoadValueWarmer
+        : public ProbeListenerArgBase<probing::LoadValueInfo>
+    {
+      public:
+        LoadValueWarmer(CPU &_cpu, ProbeManager *pm,
+                        const std::string &name)
+            : ProbeListenerArgBase(pm, name), cpu(_cpu)
+        {}
+
+        void notify(const probing::LoadValueInfo &info) override;
+
+      private:
+        CPU &cpu;
+    };
+
+    std::vector<std::unique_ptr<LoadValueWarmer>> loadValueWarmers;
+
     /** The fetch stage. */
     Fetch fetch;
 
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/host_profile.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+HostProfile::HostProfile(statistics::Group *parent)
+    : statistics::Group(parent, "hostProfile"),
+      ADD_STAT(hostTicks, statistics::units::Count::get(),
+               "Host timestamp counter ticks spent in each stage"),
+      ADD_STAT(calls, statistics::units::Count::get(),
+               "Number of times each stage was entered"),
+      ADD_STAT(hostTicksPerCall, statistics::units::Rate<
+                    statistics::units::Count, statistics::units::Count>::get(),
+               "Average host timestamp counter ticks per call",
+               hostTicks / calls)
+{
+    hostTicks.init(NumStages);
+    calls.init(NumStages);
+
+    const char *stage_names[NumStages] = {
+        "Fetch", "Decode", "Rename", "IEW", "Commit", "LSQ", "LVPUnit"
+    };
+    for (int i = 0; i < NumStages; i++) {
+        hostTicks.subname(i, stage_names[i]);
+        calls.subname(i, stage_names[i]);
+        hostTicksPerCall.subname(i, stage_names[i]);
+    }
+
+    hostTicksPerCall.precision(2);
+}
+
+} // namespace o3
+} // namespace gem5
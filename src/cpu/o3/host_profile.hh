@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_HOST_PROFILE_HH__
+#define __CPU_O3_HOST_PROFILE_HH__
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "base/statistics.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Host time spent in the stages of the O3 pipeline, measured in host
+ * timestamp counter ticks. The time of a stage includes the time of
+ * the units it calls, e.g. the LSQ is also accounted to IEW and the
+ * LVP unit to the stage that looks it up. The counters are only
+ * updated by the HostProfileTimer and HostProfileScope helpers below,
+ * which compile to nothing in gem5.fast.
+ */
+class HostProfile : public statistics::Group
+{
+  public:
+    enum Stage
+    {
+        Fetch,
+        Decode,
+        Rename,
+        IEW,
+        Commit,
+        LSQ,
+        LVPUnit,
+        NumStages
+    };
+
+    HostProfile(statistics::Group *parent);
+
+    /** Reads the host timestamp counter. */
+    static uint64_t
+    now()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t cnt;
+        asm volatile("mrs %0, cntvct_el0" : "=r" (cnt));
+        return cnt;
+#else
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+    }
+
+    void
+    record(Stage stage, uint64_t host_ticks)
+    {
+        hostTicks[stage] += host_ticks;
+        ++calls[stage];
+    }
+
+    /** Host timestamp counter ticks spent per stage. */
+    statistics::Vector hostTicks;
+    /** Number of times each stage was entered. */
+    statistics::Vector calls;
+    /** Average host ticks per call of each stage. */
+    statistics::Formula hostTicksPerCall;
+};
+
+#ifndef NDEBUG
+
+/**
+ * Accounts the host time between consecutive calls of lap() to the
+ * given stages. Used to profile code that calls several stages in a
+ * row with a single timestamp read per stage.
+ */
+class HostProfileTimer
+{
+  public:
+    HostProfileTimer(HostProfile *_profile)
+        : profile(_profile), last(profile ? HostProfile::now() : 0)
+    {}
+
+    void
+    lap(HostProfile::Stage stage)
+    {
+        if (profile) {
+            const uint64_t cur = HostProfile::now();
+            profile->record(stage, cur - last);
+            last = cur;
+        }
+    }
+
+  private:
+    HostProfile *profile;
+    uint64_t last;
+};
+
+/** Accounts the host time until the end of the scope to a stage. */
+class HostProfileScope
+{
+  public:
+    HostProfileScope(HostProfile *_profile, HostProfile::Stage _stage)
+        : profile(_profile), stage(_stage),
+          start(profile ? HostProfile::now() : 0)
+    {}
+
+    ~HostProfileScope()
+    {
+        if (profile)
+            profile->record(stage, HostProfile::now() - start);
+    }
+
+  private:
+    HostProfile *profile;
+    HostProfile::Stage stage;
+    uint64_t start;
+};
+
+#else // NDEBUG
+
+class HostProfileTimer
+{
+  public:
+    HostProfileTimer(HostProfile *) {}
+    void lap(HostProfile::Stage) {}
+};
+
+class HostProfileScope
+{
+  public:
+    HostProfileScope(HostProfile *, HostProfile::Stage) {}
+};
+
+#endif // NDEBUG
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_HOST_PROFILE_HH__
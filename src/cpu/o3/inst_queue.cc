@@ -89,6 +89,7 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
     : cpu(cpu_ptr),
       iewStage(iew_ptr),
       fuPool(params.fuPool),
+      nonSpecInsts(2 * params.numROBEntries),
       iqPolicy(params.smtIQPolicy),
       numThreads(params.numThreads),
       numEntries(params.numIQEntries),
@@ -618,7 +619,7 @@ InstructionQueue::insertNonSpec(const DynInstPtr &new_inst)
 
     assert(new_inst);
 
-    nonSpecInsts[new_inst->seqNum] = new_inst;
+    nonSpecInsts.insert(new_inst->seqNum, new_inst);
 
     DPRINTF(IQ, "Adding non-speculative instruction [sn:%llu] PC %s "
             "to the IQ.\n",
@@ -923,25 +924,23 @@ InstructionQueue::scheduleNonSpec(const InstSeqNum &inst)
     DPRINTF(IQ, "Marking nonspeculative instruction [sn:%llu] as ready "
             "to execute.\n", inst);
 
-    NonSpecMapIt inst_it = nonSpecInsts.find(inst);
+    DynInstPtr *inst_it = nonSpecInsts.find(inst);
 
-    assert(inst_it != nonSpecInsts.end());
+    assert(inst_it);
 
-    ThreadID tid = (*inst_it).second->threadNumber;
+    ThreadID tid = (*inst_it)->threadNumber;
 
-    (*inst_it).second->setAtCommit();
+    (*inst_it)->setAtCommit();
 
-    (*inst_it).second->setCanIssue();
+    (*inst_it)->setCanIssue();
 
-    if (!(*inst_it).second->isMemRef()) {
-        addIfReady((*inst_it).second);
+    if (!(*inst_it)->isMemRef()) {
+        addIfReady(*inst_it);
     } else {
-        memDepUnit[tid].nonSpecInstReady((*inst_it).second);
+        memDepUnit[tid].nonSpecInstReady(*inst_it);
     }
 
-    (*inst_it).second = NULL;
-
-    nonSpecInsts.erase(inst_it);
+    nonSpecInsts.erase(inst);
 }
 
 void
@@ -1259,24 +1258,16 @@ InstructionQueue::doSquash(ThreadID tid)
 
             } else if (!squashed_inst->isStoreConditional() ||
                        !squashed_inst->isCompleted()) {
-                NonSpecMapIt ns_inst_it =
-                    nonSpecInsts.find(squashed_inst->seqNum);
-
                 // we remove non-speculative instructions from
                 // nonSpecInsts already when they are ready, and so we
                 // cannot always expect to find them
-                if (ns_inst_it == nonSpecInsts.end()) {
+                if (!nonSpecInsts.erase(squashed_inst->seqNum)) {
                     // loads that became ready but stalled on a
                     // blocked cache are alreayd removed from
                     // nonSpecInsts, and have not faulted
                     assert(squashed_inst->getFault() != NoFault ||
                            squashed_inst->isMemRef());
                 } else {
-
-                    (*ns_inst_it).second = NULL;
-
-                    nonSpecInsts.erase(ns_inst_it);
-
                     ++iqStats.squashedNonSpecRemoved;
                 }
             }
@@ -1467,15 +1458,11 @@ InstructionQueue::dumpLists()
 
     cprintf("Non speculative list size: %i\n", nonSpecInsts.size());
 
-    NonSpecMapIt non_spec_it = nonSpecInsts.begin();
-    NonSpecMapIt non_spec_end_it = nonSpecInsts.end();
-
     cprintf("Non speculative list: ");
 
-    while (non_spec_it != non_spec_end_it) {
-        cprintf("%s [sn:%llu]", (*non_spec_it).second->pcState(),
-                (*non_spec_it).second->seqNum);
-        ++non_spec_it;
+    for (const auto &non_spec : nonSpecInsts.sorted()) {
+        cprintf("%s [sn:%llu]", non_spec.second->pcState(),
+                non_spec.second->seqNum);
     }
 
     cprintf("\n");
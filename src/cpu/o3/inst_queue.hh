@@ -55,6 +55,7 @@
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/mem_dep_unit.hh"
+#include "cpu/o3/non_spec_ring.hh"
 #include "cpu/o3/store_set.hh"
 #include "cpu/op_class.hh"
 #include "cpu/timebuf.hh"
@@ -363,9 +364,7 @@ class InstructionQueue
      *  the sequence number will be available.  Thus it is most efficient to be
      *  able to search by the sequence number alone.
      */
-    std::map<InstSeqNum, DynInstPtr> nonSpecInsts;
-
-    typedef std::map<InstSeqNum, DynInstPtr>::iterator NonSpecMapIt;
+    NonSpecInstRing nonSpecInsts;
 
     /** Entry for the list age ordering by op class. */
     struct ListOrderEntry
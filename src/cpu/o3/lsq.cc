@@ -49,6 +49,7 @@
 #include "base/logging.hh"
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/dyn_inst.hh"
+#include "cpu/o3/host_profile.hh"
 #include "cpu/o3/iew.hh"
 #include "cpu/o3/limits.hh"
 #include "debug/Drain.hh"
@@ -179,6 +180,9 @@ LSQ::takeOverFrom()
 void
 LSQ::tick()
 {
+    HostProfileScope profile_scope(cpu->hostProfile.get(),
+                                   HostProfile::LSQ);
+
     // Re-issue loads which got blocked on the per-cycle load ports limit.
     if (usedLoadPorts == cacheLoadPorts && !_cacheBlocked)
         iewStage->cacheUnblocked();
@@ -241,6 +245,9 @@ LSQ::insertStore(const DynInstPtr &store_inst)
 Fault
 LSQ::executeLoad(const DynInstPtr &inst)
 {
+    HostProfileScope profile_scope(cpu->hostProfile.get(),
+                                   HostProfile::LSQ);
+
     ThreadID tid = inst->threadNumber;
 
     return thread[tid].executeLoad(inst);
@@ -249,6 +256,9 @@ LSQ::executeLoad(const DynInstPtr &inst)
 Fault
 LSQ::executeStore(const DynInstPtr &inst)
 {
+    HostProfileScope profile_scope(cpu->hostProfile.get(),
+                                   HostProfile::LSQ);
+
     ThreadID tid = inst->threadNumber;
 
     return thread[tid].executeStore(inst);
@@ -269,6 +279,9 @@ LSQ::commitStores(InstSeqNum &youngest_inst, ThreadID tid)
 void
 LSQ::writebackStores()
 {
+    HostProfileScope profile_scope(cpu->hostProfile.get(),
+                                   HostProfile::LSQ);
+
     std::list<ThreadID>::iterator threads = activeThreads->begin();
     std::list<ThreadID>::iterator end = activeThreads->end();
 
@@ -407,6 +420,9 @@ LSQ::completeDataAccess(PacketPtr pkt)
 bool
 LSQ::recvTimingResp(PacketPtr pkt)
 {
+    HostProfileScope profile_scope(cpu->hostProfile.get(),
+                                   HostProfile::LSQ);
+
     if (pkt->isError())
         DPRINTF(LSQ, "Got error packet back for address: %#X\n",
                 pkt->getAddr());
@@ -846,7 +862,7 @@ LSQ::pushRequest(const DynInstPtr& inst, bool isLoad, uint8_t *data,
             inst->effAddrValid(true);
 
             if (cpu->checker) {
-                inst->reqToVerify = std::make_shared<Request>(*request->req());
+                inst->reqToVerify = Request::create(*request->req());
             }
             Fault fault;
 
@@ -1000,7 +1016,7 @@ LSQ::SplitDataRequest::initiateTranslation()
     Addr final_addr = addrBlockAlign(_addr + _size, cacheLineSize);
     uint32_t size_so_far = 0;
 
-    _mainReq = std::make_shared<Request>(base_addr,
+    _mainReq = Request::create(base_addr,
                 _size, _flags, _inst->requestorId(),
                 _inst->pcState().instAddr(), _inst->contextId());
     _mainReq->setByteEnable(_byteEnable);
@@ -1117,7 +1133,7 @@ LSQ::LSQRequest::addReq(Addr addr, unsigned size,
            const std::vector<bool>& byte_enable)
 {
     if (isAnyActiveElement(byte_enable.begin(), byte_enable.end())) {
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
                 addr, size, _flags, _inst->requestorId(),
                 _inst->pcState().instAddr(), _inst->contextId(),
                 std::move(_amo_op));
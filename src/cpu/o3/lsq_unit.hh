@@ -411,7 +411,7 @@ class LSQUnit
     RequestPort *dcachePort;
 
     /** Writeback event, specifically for when stores forward data to loads. */
-    class WritebackEvent : public Event
+    class WritebackEvent : public Event, public PooledEvent<WritebackEvent>
     {
       public:
         /** Constructs a writeback event. */
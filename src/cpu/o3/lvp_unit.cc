@@ -1,6 +1,9 @@
+#include "cpu/o3/cpu.hh"
 #include "cpu/o3/dyn_inst.hh"
+#include "cpu/o3/host_profile.hh"
 #include "cpu/o3/lvp_unit.hh"
 #include <algorithm>
+#include <cstring>
 #include "arch/generic/pcstate.hh"
 #include "base/compiler.hh"
 #include "base/trace.hh"
@@ -17,6 +20,7 @@ namespace o3
 
 LVPUnit::LVPUnit(CPU *_cpu, const BaseO3CPUParams &params)
     : SimObject(params),
+        cpu(_cpu),
         numThreads(params.numThreads),
         // predHist(numThreads),
         stats(_cpu),
@@ -37,6 +41,9 @@ LVPUnit::LVPUnit(CPU *_cpu, const BaseO3CPUParams &params)
 
 bool LVPUnit::predict(const DynInstPtr &inst)
 {
+    HostProfileScope profile_scope(cpu->hostProfile.get(),
+                                   HostProfile::LVPUnit);
+
     // See if LCT predicts predictible.
     // If so, get its value from LVPT.
 
@@ -70,6 +77,8 @@ bool LVPUnit::predict(const DynInstPtr &inst)
             inst->PredictedLdValue(ld_predict_val);
             inst -> setLdConstant(counter_val == 3);
             inst -> setLdPredictible(true);
+            cpu->ppLoadValue->notify({tid, pc.instAddr(), 0, ld_predict_val,
+                                      0, true});
     
             DPRINTF(LVPUnit, "lvpt_pred: [tid:%i] [sn:%llu] PC:0x%x ld_val = %llu LVP predicted predictible\n", inst->threadNumber, inst->seqNum, inst->pcState(), ld_predict_val);
             return true;
@@ -90,61 +99,100 @@ bool LVPUnit::predict(const DynInstPtr &inst)
 
 void LVPUnit::update(const DynInstPtr &inst)
 {
+    HostProfileScope profile_scope(cpu->hostProfile.get(),
+                                   HostProfile::LVPUnit);
+
     //can use  effAddrValid()
 
     uint64_t mem_ld_value = *(inst->memData);
     const PCStateBase &pc = inst->pcState();
-    ThreadID tid = inst->threadNumber;
 
+    cpu->ppLoadValue->notify({inst->threadNumber, pc.instAddr(),
+                              inst->effAddr, mem_ld_value, inst->effSize,
+                              false});
+
+    if (train(inst->threadNumber, inst->seqNum, pc.instAddr(),
+              inst->effAddr, mem_ld_value, inst->effSize,
+              inst->PredictedLdValue())) {
+        stats.ldvalIncorrect++;
+    }
+}
 
-    bool valid_entry = lvpt.valid(pc.instAddr(), tid);
+void LVPUnit::warm(ThreadID tid, Addr pc, Addr addr, uint64_t value,
+                   unsigned size)
+{
+    HostProfileScope profile_scope(cpu->hostProfile.get(),
+                                   HostProfile::LVPUnit);
+
+    // The loads of the CPU train on the first byte of their value only
+    uint8_t first_byte;
+    std::memcpy(&first_byte, &value, sizeof(first_byte));
+
+    // Had the load been decoded, it would have been predicted with the
+    // value the LVPT currently holds
+    const uint64_t pred_value = lvpt.valid(pc, tid) ?
+        lvpt.lookup(pc, tid) : 0;
+    train(tid, 0, pc, addr, first_byte, size, pred_value);
+}
+
+void LVPUnit::takeOverFrom()
+{
+    // Stores went by unseen while the CPU was switched out, so none of the
+    // constant values can be trusted anymore
+    cvu.reset();
+}
+
+bool LVPUnit::train(ThreadID tid, InstSeqNum seq_num, Addr pc, Addr addr,
+                    uint64_t mem_ld_value, unsigned size,
+                    uint64_t pred_ld_value)
+{
+    bool valid_entry = lvpt.valid(pc, tid);
 
     if (!valid_entry)
     {
         DPRINTF(LVPUnit, "lvp_fresh_add: [tid:%i] [sn:%llu] PC:0x%x data_addr:%llu ld_val:%u \n",
-            inst->threadNumber, inst->seqNum, pc.instAddr(), inst->effAddr, *(inst->memData));
+            tid, seq_num, pc, addr, mem_ld_value);
 
-        lvpt.update(pc.instAddr(), mem_ld_value, tid);
-        lct.update(tid, pc.instAddr(), true, false);
+        lvpt.update(pc, mem_ld_value, tid);
+        lct.update(tid, pc, true, false);
+        return false;
     }
-    else
-    {       
-        uint64_t lvpt_ld_value = lvpt.lookup(pc.instAddr(), tid);
-        uint64_t pred_ld_value = inst->PredictedLdValue();
 
-        if (lvpt_ld_value != pred_ld_value)
+    uint64_t lvpt_ld_value = lvpt.lookup(pc, tid);
+
+    if (lvpt_ld_value != pred_ld_value)
+    {
+        DPRINTF(LVPUnit, "lvp_update: [tid:%i] [sn:%llu] PC:0x%x lvpt_ld_value:%llu pred_ld_value:%llu  mem_ld_value=%llu **** LVPT ENTRY != PREDICTED VALUE ***\n",
+                tid, seq_num, pc, lvpt_ld_value, pred_ld_value, mem_ld_value);
+        return false;
+    }
+
+    DPRINTF(LVPUnit, "lvp_update: [tid:%i] [sn:%llu] PC:0x%x lvpt_ld_value:%llu pred_ld_value:%llu  mem_ld_value=%llu LVPT ENTRY == PREDICTED VALUE\n",
+            tid, seq_num, pc, lvpt_ld_value, pred_ld_value, mem_ld_value);
+
+    if (pred_ld_value == mem_ld_value)
+    {
+        // make the counter to predictible
+        lct.update(tid, pc, true, false);
+
+        if (lct.lookup(tid, pc) == 3)
         {
-            DPRINTF(LVPUnit, "lvp_update: [tid:%i] [sn:%llu] PC:0x%x lvpt_ld_value:%llu pred_ld_value:%llu  mem_ld_value=%llu **** LVPT ENTRY != PREDICTED VALUE ***\n",
-                    inst->threadNumber, inst->seqNum, pc.instAddr(), lvpt_ld_value, pred_ld_value, mem_ld_value);
+            cvu.update(pc, addr, mem_ld_value, tid);
+            cpu->ppConstantLoad->notify({addr, pc, mem_ld_value, size});
         }
-        else
-        {
-            DPRINTF(LVPUnit, "lvp_update: [tid:%i] [sn:%llu] PC:0x%x lvpt_ld_value:%llu pred_ld_value:%llu  mem_ld_value=%llu LVPT ENTRY == PREDICTED VALUE\n",
-                    inst->threadNumber, inst->seqNum, pc.instAddr(), lvpt_ld_value, pred_ld_value, mem_ld_value);
-    
-            if (pred_ld_value == mem_ld_value)
-            {
-                // make the counter to predictible
-                lct.update(tid, pc.instAddr(), true, false);
-
-                if (lct.lookup(tid, pc.instAddr()) == 3)
-                {
-                    cvu.update(pc.instAddr(), inst->effAddr, mem_ld_value, tid);
-                }
-            }
-            else
-            {
-                // make the counter to not predictible
-                lct.update(tid, pc.instAddr(), false, false);
-                lvpt.update(pc.instAddr(), mem_ld_value, tid);
-
-                stats.ldvalIncorrect++;
-            }
-         }
+        return false;
     }
+
+    // make the counter to not predictible
+    lct.update(tid, pc, false, false);
+    lvpt.update(pc, mem_ld_value, tid);
+    return true;
 }
 
 void LVPUnit::cvu_invalidate(const DynInstPtr &inst) {
+    HostProfileScope profile_scope(cpu->hostProfile.get(),
+                                   HostProfile::LVPUnit);
+
     const PCStateBase &pc = inst->pcState();
     Addr instPC = pc.instAddr();
     Addr StdataAddr = inst->effAddr;
@@ -157,6 +205,9 @@ void LVPUnit::cvu_invalidate(const DynInstPtr &inst) {
 }
 
 bool LVPUnit::cvu_valid(const DynInstPtr &inst) {
+    HostProfileScope profile_scope(cpu->hostProfile.get(),
+                                   HostProfile::LVPUnit);
+
     const PCStateBase &pc = inst->pcState();
     Addr instPC = pc.instAddr();
     Addr LwdataAddr = inst-> effAddr;
@@ -52,6 +52,23 @@ class LVPUnit : public SimObject
      */
     void update(const DynInstPtr &inst);
 
+    /**
+     * Trains the LCT and LVPT with a load executed while the CPU is
+     * switched out, for instance by an atomic CPU functionally warming
+     * the predictor. The load is taken to have been predicted with the
+     * value the LVPT holds for it.
+     * @param tid The thread id.
+     * @param pc The PC of the load.
+     * @param addr The data address of the load.
+     * @param value The value the load returned.
+     * @param size The size of the load, in bytes.
+     */
+    void warm(ThreadID tid, Addr pc, Addr addr, uint64_t value,
+              unsigned size);
+
+    /** Drops the state that is stale after the CPU was switched out. */
+    void takeOverFrom();
+
     void cvu_invalidate(const DynInstPtr &inst);
 
     bool cvu_valid(const DynInstPtr &inst);
@@ -78,6 +95,18 @@ class LVPUnit : public SimObject
     // void dump();
 
   private:
+    /**
+     * Updates the tables with the value a load returned.
+     * @param pred_ld_value The value the load was predicted with.
+     * @return Whether the load was mispredicted.
+     */
+    bool train(ThreadID tid, InstSeqNum seq_num, Addr pc, Addr addr,
+               uint64_t mem_ld_value, unsigned size,
+               uint64_t pred_ld_value);
+
+    /** Pointer to the CPU, used to reach its host time profile. */
+    CPU *cpu;
+
     const unsigned numThreads;
 
     struct LVPUnitStats : public statistics::Group
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_NON_SPEC_RING_HH__
+#define __CPU_O3_NON_SPEC_RING_HH__
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/o3/dyn_inst_ptr.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Holds the non-speculative instructions waiting in the IQ for commit to
+ * schedule them, indexed directly by sequence number.  Every live entry
+ * is in the ROB, so the sequence numbers in flight span little more than
+ * the ROB, and a ring of twice that size almost never sees two entries
+ * map to the same slot.  When they do, the younger entry goes to a small
+ * ordered overflow map, which is only consulted while it is non-empty.
+ */
+class NonSpecInstRing
+{
+  public:
+    /** Creates a ring with at least the given number of slots. */
+    explicit NonSpecInstRing(size_t min_size)
+        : slots(size_t(1) << ceilLog2(min_size < 2 ? 2 : min_size)),
+          indexMask(slots.size() - 1)
+    {}
+
+    /** Adds an instruction under the given sequence number. */
+    void
+    insert(InstSeqNum seq_num, const DynInstPtr &inst)
+    {
+        Slot &slot = slots[seq_num & indexMask];
+        if (!slot.inst || slot.seqNum == seq_num) {
+            numInSlots += !slot.inst;
+            slot.seqNum = seq_num;
+            slot.inst = inst;
+        } else {
+            overflow[seq_num] = inst;
+        }
+    }
+
+    /** @return A pointer to the instruction with the given sequence
+     * number, or nullptr if it is not in the ring. */
+    DynInstPtr *
+    find(InstSeqNum seq_num)
+    {
+        Slot &slot = slots[seq_num & indexMask];
+        if (slot.inst && slot.seqNum == seq_num)
+            return &slot.inst;
+        if (overflow.empty())
+            return nullptr;
+        auto it = overflow.find(seq_num);
+        return it == overflow.end() ? nullptr : &it->second;
+    }
+
+    /** Removes the instruction with the given sequence number.
+     * @return Whether it was in the ring. */
+    bool
+    erase(InstSeqNum seq_num)
+    {
+        Slot &slot = slots[seq_num & indexMask];
+        if (slot.inst && slot.seqNum == seq_num) {
+            slot.inst = nullptr;
+            --numInSlots;
+            return true;
+        }
+        return !overflow.empty() && overflow.erase(seq_num);
+    }
+
+    size_t size() const { return numInSlots + overflow.size(); }
+
+    bool empty() const { return size() == 0; }
+
+    void
+    clear()
+    {
+        for (auto &slot : slots)
+            slot.inst = nullptr;
+        numInSlots = 0;
+        overflow.clear();
+    }
+
+    /** @return All held instructions, oldest first.  Meant for debug
+     * dumps only. */
+    std::map<InstSeqNum, DynInstPtr>
+    sorted() const
+    {
+        std::map<InstSeqNum, DynInstPtr> all(overflow);
+        for (const auto &slot : slots) {
+            if (slot.inst)
+                all[slot.seqNum] = slot.inst;
+        }
+        return all;
+    }
+
+  private:
+    struct Slot
+    {
+        InstSeqNum seqNum = 0;
+        DynInstPtr inst;
+    };
+
+    std::vector<Slot> slots;
+
+    /** Mask to turn a sequence number into a slot index. */
+    const size_t indexMask;
+
+    /** Number of occupied slots. */
+    size_t numInSlots = 0;
+
+    /** Entries whose slot was taken by another live instruction. */
+    std::map<InstSeqNum, DynInstPtr> overflow;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_NON_SPEC_RING_HH__
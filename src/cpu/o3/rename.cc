@@ -65,6 +65,7 @@ Rename::Rename(CPU *_cpu, const BaseO3CPUParams &params)
       commitToRenameDelay(params.commitToRenameDelay),
       renameWidth(params.renameWidth),
       numThreads(params.numThreads),
+      numCheckpoints(params.numRenameCheckpoints),
       stats(_cpu)
 {
     if (renameWidth > MaxWidth)
@@ -86,6 +87,10 @@ Rename::Rename(CPU *_cpu, const BaseO3CPUParams &params)
         serializeInst[tid] = nullptr;
         serializeOnNextInst[tid] = false;
     }
+
+    checkpoints.reserve(numThreads);
+    for (ThreadID tid = 0; tid < numThreads; tid++)
+        checkpoints.emplace_back(numCheckpoints);
 }
 
 std::string
@@ -138,6 +143,12 @@ Rename::RenameStats::RenameStats(statistics::Group *parent)
                "Number of HB maps that are committed"),
       ADD_STAT(undoneMaps, statistics::units::Count::get(),
                "Number of HB maps that are undone due to squashing"),
+      ADD_STAT(checkpointRestores, statistics::units::Count::get(),
+               "Number of squashes that restored the rename map from a "
+               "checkpoint"),
+      ADD_STAT(checkpointFullEvents, statistics::units::Count::get(),
+               "Number of times rename has blocked due to no free "
+               "checkpoints"),
       ADD_STAT(serializing, statistics::units::Count::get(),
                "count of serializing insts renamed"),
       ADD_STAT(tempSerializing, statistics::units::Count::get(),
@@ -170,6 +181,8 @@ Rename::RenameStats::RenameStats(statistics::Group *parent)
 
     committedMaps.prereq(committedMaps);
     undoneMaps.prereq(undoneMaps);
+    checkpointRestores.prereq(checkpointRestores);
+    checkpointFullEvents.prereq(checkpointFullEvents);
     serializing.flags(statistics::total);
     tempSerializing.flags(statistics::total);
     skidInsts.flags(statistics::total);
@@ -242,6 +255,8 @@ Rename::clearStates(ThreadID tid)
     storesInProgress[tid] = 0;
 
     serializeOnNextInst[tid] = false;
+
+    checkpoints[tid].flush();
 }
 
 void
@@ -272,6 +287,8 @@ Rename::resetStage()
         storesInProgress[tid] = 0;
 
         serializeOnNextInst[tid] = false;
+
+        checkpoints[tid].flush();
     }
 }
 
@@ -626,6 +643,14 @@ Rename::renameInsts(ThreadID tid)
             }
         }
 
+        if (!inst->isSquashed() && needsCheckpoint(inst) &&
+            checkpoints[tid].full()) {
+            DPRINTF(Rename, "[tid:%i] Cannot rename due to no free "
+                    "checkpoints\n", tid);
+            ++stats.checkpointFullEvents;
+            break;
+        }
+
         insts_to_rename.pop_front();
 
         if (renameStatus[tid] == Unblocking) {
@@ -711,6 +736,10 @@ Rename::renameInsts(ThreadID tid)
 
         renameDestRegs(inst, inst->threadNumber);
 
+        if (needsCheckpoint(inst)) {
+            takeCheckpoint(inst, tid);
+        }
+
         if (inst->isAtomic() || inst->isStore()) {
             storesInProgress[tid]++;
         } else if (inst->isLoad()) {
@@ -911,20 +940,33 @@ Rename::unblock(ThreadID tid)
 void
 Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
 {
-    auto hb_it = historyBuffer[tid].begin();
+    // Checkpoints of squashed branches are of no use anymore. If the
+    // squash was caused by a branch that has a checkpoint, the rename
+    // map is restored from it in one go and the history buffer only
+    // needs to be walked to free the registers.
+    auto &thread_cps = checkpoints[tid];
+    while (!thread_cps.empty() &&
+           thread_cps.back().instSeqNum > squashed_seq_num) {
+        thread_cps.pop_back();
+    }
+
+    const bool restore = !thread_cps.empty() &&
+        thread_cps.back().instSeqNum == squashed_seq_num;
+
+    auto &history = historyBuffer[tid];
 
     // After a syscall squashes everything, the history buffer may be empty
     // but the ROB may still be squashing instructions.
     // Go through the most recent instructions, undoing the mappings
     // they did and freeing up the registers.
-    while (!historyBuffer[tid].empty() &&
-           hb_it->instSeqNum > squashed_seq_num) {
-        assert(hb_it != historyBuffer[tid].end());
+    while (!history.empty() &&
+           history.front().instSeqNum > squashed_seq_num) {
+        RenameHistory &hb_entry = history.front();
 
         DPRINTF(Rename, "[tid:%i] Removing history entry with sequence "
                 "number %i (archReg: %d, newPhysReg: %d, prevPhysReg: %d).\n",
-                tid, hb_it->instSeqNum, hb_it->archReg.index(),
-                hb_it->newPhysReg->index(), hb_it->prevPhysReg->index());
+                tid, hb_entry.instSeqNum, hb_entry.archReg.index(),
+                hb_entry.newPhysReg->index(), hb_entry.prevPhysReg->index());
 
         // Undo the rename mapping only if it was really a change.
         // Special regs that are not really renamed (like misc regs
@@ -932,25 +974,36 @@ Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
         // is the same as the old one.  While it would be merely a
         // waste of time to update the rename table, we definitely
         // don't want to put these on the free list.
-        if (hb_it->newPhysReg != hb_it->prevPhysReg) {
+        if (hb_entry.newPhysReg != hb_entry.prevPhysReg) {
             // Tell the rename map to set the architected register to the
-            // previous physical register that it was renamed to.
-            renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
+            // previous physical register that it was renamed to, unless
+            // the whole map is restored from a checkpoint below.
+            if (!restore)
+                renameMap[tid]->setEntry(hb_entry.archReg,
+                                         hb_entry.prevPhysReg);
 
             // Put the renamed physical register back on the free list.
-            freeList->addReg(hb_it->newPhysReg);
+            freeList->addReg(hb_entry.newPhysReg);
         }
 
         // Notify potential listeners that the register mapping needs to be
         // removed because the instruction it was mapped to got squashed. Note
-        // that this is done before hb_it is incremented.
-        ppSquashInRename->notify(std::make_pair(hb_it->instSeqNum,
-                                                hb_it->newPhysReg));
+        // that this is done before the entry is removed.
+        ppSquashInRename->notify(std::make_pair(hb_entry.instSeqNum,
+                                                hb_entry.newPhysReg));
 
-        historyBuffer[tid].erase(hb_it++);
+        history.pop_front();
 
         ++stats.undoneMaps;
     }
+
+    if (restore) {
+        DPRINTF(Rename, "[tid:%i] Restoring rename map from checkpoint "
+                "[sn:%llu].\n", tid, squashed_seq_num);
+
+        *renameMap[tid] = thread_cps.back().map;
+        ++stats.checkpointRestores;
+    }
 }
 
 void
@@ -960,14 +1013,19 @@ Rename::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
             "history buffer %u (size=%i), until [sn:%llu].\n",
             tid, tid, historyBuffer[tid].size(), inst_seq_num);
 
-    auto hb_it = historyBuffer[tid].end();
+    // Checkpoints of committed branches can never be restored.
+    auto &thread_cps = checkpoints[tid];
+    while (!thread_cps.empty() &&
+           thread_cps.front().instSeqNum <= inst_seq_num) {
+        thread_cps.pop_front();
+    }
 
-    --hb_it;
+    auto &history = historyBuffer[tid];
 
-    if (historyBuffer[tid].empty()) {
+    if (history.empty()) {
         DPRINTF(Rename, "[tid:%i] History buffer is empty.\n", tid);
         return;
-    } else if (hb_it->instSeqNum > inst_seq_num) {
+    } else if (history.back().instSeqNum > inst_seq_num) {
         DPRINTF(Rename, "[tid:%i] [sn:%llu] "
                 "Old sequence number encountered. "
                 "Ensure that a syscall happened recently.\n",
@@ -979,26 +1037,26 @@ Rename::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
     // number. Some or even all of the committed instructions may not have
     // rename histories if they did not have destination registers that were
     // renamed.
-    while (!historyBuffer[tid].empty() &&
-           hb_it != historyBuffer[tid].end() &&
-           hb_it->instSeqNum <= inst_seq_num) {
+    while (!history.empty() &&
+           history.back().instSeqNum <= inst_seq_num) {
+        RenameHistory &hb_entry = history.back();
 
         DPRINTF(Rename, "[tid:%i] Freeing up older rename of reg %i (%s), "
                 "[sn:%llu].\n",
-                tid, hb_it->prevPhysReg->index(),
-                hb_it->prevPhysReg->className(),
-                hb_it->instSeqNum);
+                tid, hb_entry.prevPhysReg->index(),
+                hb_entry.prevPhysReg->className(),
+                hb_entry.instSeqNum);
 
         // Don't free special phys regs like misc and zero regs, which
         // can be recognized because the new mapping is the same as
         // the old one.
-        if (hb_it->newPhysReg != hb_it->prevPhysReg) {
-            freeList->addReg(hb_it->prevPhysReg);
+        if (hb_entry.newPhysReg != hb_entry.prevPhysReg) {
+            freeList->addReg(hb_entry.prevPhysReg);
         }
 
         ++stats.committedMaps;
 
-        historyBuffer[tid].erase(hb_it--);
+        history.pop_back();
     }
 }
 
@@ -1123,6 +1181,31 @@ Rename::renameDestRegs(const DynInstPtr &inst, ThreadID tid)
     }
 }
 
+bool
+Rename::needsCheckpoint(const DynInstPtr &inst) const
+{
+    // Only branches that can be resolved as mispredicted in IEW need a
+    // checkpoint, direct unconditional ones are fixed up by decode.
+    return numCheckpoints &&
+        (inst->isCondCtrl() || inst->isIndirectCtrl());
+}
+
+void
+Rename::takeCheckpoint(const DynInstPtr &inst, ThreadID tid)
+{
+    auto &thread_cps = checkpoints[tid];
+    assert(!thread_cps.full());
+
+    // Copy into the storage of the slot instead of constructing a new
+    // map, the vectors of an old checkpoint are reused.
+    thread_cps.advance_tail();
+    thread_cps.back().instSeqNum = inst->seqNum;
+    thread_cps.back().map = *renameMap[tid];
+
+    DPRINTF(Rename, "[tid:%i] [sn:%llu] Checkpointed rename map "
+            "(%i in use).\n", tid, inst->seqNum, thread_cps.size());
+}
+
 int
 Rename::calcFreeROBEntries(ThreadID tid)
 {
@@ -1400,7 +1483,7 @@ Rename::incrFullStat(const FullSource &source)
 void
 Rename::dumpHistory()
 {
-    std::list<RenameHistory>::iterator buf_it;
+    std::deque<RenameHistory>::iterator buf_it;
 
     for (ThreadID tid = 0; tid < numThreads; tid++) {
 
@@ -42,9 +42,12 @@
 #ifndef __CPU_O3_RENAME_HH__
 #define __CPU_O3_RENAME_HH__
 
+#include <deque>
 #include <list>
 #include <utility>
+#include <vector>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/commit.hh"
@@ -52,6 +55,7 @@
 #include "cpu/o3/free_list.hh"
 #include "cpu/o3/iew.hh"
 #include "cpu/o3/limits.hh"
+#include "cpu/o3/rename_map.hh"
 #include "cpu/timebuf.hh"
 #include "sim/probe/probe.hh"
 
@@ -254,6 +258,14 @@ class Rename
     /** Renames the destination registers of an instruction. */
     void renameDestRegs(const DynInstPtr &inst, ThreadID tid);
 
+    /** Returns if the rename map has to be checkpointed after an
+     * instruction, i.e. if it is a branch that can be mispredicted.
+     */
+    bool needsCheckpoint(const DynInstPtr &inst) const;
+
+    /** Checkpoints the rename map after an instruction was renamed. */
+    void takeCheckpoint(const DynInstPtr &inst, ThreadID tid);
+
     /** Calculates the number of free ROB entries for a specific thread. */
     int calcFreeROBEntries(ThreadID tid);
 
@@ -316,9 +328,19 @@ class Rename
     };
 
     /** A per-thread list of all destination register renames, used to either
-     * undo rename mappings or free old physical registers.
+     * undo rename mappings or free old physical registers. The youngest
+     * rename is at the front.
      */
-    std::list<RenameHistory> historyBuffer[MaxThreads];
+    std::deque<RenameHistory> historyBuffer[MaxThreads];
+
+    /** Snapshot of the rename map taken right after a branch renamed. */
+    struct RenameCheckpoint
+    {
+        /** The sequence number of the branch. */
+        InstSeqNum instSeqNum;
+        /** The rename map including the branch's own renames. */
+        UnifiedRenameMap map;
+    };
 
     /** Pointer to CPU. */
     CPU *cpu;
@@ -459,6 +481,16 @@ class Rename
     /** The maximum skid buffer size. */
     unsigned skidBufferMax;
 
+    /** Number of rename map checkpoints per thread, zero if squashes
+     * always walk the history buffer to undo the mappings.
+     */
+    const unsigned numCheckpoints;
+
+    /** Per-thread checkpoints of in-flight branches, oldest first. The
+     * storage is reused, so taking a checkpoint does not allocate.
+     */
+    std::vector<CircularQueue<RenameCheckpoint>> checkpoints;
+
     /** Enum to record the source of a structure full stall.  Can come from
      * either ROB, IQ, LSQ, and it is priortized in that order.
      */
@@ -526,6 +558,12 @@ class Rename
         /** Stat for total number of mappings that were undone due to a
          *  squash. */
         statistics::Scalar undoneMaps;
+        /** Stat for total number of squashes that restored the rename
+         *  map from a checkpoint. */
+        statistics::Scalar checkpointRestores;
+        /** Stat for total number of times rename stalled on a branch
+         *  because all checkpoints were in use. */
+        statistics::Scalar checkpointFullEvents;
         /** Number of serialize instructions handled. */
         statistics::Scalar serializing;
         /** Number of instructions marked as temporarily serializing. */
@@ -39,28 +39,56 @@ namespace gem5
 namespace o3
 {
 
-StoreSet::StoreSet(uint64_t clear_period, int _SSIT_size, int _LFST_size)
-    : clearPeriod(clear_period), SSITSize(_SSIT_size), LFSTSize(_LFST_size)
+StoreSet::StoreSet(uint64_t clear_period, int _SSIT_size, int _LFST_size,
+                   int _SSIT_assoc, unsigned tag_bits, unsigned conf_bits,
+                   StoreSetClearPolicy clear_policy)
 {
+    init(clear_period, _SSIT_size, _LFST_size, _SSIT_assoc, tag_bits,
+         conf_bits, clear_policy);
+}
+
+StoreSet::~StoreSet()
+{
+}
+
+void
+StoreSet::init(uint64_t clear_period, int _SSIT_size, int _LFST_size,
+               int _SSIT_assoc, unsigned tag_bits, unsigned conf_bits,
+               StoreSetClearPolicy clear_policy)
+{
+    SSITSize = _SSIT_size;
+    LFSTSize = _LFST_size;
+    SSITAssoc = _SSIT_assoc;
+    tagBits = tag_bits;
+    confBits = conf_bits;
+    clearPeriod = clear_period;
+    clearPolicy = clear_policy;
+
     DPRINTF(StoreSet, "StoreSet: Creating store set object.\n");
-    DPRINTF(StoreSet, "StoreSet: SSIT size: %i, LFST size: %i.\n",
-            SSITSize, LFSTSize);
+    DPRINTF(StoreSet, "StoreSet: SSIT size: %i, assoc: %i, tag bits: %i, "
+            "LFST size: %i.\n", SSITSize, SSITAssoc, tagBits, LFSTSize);
 
     if (!isPowerOf2(SSITSize)) {
         fatal("Invalid SSIT size!\n");
     }
 
-    SSIT.resize(SSITSize);
-
-    validSSIT.resize(SSITSize);
+    if (SSITAssoc < 1 || SSITSize % SSITAssoc != 0 ||
+        !isPowerOf2(SSITSize / SSITAssoc)) {
+        fatal("Invalid SSIT associativity!\n");
+    }
 
-    for (int i = 0; i < SSITSize; ++i)
-        validSSIT[i] = false;
+    fatal_if(SSITAssoc > 1 && tagBits == 0,
+             "A set-associative SSIT needs tag bits to tell ways apart.\n");
+    fatal_if(tagBits >= sizeof(Addr) * 8, "Invalid SSIT tag width!\n");
+    fatal_if(confBits < 1 || confBits > 8,
+             "Invalid SSIT confidence width!\n");
 
     if (!isPowerOf2(LFSTSize)) {
         fatal("Invalid LFST size!\n");
     }
 
+    SSIT.assign(SSITSize, SSITEntry(confBits));
+
     LFST.resize(LFSTSize);
 
     validLFST.resize(LFSTSize);
@@ -70,117 +98,131 @@ StoreSet::StoreSet(uint64_t clear_period, int _SSIT_size, int _LFST_size)
         LFST[i] = 0;
     }
 
-    indexMask = SSITSize - 1;
-
     offsetBits = 2;
 
-    memOpsPred = 0;
-}
-
-StoreSet::~StoreSet()
-{
-}
+    indexMask = SSITSize / SSITAssoc - 1;
 
-void
-StoreSet::init(uint64_t clear_period, int _SSIT_size, int _LFST_size)
-{
-    SSITSize = _SSIT_size;
-    LFSTSize = _LFST_size;
-    clearPeriod = clear_period;
+    tagShift = offsetBits + floorLog2(SSITSize / SSITAssoc);
 
-    DPRINTF(StoreSet, "StoreSet: Creating store set object.\n");
-    DPRINTF(StoreSet, "StoreSet: SSIT size: %i, LFST size: %i.\n",
-            SSITSize, LFSTSize);
+    tagMask = mask(tagBits);
 
-    SSIT.resize(SSITSize);
+    accessStamp = 0;
 
-    validSSIT.resize(SSITSize);
+    memOpsPred = 0;
+}
 
-    for (int i = 0; i < SSITSize; ++i)
-        validSSIT[i] = false;
+StoreSet::SSITEntry *
+StoreSet::findEntry(Addr PC)
+{
+    SSITEntry *set = &SSIT[calcIndex(PC) * SSITAssoc];
+    Addr tag = calcTag(PC);
 
-    LFST.resize(LFSTSize);
+    for (int way = 0; way < SSITAssoc; ++way) {
+        if (set[way].valid && set[way].tag == tag) {
+            set[way].lastUsed = ++accessStamp;
+            return &set[way];
+        }
+    }
 
-    validLFST.resize(LFSTSize);
+    return nullptr;
+}
 
-    for (int i = 0; i < LFSTSize; ++i) {
-        validLFST[i] = false;
-        LFST[i] = 0;
+StoreSet::SSITEntry *
+StoreSet::allocEntry(Addr PC, SSID ssid)
+{
+    SSITEntry *set = &SSIT[calcIndex(PC) * SSITAssoc];
+    SSITEntry *victim = &set[0];
+
+    for (int way = 0; way < SSITAssoc && victim->valid; ++way) {
+        SSITEntry *entry = &set[way];
+        if (!entry->valid || entry->conf < victim->conf ||
+            (entry->conf == victim->conf &&
+             entry->lastUsed < victim->lastUsed)) {
+            victim = entry;
+        }
     }
 
-    indexMask = SSITSize - 1;
-
-    offsetBits = 2;
+    victim->valid = true;
+    victim->tag = calcTag(PC);
+    victim->ssid = ssid;
+    victim->conf.reset();
+    victim->lastUsed = ++accessStamp;
 
-    memOpsPred = 0;
+    return victim;
 }
 
+void
+StoreSet::decay()
+{
+    for (auto &entry : SSIT) {
+        if (entry.valid && (--entry.conf) == 0) {
+            entry.valid = false;
+        }
+    }
+}
 
 void
 StoreSet::violation(Addr store_PC, Addr load_PC)
 {
-    int load_index = calcIndex(load_PC);
-    int store_index = calcIndex(store_PC);
-
-    assert(load_index < SSITSize && store_index < SSITSize);
+    SSITEntry *load_entry = findEntry(load_PC);
+    SSITEntry *store_entry = findEntry(store_PC);
 
-    bool valid_load_SSID = validSSIT[load_index];
-    bool valid_store_SSID = validSSIT[store_index];
-
-    if (!valid_load_SSID && !valid_store_SSID) {
+    if (!load_entry && !store_entry) {
         // Calculate a new SSID here.
         SSID new_set = calcSSID(load_PC);
 
-        validSSIT[load_index] = true;
-
-        SSIT[load_index] = new_set;
+        allocEntry(load_PC, new_set);
 
-        validSSIT[store_index] = true;
-
-        SSIT[store_index] = new_set;
+        // The load may have been evicted again if both PCs map to a
+        // single-way set.  That is no worse than the direct-mapped table.
+        allocEntry(store_PC, new_set);
 
         assert(new_set < LFSTSize);
 
         DPRINTF(StoreSet, "StoreSet: Neither load nor store had a valid "
                 "storeset, creating a new one: %i for load %#x, store %#x\n",
                 new_set, load_PC, store_PC);
-    } else if (valid_load_SSID && !valid_store_SSID) {
-        SSID load_SSID = SSIT[load_index];
+    } else if (load_entry && !store_entry) {
+        SSID load_SSID = load_entry->ssid;
 
-        validSSIT[store_index] = true;
+        ++load_entry->conf;
 
-        SSIT[store_index] = load_SSID;
+        allocEntry(store_PC, load_SSID);
 
         assert(load_SSID < LFSTSize);
 
         DPRINTF(StoreSet, "StoreSet: Load had a valid store set.  Adding "
                 "store to that set: %i for load %#x, store %#x\n",
                 load_SSID, load_PC, store_PC);
-    } else if (!valid_load_SSID && valid_store_SSID) {
-        SSID store_SSID = SSIT[store_index];
+    } else if (!load_entry && store_entry) {
+        SSID store_SSID = store_entry->ssid;
 
-        validSSIT[load_index] = true;
+        ++store_entry->conf;
 
-        SSIT[load_index] = store_SSID;
+        allocEntry(load_PC, store_SSID);
 
         DPRINTF(StoreSet, "StoreSet: Store had a valid store set: %i for "
                 "load %#x, store %#x\n",
                 store_SSID, load_PC, store_PC);
     } else {
-        SSID load_SSID = SSIT[load_index];
-        SSID store_SSID = SSIT[store_index];
+        SSID load_SSID = load_entry->ssid;
+        SSID store_SSID = store_entry->ssid;
 
         assert(load_SSID < LFSTSize && store_SSID < LFSTSize);
 
+        ++load_entry->conf;
+        if (store_entry != load_entry)
+            ++store_entry->conf;
+
         // The store set with the lower number wins
         if (store_SSID > load_SSID) {
-            SSIT[store_index] = load_SSID;
+            store_entry->ssid = load_SSID;
 
             DPRINTF(StoreSet, "StoreSet: Load had smaller store set: %i; "
                     "for load %#x, store %#x\n",
                     load_SSID, load_PC, store_PC);
         } else {
-            SSIT[load_index] = store_SSID;
+            load_entry->ssid = store_SSID;
 
             DPRINTF(StoreSet, "StoreSet: Store had smaller store set: %i; "
                     "for load %#x, store %#x\n",
@@ -194,10 +236,16 @@ StoreSet::checkClear()
 {
     memOpsPred++;
     if (memOpsPred > clearPeriod) {
-        DPRINTF(StoreSet, "Wiping predictor state beacuse %d ld/st executed\n",
-                clearPeriod);
         memOpsPred = 0;
-        clear();
+        if (clearPolicy == StoreSetClearPolicy::Decay) {
+            DPRINTF(StoreSet, "Decaying predictor state beacuse %d ld/st "
+                    "executed\n", clearPeriod);
+            decay();
+        } else {
+            DPRINTF(StoreSet, "Wiping predictor state beacuse %d ld/st "
+                    "executed\n", clearPeriod);
+            clear();
+        }
     }
 }
 
@@ -212,18 +260,17 @@ StoreSet::insertLoad(Addr load_PC, InstSeqNum load_seq_num)
 void
 StoreSet::insertStore(Addr store_PC, InstSeqNum store_seq_num, ThreadID tid)
 {
-    int index = calcIndex(store_PC);
-
     int store_SSID;
 
     checkClear();
-    assert(index < SSITSize);
 
-    if (!validSSIT[index]) {
+    SSITEntry *entry = findEntry(store_PC);
+
+    if (!entry) {
         // Do nothing if there's no valid entry.
         return;
     } else {
-        store_SSID = SSIT[index];
+        store_SSID = entry->ssid;
 
         assert(store_SSID < LFSTSize);
 
@@ -246,16 +293,16 @@ StoreSet::checkInst(Addr PC)
 
     int inst_SSID;
 
-    assert(index < SSITSize);
+    SSITEntry *entry = findEntry(PC);
 
-    if (!validSSIT[index]) {
+    if (!entry) {
         DPRINTF(StoreSet, "Inst %#x with index %i had no SSID\n",
                 PC, index);
 
         // Return 0 if there's no valid entry.
         return 0;
     } else {
-        inst_SSID = SSIT[index];
+        inst_SSID = entry->ssid;
 
         assert(inst_SSID < LFSTSize);
 
@@ -282,24 +329,20 @@ StoreSet::issued(Addr issued_PC, InstSeqNum issued_seq_num, bool is_store)
         return;
     }
 
-    int index = calcIndex(issued_PC);
-
     int store_SSID;
 
-    assert(index < SSITSize);
-
     SeqNumMapIt store_list_it = storeList.find(issued_seq_num);
 
-    if (store_list_it != storeList.end()) {
-        storeList.erase(store_list_it);
-    }
-
-    // Make sure the SSIT still has a valid entry for the issued store.
-    if (!validSSIT[index]) {
+    // Only stores that updated the LFST are on the store list.  Use the
+    // store set recorded at insertion, as the SSIT entry may have been
+    // replaced or decayed since.
+    if (store_list_it == storeList.end()) {
         return;
     }
 
-    store_SSID = SSIT[index];
+    store_SSID = store_list_it->second;
+
+    storeList.erase(store_list_it);
 
     assert(store_SSID < LFSTSize);
 
@@ -344,8 +387,8 @@ StoreSet::squash(InstSeqNum squashed_num, ThreadID tid)
 void
 StoreSet::clear()
 {
-    for (int i = 0; i < SSITSize; ++i) {
-        validSSIT[i] = false;
+    for (auto &entry : SSIT) {
+        entry.valid = false;
     }
 
     for (int i = 0; i < LFSTSize; ++i) {
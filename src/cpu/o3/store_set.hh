@@ -34,8 +34,11 @@
 #include <utility>
 #include <vector>
 
+#include "base/sat_counter.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
+#include "cpu/o3/mem_dep_pred.hh"
+#include "enums/StoreSetClearPolicy.hh"
 
 namespace gem5
 {
@@ -58,8 +61,15 @@ struct ltseqnum
  * Dependence Prediction using Store Sets" by Chrysos and Emer.  SSID
  * stands for Store Set ID, SSIT stands for Store Set ID Table, and
  * LFST is Last Fetched Store Table.
+ *
+ * The SSIT may be organised as a tagged, set-associative table, in which
+ * case PCs only hit on an entry whose tag matches, and each entry keeps a
+ * saturating confidence counter that is bumped on every violation it
+ * takes part in.  The confidence picks the victim on an SSIT miss and,
+ * with the Decay clear policy, lets frequently violating entries survive
+ * the periodic clear that otherwise wipes the whole predictor.
  */
-class StoreSet
+class StoreSet : public MemDepPredictor
 {
   public:
     typedef unsigned SSID;
@@ -69,18 +79,31 @@ class StoreSet
     StoreSet() { };
 
     /** Creates store set predictor with given table sizes. */
-    StoreSet(uint64_t clear_period, int SSIT_size, int LFST_size);
+    StoreSet(uint64_t clear_period, int SSIT_size, int LFST_size,
+             int SSIT_assoc = 1, unsigned tag_bits = 0,
+             unsigned conf_bits = 2,
+             StoreSetClearPolicy clear_policy = StoreSetClearPolicy::Wipe);
 
     /** Default destructor. */
     ~StoreSet();
 
     /** Initializes the store set predictor with the given table sizes. */
-    void init(uint64_t clear_period, int SSIT_size, int LFST_size);
+    void init(uint64_t clear_period, int SSIT_size, int LFST_size,
+              int SSIT_assoc = 1, unsigned tag_bits = 0,
+              unsigned conf_bits = 2,
+              StoreSetClearPolicy clear_policy = StoreSetClearPolicy::Wipe);
 
     /** Records a memory ordering violation between the younger load
      * and the older store. */
     void violation(Addr store_PC, Addr load_PC);
 
+    void
+    violation(Addr store_PC, InstSeqNum store_seq_num,
+              Addr load_PC, InstSeqNum load_seq_num) override
+    {
+        violation(store_PC, load_PC);
+    }
+
     /** Clears the store set predictor every so often so that all the
      * entries aren't used and stores are constantly predicted as
      * conflicting.
@@ -94,7 +117,8 @@ class StoreSet
 
     /** Inserts a store into the store set predictor.  Updates the
      * LFST if the store has a valid SSID. */
-    void insertStore(Addr store_PC, InstSeqNum store_seq_num, ThreadID tid);
+    void insertStore(Addr store_PC, InstSeqNum store_seq_num,
+                     ThreadID tid) override;
 
     /** Checks if the instruction with the given PC is dependent upon
      * any store.  @return Returns the sequence number of the store
@@ -102,32 +126,74 @@ class StoreSet
      */
     InstSeqNum checkInst(Addr PC);
 
+    void
+    checkInst(Addr PC, std::vector<InstSeqNum> &producers) override
+    {
+        InstSeqNum dep = checkInst(PC);
+        if (dep != 0)
+            producers.push_back(dep);
+    }
+
     /** Records this PC/sequence number as issued. */
-    void issued(Addr issued_PC, InstSeqNum issued_seq_num, bool is_store);
+    void issued(Addr issued_PC, InstSeqNum issued_seq_num,
+                bool is_store) override;
 
     /** Squashes for a specific thread until the given sequence number. */
-    void squash(InstSeqNum squashed_num, ThreadID tid);
+    void squash(InstSeqNum squashed_num, ThreadID tid) override;
 
     /** Resets all tables. */
-    void clear();
+    void clear() override;
 
     /** Debug function to dump the contents of the store list. */
-    void dump();
+    void dump() override;
 
   private:
-    /** Calculates the index into the SSIT based on the PC. */
+    /** An entry of the Store Set ID Table. */
+    struct SSITEntry
+    {
+        SSITEntry(unsigned conf_bits) : conf(conf_bits, 1) {}
+
+        /** Whether the entry holds a store set. */
+        bool valid = false;
+
+        /** Upper PC bits of the instruction owning the entry. */
+        Addr tag = 0;
+
+        /** The store set the instruction belongs to. */
+        SSID ssid = 0;
+
+        /** Number of violations seen by this entry, saturating. */
+        SatCounter8 conf;
+
+        /** Access stamp used to break confidence ties on replacement. */
+        uint64_t lastUsed = 0;
+    };
+
+    /** Calculates the SSIT set based on the PC. */
     inline int calcIndex(Addr PC)
     { return (PC >> offsetBits) & indexMask; }
 
+    /** Calculates the SSIT tag based on the PC. */
+    inline Addr calcTag(Addr PC)
+    { return (PC >> tagShift) & tagMask; }
+
     /** Calculates a Store Set ID based on the PC. */
     inline SSID calcSSID(Addr PC)
     { return ((PC ^ (PC >> 10)) % LFSTSize); }
 
-    /** The Store Set ID Table. */
-    std::vector<SSID> SSIT;
+    /** Returns the SSIT entry matching the PC, or nullptr on a miss. */
+    SSITEntry *findEntry(Addr PC);
 
-    /** Bit vector to tell if the SSIT has a valid entry. */
-    std::vector<bool> validSSIT;
+    /** Picks an SSIT entry for the PC, evicting the least confident way
+     * of its set, and assigns it to the given store set. */
+    SSITEntry *allocEntry(Addr PC, SSID ssid);
+
+    /** Ages every SSIT entry by one step, dropping the ones that have
+     * lost all confidence. */
+    void decay();
+
+    /** The Store Set ID Table, laid out set by set. */
+    std::vector<SSITEntry> SSIT;
 
     /** Last Fetched Store Table. */
     std::vector<InstSeqNum> LFST;
@@ -150,12 +216,31 @@ class StoreSet
     /** Store Set ID Table size, in entries. */
     int SSITSize;
 
+    /** Store Set ID Table associativity. */
+    int SSITAssoc;
+
+    /** Width of the SSIT tags; 0 leaves the table untagged. */
+    unsigned tagBits;
+
+    /** Width of the SSIT confidence counters. */
+    unsigned confBits;
+
+    /** What happens to the SSIT when the clear period expires. */
+    StoreSetClearPolicy clearPolicy;
+
     /** Last Fetched Store Table size, in entries. */
     int LFSTSize;
 
     /** Mask to obtain the index. */
     int indexMask;
 
+    /** Shift and mask to obtain the tag. */
+    int tagShift;
+    Addr tagMask;
+
+    /** Running stamp for SSIT accesses. */
+    uint64_t accessStamp;
+
     // HACK: Hardcoded for now.
     int offsetBits;
 
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/store_vector.hh"
+
+#include <algorithm>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/StoreVector.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+namespace
+{
+
+/** Odd multipliers for the independent index hashes. */
+const uint64_t hashMultipliers[] = {
+    0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL,
+    0x165667b19e3779f9ULL, 0xd6e8feb86659fd93ULL,
+};
+
+const unsigned maxHashes =
+    sizeof(hashMultipliers) / sizeof(hashMultipliers[0]);
+
+} // anonymous namespace
+
+StoreVector::StoreVector(uint64_t clear_period, unsigned table_size,
+                         unsigned vector_length, unsigned num_hashes)
+    : clearPeriod(clear_period), vectorLength(vector_length),
+      numHashes(num_hashes)
+{
+    DPRINTF(StoreVector, "StoreVector: table size: %i, vector length: %i, "
+            "hashes: %i.\n", table_size, vectorLength, numHashes);
+
+    fatal_if(!isPowerOf2(table_size) || table_size < 2,
+             "Invalid store vector table size!\n");
+    fatal_if(vectorLength < 1 || vectorLength > 64,
+             "Store vector length must be between 1 and 64!\n");
+    fatal_if(numHashes < 1 || numHashes > maxHashes,
+             "Store vector predictor supports 1 to %d hashes!\n", maxHashes);
+
+    table.assign(table_size, 0);
+    indexBits = floorLog2(table_size);
+}
+
+unsigned
+StoreVector::calcIndex(Addr PC, unsigned hash) const
+{
+    return ((PC >> 2) * hashMultipliers[hash]) >> (64 - indexBits);
+}
+
+void
+StoreVector::checkClear()
+{
+    if (++memOpsPred > clearPeriod) {
+        DPRINTF(StoreVector, "Wiping predictor state beacuse %d stores "
+                "executed\n", clearPeriod);
+        memOpsPred = 0;
+        clear();
+    }
+}
+
+void
+StoreVector::violation(Addr store_PC, InstSeqNum store_seq_num,
+                       Addr load_PC, InstSeqNum load_seq_num)
+{
+    // Count the stores fetched between the violating store and the load.
+    unsigned distance = 0;
+    auto it = recentStores.rbegin();
+    for (; it != recentStores.rend() && it->seqNum > store_seq_num; ++it) {
+        if (it->seqNum < load_seq_num)
+            ++distance;
+    }
+
+    if (it == recentStores.rend() || it->seqNum != store_seq_num ||
+        distance >= vectorLength) {
+        DPRINTF(StoreVector, "Store %#x [sn:%lli] is out of the window of "
+                "load %#x [sn:%lli]\n", store_PC, store_seq_num,
+                load_PC, load_seq_num);
+        return;
+    }
+
+    DPRINTF(StoreVector, "Load %#x depends on the store %i stores back, "
+            "store %#x\n", load_PC, distance, store_PC);
+
+    for (unsigned hash = 0; hash < numHashes; ++hash)
+        table[calcIndex(load_PC, hash)] |= 1ULL << distance;
+}
+
+void
+StoreVector::insertStore(Addr store_PC, InstSeqNum store_seq_num,
+                         ThreadID tid)
+{
+    checkClear();
+
+    recentStores.push_back({store_seq_num, false});
+    if (recentStores.size() > vectorLength)
+        recentStores.pop_front();
+}
+
+void
+StoreVector::checkInst(Addr PC, std::vector<InstSeqNum> &producers)
+{
+    uint64_t vector = mask(vectorLength);
+    for (unsigned hash = 0; hash < numHashes && vector; ++hash)
+        vector &= table[calcIndex(PC, hash)];
+
+    if (!vector)
+        return;
+
+    // Distance 0 is the youngest store, which is at the back of the window.
+    unsigned distance = 0;
+    for (auto it = recentStores.rbegin(); it != recentStores.rend();
+         ++it, ++distance) {
+        if (bits(vector, distance) && !it->issued) {
+            DPRINTF(StoreVector, "Inst %#x depends on [sn:%lli], %i stores "
+                    "back\n", PC, it->seqNum, distance);
+            producers.push_back(it->seqNum);
+        }
+    }
+}
+
+void
+StoreVector::issued(Addr issued_PC, InstSeqNum issued_seq_num, bool is_store)
+{
+    if (!is_store)
+        return;
+
+    for (auto it = recentStores.rbegin(); it != recentStores.rend(); ++it) {
+        if (it->seqNum == issued_seq_num) {
+            it->issued = true;
+            break;
+        }
+    }
+}
+
+void
+StoreVector::squash(InstSeqNum squashed_num, ThreadID tid)
+{
+    DPRINTF(StoreVector, "StoreVector: Squashing until inum %i\n",
+            squashed_num);
+
+    while (!recentStores.empty() &&
+           recentStores.back().seqNum > squashed_num) {
+        recentStores.pop_back();
+    }
+}
+
+void
+StoreVector::clear()
+{
+    std::fill(table.begin(), table.end(), 0);
+}
+
+void
+StoreVector::dump()
+{
+    cprintf("recentStores.size(): %i\n", recentStores.size());
+
+    int num = 0;
+    for (const auto &store : recentStores) {
+        cprintf("%i: [sn:%lli]%s\n", num++, store.seqNum,
+                store.issued ? " issued" : "");
+    }
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_STORE_VECTOR_HH__
+#define __CPU_O3_STORE_VECTOR_HH__
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/o3/mem_dep_pred.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Implements a store vector memory dependence predictor, after "Store
+ * Vectors for Scalable Memory Dependence Prediction and Scheduling" by
+ * Subramaniam and Loh.  Instead of naming store sets, each load keeps a
+ * bit vector over store distances: bit d set means the load has
+ * previously conflicted with the store fetched d stores before it.
+ *
+ * The vectors live in an untagged table indexed by several independent
+ * PC hashes, Bloom filter style.  Training sets the bit in every hashed
+ * entry and a lookup ANDs them together, so a load only inherits the
+ * dependences of an aliasing load if it collides with it on all hashes.
+ */
+class StoreVector : public MemDepPredictor
+{
+  public:
+    /** Creates a store vector predictor with the given geometry. */
+    StoreVector(uint64_t clear_period, unsigned table_size,
+                unsigned vector_length, unsigned num_hashes);
+
+    void violation(Addr store_PC, InstSeqNum store_seq_num,
+                   Addr load_PC, InstSeqNum load_seq_num) override;
+
+    void insertStore(Addr store_PC, InstSeqNum store_seq_num,
+                     ThreadID tid) override;
+
+    void checkInst(Addr PC, std::vector<InstSeqNum> &producers) override;
+
+    void issued(Addr issued_PC, InstSeqNum issued_seq_num,
+                bool is_store) override;
+
+    void squash(InstSeqNum squashed_num, ThreadID tid) override;
+
+    void clear() override;
+
+    void dump() override;
+
+  private:
+    /** A recently fetched store. */
+    struct StoreEntry
+    {
+        InstSeqNum seqNum;
+        bool issued;
+    };
+
+    /** Clears the vectors every so often so that loads do not end up
+     * waiting on every older store. */
+    void checkClear();
+
+    /** Calculates the table index of the PC under the given hash. */
+    unsigned calcIndex(Addr PC, unsigned hash) const;
+
+    /** The store vector table. */
+    std::vector<uint64_t> table;
+
+    /** The last vectorLength stores inserted, oldest first. */
+    std::deque<StoreEntry> recentStores;
+
+    /** Number of stores to process before wiping the table. */
+    uint64_t clearPeriod;
+
+    /** Number of stores inserted since the last clear. */
+    uint64_t memOpsPred = 0;
+
+    /** Store distances tracked per load, at most 64. */
+    unsigned vectorLength;
+
+    /** Number of hashes indexing the table. */
+    unsigned numHashes;
+
+    /** log2 of the table size. */
+    unsigned indexBits;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_STORE_VECTOR_HH__
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declares the running estimate of the mean of a sample, and of its
+ * confidence interval, that sampled simulation keeps of the IPC.
+ */
+
+#ifndef __CPU_SAMPLE_ESTIMATE_HH__
+#define __CPU_SAMPLE_ESTIMATE_HH__
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace gem5
+{
+
+/**
+ * Estimates the mean of a population from a sample of values added one
+ * by one, along with a confidence interval that takes the mean of the
+ * sample to be normally distributed, as it is for large samples.
+ */
+class SampleEstimate
+{
+  public:
+    /** Adds a value to the sample. */
+    void
+    add(double value)
+    {
+        // Welford's update keeps the variance accurate over many values
+        _count++;
+        const double delta = value - _mean;
+        _mean += delta / _count;
+        sumSquares += delta * (value - _mean);
+    }
+
+    /** @return The number of values in the sample. */
+    uint64_t count() const { return _count; }
+
+    /** @return The mean of the sample. */
+    double mean() const { return _mean; }
+
+    /** @return The standard deviation of the sample, 0 under 2 values. */
+    double
+    stdev() const
+    {
+        return _count > 1 ? std::sqrt(sumSquares / (_count - 1)) : 0;
+    }
+
+    /**
+     * @param z_score Standard errors spanned on either side of the mean
+     * @return The half width of the confidence interval of the mean,
+     *         infinite under 2 values.
+     */
+    double
+    confidence(double z_score) const
+    {
+        if (_count < 2)
+            return std::numeric_limits<double>::infinity();
+        return z_score * stdev() / std::sqrt(double(_count));
+    }
+
+  private:
+    /** Number of values. */
+    uint64_t _count = 0;
+    /** Running mean of the values. */
+    double _mean = 0;
+    /** Running sum of the squared deviations from the mean. */
+    double sumSquares = 0;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SAMPLE_ESTIMATE_HH__
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "cpu/sample_estimate.hh"
+
+using namespace gem5;
+
+/** No interval can be given before there are two values. */
+TEST(SampleEstimateTest, Empty)
+{
+    SampleEstimate estimate;
+    EXPECT_EQ(estimate.count(), 0);
+    EXPECT_EQ(estimate.mean(), 0);
+    EXPECT_EQ(estimate.stdev(), 0);
+    EXPECT_EQ(estimate.confidence(3.0),
+              std::numeric_limits<double>::infinity());
+
+    estimate.add(1.5);
+    EXPECT_EQ(estimate.count(), 1);
+    EXPECT_EQ(estimate.mean(), 1.5);
+    EXPECT_EQ(estimate.stdev(), 0);
+    EXPECT_EQ(estimate.confidence(3.0),
+              std::numeric_limits<double>::infinity());
+}
+
+/** The moments match the textbook formulas. */
+TEST(SampleEstimateTest, Moments)
+{
+    const std::vector<double> values = {2, 4, 4, 4, 5, 5, 7, 9};
+    SampleEstimate estimate;
+    for (double value : values)
+        estimate.add(value);
+
+    // Mean 5, sum of squared deviations 32, over n - 1 = 7
+    EXPECT_EQ(estimate.count(), 8);
+    EXPECT_DOUBLE_EQ(estimate.mean(), 5);
+    EXPECT_DOUBLE_EQ(estimate.stdev(), std::sqrt(32.0 / 7));
+    EXPECT_DOUBLE_EQ(estimate.confidence(1.0),
+                     std::sqrt(32.0 / 7) / std::sqrt(8.0));
+    EXPECT_DOUBLE_EQ(estimate.confidence(3.0),
+                     3 * estimate.confidence(1.0));
+}
+
+/** The variance stays accurate for values of a large mean and a small
+ * variance, where the sum of squares cancels out. */
+TEST(SampleEstimateTest, Stability)
+{
+    SampleEstimate estimate;
+    for (int i = 0; i < 1000000; i++)
+        estimate.add(1e9 + (i % 2 ? 1 : -1));
+
+    EXPECT_DOUBLE_EQ(estimate.mean(), 1e9);
+    EXPECT_NEAR(estimate.stdev(), 1, 1e-6);
+}
+
+/** The 3 sigma interval of the mean of normal values covers the mean of
+ * the population for about 99.7% of the samples. */
+TEST(SampleEstimateTest, Coverage)
+{
+    std::mt19937_64 rng(1);
+    std::normal_distribution<double> dist(2.0, 0.5);
+    const int samples = 2000;
+    int covered = 0;
+    for (int i = 0; i < samples; i++) {
+        SampleEstimate estimate;
+        for (int j = 0; j < 50; j++)
+            estimate.add(dist(rng));
+        if (std::abs(estimate.mean() - 2.0) <= estimate.confidence(3.0))
+            covered++;
+    }
+    EXPECT_GE(covered, samples * 99 / 100);
+}
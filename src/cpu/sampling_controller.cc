@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/sampling_controller.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "cpu/base.hh"
+#include "debug/Sampling.hh"
+#include "params/SamplingController.hh"
+
+namespace gem5
+{
+
+SamplingController::SamplingController(const SamplingControllerParams &p)
+  : SimObject(p), cpus(p.cpus), zScore(p.z_score), measuring(false),
+    startInsts(0), startCycle(0), stats(this)
+{
+    fatal_if(cpus.empty(), "The sampling controller needs a CPU to "
+        "measure.");
+    fatal_if(zScore <= 0, "The confidence interval must span a positive "
+        "number of standard errors.");
+}
+
+Counter
+SamplingController::committedInsts() const
+{
+    Counter insts = 0;
+    for (const auto cpu : cpus) {
+        insts += cpu->totalInsts();
+    }
+    return insts;
+}
+
+void
+SamplingController::startMeasurement()
+{
+    panic_if(measuring, "A measurement window is already open.");
+    measuring = true;
+    startInsts = committedInsts();
+    startCycle = cpus.front()->curCycle();
+}
+
+double
+SamplingController::endMeasurement()
+{
+    panic_if(!measuring, "No measurement window is open.");
+    measuring = false;
+
+    const Counter insts = committedInsts() - startInsts;
+    const Cycles cycles = cpus.front()->curCycle() - startCycle;
+    if (cycles == 0) {
+        warn("Dropping a measurement window that took no cycles.");
+        return 0;
+    }
+    const double window_ipc = double(insts) / cycles;
+    ipc.add(window_ipc);
+
+    DPRINTF(Sampling, "Window %d: %d insts in %d cycles, IPC %f; "
+            "estimate %f +/- %f\n", ipc.count(), insts, cycles, window_ipc,
+            ipc.mean(), ipcConfidence());
+
+    stats.samples = ipc.count();
+    stats.measuredInsts += insts;
+    stats.measuredCycles += cycles;
+    stats.ipcMean = ipc.mean();
+    stats.ipcStdev = ipc.stdev();
+    if (ipc.count() > 1) {
+        stats.ipcConfidence = ipcConfidence();
+    }
+
+    return window_ipc;
+}
+
+SamplingController::SamplingStats::SamplingStats(statistics::Group *parent)
+  : statistics::Group(parent),
+    ADD_STAT(samples, statistics::units::Count::get(),
+        "Number of measurement windows"),
+    ADD_STAT(measuredInsts, statistics::units::Count::get(),
+        "Number of instructions committed in the measurement windows"),
+    ADD_STAT(measuredCycles, statistics::units::Cycle::get(),
+        "Number of cycles elapsed in the measurement windows"),
+    ADD_STAT(ipcMean, statistics::units::Rate<
+            statistics::units::Count, statistics::units::Cycle>::get(),
+        "Estimated IPC, the mean IPC of the measurement windows"),
+    ADD_STAT(ipcStdev, statistics::units::Rate<
+            statistics::units::Count, statistics::units::Cycle>::get(),
+        "Standard deviation of the IPC of the measurement windows"),
+    ADD_STAT(ipcConfidence, statistics::units::Rate<
+            statistics::units::Count, statistics::units::Cycle>::get(),
+        "Half width of the confidence interval of the estimated IPC")
+{
+    ipcMean.precision(6);
+    ipcStdev.precision(6);
+    ipcConfidence.precision(6);
+}
+
+} // namespace gem5
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declares a controller for SMARTS-style sampled simulation: the IPC of
+ * short windows of detailed simulation, taken at regular intervals, is
+ * used to estimate the IPC of the whole run along with a confidence
+ * interval. In between windows, the workload is run on fast CPUs that
+ * functionally warm the caches and predictors. Switching between the CPUs
+ * is left to the Python driver (gem5.simulate.sampled_simulator), the
+ * controller only measures the windows and keeps the running estimate.
+ */
+
+#ifndef __CPU_SAMPLING_CONTROLLER_HH__
+#define __CPU_SAMPLING_CONTROLLER_HH__
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/sample_estimate.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class BaseCPU;
+struct SamplingControllerParams;
+
+class SamplingController : public SimObject
+{
+  public:
+    SamplingController(const SamplingControllerParams &p);
+
+    /** Starts a measurement window on the detailed CPUs. */
+    void startMeasurement();
+
+    /**
+     * Ends the current measurement window and adds its IPC to the sample.
+     * @return The IPC of the window.
+     */
+    double endMeasurement();
+
+    /** @return The number of windows measured so far. */
+    uint64_t numSamples() const { return ipc.count(); }
+
+    /** @return The mean IPC of the windows. */
+    double ipcMean() const { return ipc.mean(); }
+
+    /** @return The standard deviation of the IPC of the windows. */
+    double ipcStdev() const { return ipc.stdev(); }
+
+    /**
+     * @return The half width of the confidence interval of the mean IPC,
+     * infinite until at least two windows have been measured.
+     */
+    double ipcConfidence() const { return ipc.confidence(zScore); }
+
+  private:
+    /** @return The instructions committed by the detailed CPUs. */
+    Counter committedInsts() const;
+
+    /** The detailed CPUs, the first one provides the clock. */
+    const std::vector<BaseCPU *> cpus;
+
+    /** Standard errors spanned on either side of the mean. */
+    const double zScore;
+
+    /** Whether a window is being measured. */
+    bool measuring;
+
+    /** Instructions committed when the window started. */
+    Counter startInsts;
+
+    /** Cycle the window started at. */
+    Cycles startCycle;
+
+    /** Running estimate of the IPC, from the window IPCs. */
+    SampleEstimate ipc;
+
+    struct SamplingStats : public statistics::Group
+    {
+        SamplingStats(statistics::Group *parent);
+
+        /** Number of windows measured. */
+        statistics::Scalar samples;
+        /** Instructions committed in the windows. */
+        statistics::Scalar measuredInsts;
+        /** Cycles elapsed in the windows. */
+        statistics::Scalar measuredCycles;
+        /** Estimated IPC of the run. */
+        statistics::Scalar ipcMean;
+        /** Standard deviation of the window IPCs. */
+        statistics::Scalar ipcStdev;
+        /** Half width of the confidence interval of the estimate. */
+        statistics::Scalar ipcConfidence;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SAMPLING_CONTROLLER_HH__
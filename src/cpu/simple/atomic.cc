@@ -41,6 +41,9 @@
 
 #include "cpu/simple/atomic.hh"
 
+#include <algorithm>
+#include <cstring>
+
 #include "arch/generic/decoder.hh"
 #include "base/output.hh"
 #include "config/the_isa.hh"
@@ -82,13 +85,13 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
-      ppCommit(nullptr)
+      ppCommit(nullptr), ppLoadValue(nullptr)
 {
     _status = Idle;
-    ifetch_req = std::make_shared<Request>();
-    data_read_req = std::make_shared<Request>();
-    data_write_req = std::make_shared<Request>();
-    data_amo_req = std::make_shared<Request>();
+    ifetch_req = Request::create();
+    data_read_req = Request::create();
+    data_write_req = Request::create();
+    data_amo_req = Request::create();
 }
 
 
@@ -377,6 +380,7 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t *data, unsigned size,
 
     req->taskId(taskId());
 
+    const uint8_t *load_data = data;
     Addr frag_addr = addr;
     int frag_size = 0;
     int size_left = size;
@@ -424,6 +428,14 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t *data, unsigned size,
                 assert(!locked);
                 locked = true;
             }
+            if (ppLoadValue->hasListeners() && !req->isPrefetch()) {
+                uint64_t value = 0;
+                std::memcpy(&value, load_data,
+                            std::min<unsigned>(size, sizeof(value)));
+                ppLoadValue->notify({curThread,
+                                     thread->pcState().instAddr(), addr,
+                                     value, size, false});
+            }
             return fault;
         }
 
@@ -767,6 +779,7 @@ AtomicSimpleCPU::regProbePoints()
 
     ppCommit = new ProbePointArg<std::pair<SimpleThread*, const StaticInstPtr>>
                                 (getProbeManager(), "Commit");
+    ppLoadValue = new probing::LoadValue(getProbeManager(), "LoadValue");
 }
 
 void
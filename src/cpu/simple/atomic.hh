@@ -45,6 +45,7 @@
 #include "cpu/simple/exec_context.hh"
 #include "mem/request.hh"
 #include "params/BaseAtomicSimpleCPU.hh"
+#include "sim/probe/mem.hh"
 #include "sim/probe/probe.hh"
 
 namespace gem5
@@ -173,6 +174,9 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     /** Probe Points. */
     ProbePointArg<std::pair<SimpleThread *, const StaticInstPtr>> *ppCommit;
 
+    /** Values returned by loads, e.g., to warm a value predictor. */
+    probing::LoadValue *ppLoadValue;
+
   protected:
 
     /** Return a reference to the data port. */
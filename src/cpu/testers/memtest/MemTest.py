@@ -61,6 +61,8 @@ class MemTest(ClockedObject):
     percent_reads = Param.Percent(65, "Percentage reads")
     percent_functional = Param.Percent(50, "Percentage functional accesses")
     percent_uncacheable = Param.Percent(10, "Percentage uncacheable")
+    percent_clean = Param.Percent(0, "Percentage of the cacheable " \
+                                      "accesses that are cache cleans")
 
     # Determine how often to print progress messages and what timeout
     # to use for checking progress of both requests and responses
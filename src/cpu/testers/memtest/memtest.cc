@@ -94,6 +94,7 @@ MemTest::MemTest(const Params &p)
       percentReads(p.percent_reads),
       percentFunctional(p.percent_functional),
       percentUncacheable(p.percent_uncacheable),
+      percentClean(p.percent_clean),
       requestorId(p.system->getRequestorId(this)),
       blockSize(p.system->cacheLineSize()),
       blockAddrMask(blockSize - 1),
@@ -142,17 +143,22 @@ MemTest::completeRequest(PacketPtr pkt, bool functional)
     outstandingAddrs.erase(remove_addr);
 
     DPRINTF(MemTest, "Completing %s at address %x (blk %x) %s\n",
-            pkt->isWrite() ? "write" : "read",
+            pkt->isClean() ? "clean" : pkt->isWrite() ? "write" : "read",
             req->getPaddr(), blockAlign(req->getPaddr()),
             pkt->isError() ? "error" : "success");
 
-    const uint8_t *pkt_data = pkt->getConstPtr<uint8_t>();
-
     if (pkt->isError()) {
         if (!functional || !suppressFuncErrors)
             panic( "%s access failed at %#x\n",
-                pkt->isWrite() ? "Write" : "Read", req->getPaddr());
+                pkt->isClean() ? "Clean" : pkt->isWrite() ? "Write" : "Read",
+                req->getPaddr());
+    } else if (pkt->isClean()) {
+        // a clean carries no data, and leaves the reference data as it
+        // is, the next read checking nothing was lost on the way
+        assert(!pkt->hasData());
     } else {
+        const uint8_t *pkt_data = pkt->getConstPtr<uint8_t>();
+
         if (pkt->isRead()) {
             uint8_t ref_data = referenceData[req->getPaddr()];
             if (pkt_data[0] != ref_data) {
@@ -221,6 +227,7 @@ MemTest::tick()
     unsigned cmd = random_mt.random(0, 100);
     uint8_t data = random_mt.random<uint8_t>();
     bool uncacheable = random_mt.random(0, 100) < percentUncacheable;
+    bool clean = !uncacheable && random_mt.random(0, 100) < percentClean;
     unsigned base = random_mt.random(0, 1);
     Request::Flags flags;
     Addr paddr;
@@ -249,8 +256,17 @@ MemTest::tick()
     } while (outstandingAddrs.find(paddr) != outstandingAddrs.end());
 
     bool do_functional = (random_mt.random(0, 100) < percentFunctional) &&
-        !uncacheable;
-    RequestPtr req = std::make_shared<Request>(paddr, 1, flags, requestorId);
+        !uncacheable && !clean;
+
+    // cleans go all the way to the point of coherency, and invalidate
+    // the block on the way half of the time
+    if (clean) {
+        flags.set(Request::CLEAN | Request::DST_POC);
+        if (random_mt.random(0, 1))
+            flags.set(Request::INVALIDATE);
+    }
+
+    RequestPtr req = Request::create(paddr, 1, flags, requestorId);
     req->setContext(id);
 
     outstandingAddrs.insert(paddr);
@@ -260,9 +276,14 @@ MemTest::tick()
              "Tester %s has more than 100 outstanding requests\n", name());
 
     PacketPtr pkt = nullptr;
-    uint8_t *pkt_data = new uint8_t[1];
 
-    if (cmd < percentReads) {
+    if (clean) {
+        DPRINTF(MemTest, "Initiating %sclean at addr %x (blk %x)\n",
+                req->isCacheInvalidate() ? "invalidating " : "",
+                req->getPaddr(), blockAlign(req->getPaddr()));
+
+        pkt = new Packet(req, Packet::makeWriteCmd(req));
+    } else if (cmd < percentReads) {
         // start by ensuring there is a reference value if we have not
         // seen this address before
         [[maybe_unused]] uint8_t ref_data = 0;
@@ -279,13 +300,14 @@ MemTest::tick()
                 blockAlign(req->getPaddr()), ref_data);
 
         pkt = new Packet(req, MemCmd::ReadReq);
-        pkt->dataDynamic(pkt_data);
+        pkt->dataDynamic(new uint8_t[1]);
     } else {
         DPRINTF(MemTest, "Initiating %swrite at addr %x (blk %x) value %x\n",
                 do_functional ? "functional " : "", req->getPaddr(),
                 blockAlign(req->getPaddr()), data);
 
         pkt = new Packet(req, MemCmd::WriteReq);
+        uint8_t *pkt_data = new uint8_t[1];
         pkt->dataDynamic(pkt_data);
         pkt_data[0] = data;
     }
@@ -131,6 +131,7 @@ class MemTest : public ClockedObject
     const unsigned percentReads;
     const unsigned percentFunctional;
     const unsigned percentUncacheable;
+    const unsigned percentClean;
 
     /** Request id for all generated traffic */
     RequestorID requestorId;
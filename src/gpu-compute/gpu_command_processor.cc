@@ -172,7 +172,7 @@ GPUCommandProcessor::submitDispatchPkt(void *raw_pkt, uint32_t queue_id,
         for (int i = 0; i < sizeof(AMDKernelCode) / sizeof(uint8_t); ++i) {
             Addr mmhubAddr = phys_addr + i*sizeof(uint8_t);
             Request::Flags flags = Request::PHYSICAL;
-            RequestPtr request = std::make_shared<Request>(
+            RequestPtr request = Request::create(
                 mmhubAddr, sizeof(uint8_t), flags, walker->getDevRequestor());
             Packet *readPkt = new Packet(request, MemCmd::ReadReq);
             readPkt->allocate();
@@ -51,6 +51,12 @@ class AbstractMemory(ClockedObject):
                             "Address range (potentially interleaved)")
     null = Param.Bool(False, "Do not store data, always return zero")
 
+    # A memory that is one of the channels of a channel mapper has the
+    # whole range of the mapper, and holds the addresses of its channel
+    channel_mapper = Param.ChannelMapper(NULL,
+        "Mapper of the range across channels, if this is one of them")
+    channel = Param.Unsigned(0, "Channel of the mapper this memory is")
+
     # All memories are passed to the global physical memory, and
     # certain memories may be excluded from the global address map,
     # e.g. by the testers that use shadow memories as a reference
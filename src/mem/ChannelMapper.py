@@ -0,0 +1,59 @@
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.SimObject import SimObject
+
+# A channel mapper spreads an address range across any number of memory
+# channels, to which a crossbar then routes the addresses of the
+# range. The range is split into granules, and every period of the range
+# has its granules mapped to the channels by a pattern, the channels of
+# each period being permuted by a hash of the period index.
+#
+# With a granularity of a page, the position of a page in its period is
+# its color, and the pattern is a page coloring policy: a pattern of 12
+# colors over 6 channels, for instance, has every channel hold two
+# colors, which an OS can allocate pages from to place them by channel.
+class ChannelMapper(SimObject):
+    type = 'ChannelMapper'
+    cxx_header = "mem/channel_mapper.hh"
+    cxx_class = 'gem5::memory::ChannelMapper'
+
+    range = Param.AddrRange("Address range spread across the channels")
+    channels = Param.Unsigned("Number of channels")
+
+    granularity = Param.MemorySize('256B',
+        "Consecutive bytes mapped to the same channel, a power of two")
+
+    # the pattern must map as many granules to every channel
+    pattern = VectorParam.Unsigned([],
+        "Channel of each granule of a period, round robin if empty")
+
+    # the period index is the offset in the range divided by the bytes
+    # of a period, so the masks select address bits above the period
+    hash_masks = VectorParam.Addr([],
+        "Bits of the period index XOR-folded into each bit of the hash "
+        "that permutes the channels of a period")
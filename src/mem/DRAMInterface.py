@@ -67,6 +67,13 @@ class DRAMInterface(MemInterface):
     # performance being lower when enabled
     enable_dram_powerdown = Param.Bool(False, "Enable powerdown states")
 
+    # Without powerdown, an idle rank still wakes up for every refresh. If
+    # True, the refreshes of a rank that is idle are instead accounted for
+    # when it is next accessed or the stats are dumped, with the same
+    # timing, power state residency and energy, rather than simulated
+    refresh_elision = Param.Bool(False, "Fast-forward refreshes of idle "
+                                 "ranks")
+
     # For power modelling we need to know if the DRAM has a DLL or not
     dll = Param.Bool(True, "DRAM has DLL or not")
 
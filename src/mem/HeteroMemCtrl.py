@@ -54,3 +54,25 @@ class HeteroMemCtrl(MemCtrl):
     # The dram interface `dram` used by HeteroMemCtrl is defined in
     # the MemCtrl
     nvm = Param.NVMInterface("NVM memory interface to use")
+
+    # Tiering of the pages between the dram and the nvm, which counts the
+    # accesses to every page and periodically swaps the hottest pages of
+    # the nvm with cold pages of the dram, copying them in the background
+    page_migration = Param.Bool(False, "Migrate hot pages from the nvm "
+                                "to the dram")
+    migration_page_size = Param.MemorySize('4KiB', "Size of the pages "
+                                           "migrated between the tiers")
+    migration_interval = Param.Latency('10us', "Time between two "
+                                       "selections of pages to migrate")
+    migration_threshold = Param.Unsigned(8, "Accesses by which a page of "
+                                         "the nvm must be hotter than the "
+                                         "page of the dram it swaps with")
+    migration_max_pages = Param.Unsigned(16, "Pages migrated to the dram "
+                                         "at most per interval")
+    migration_bandwidth = Param.MemoryBandwidth('2GiB/s', "Bandwidth "
+                                                "at which the pages of a "
+                                                "swap are copied")
+    # the counters are halved every interval, so that they only track the
+    # pages accessed lately, and pages are not tracked once all are used
+    hot_page_counters = Param.Unsigned(65536, "Number of pages whose "
+                                       "accesses are counted at most")
@@ -42,6 +42,7 @@ from m5.proxy import *
 from m5.SimObject import SimObject
 
 from m5.objects.ClockedObject import ClockedObject
+from m5.objects.ReplacementPolicies import *
 
 class BaseXBar(ClockedObject):
     type = 'BaseXBar'
@@ -95,6 +96,13 @@ class BaseXBar(ClockedObject):
     use_default_range = Param.Bool(False, "Perform address mapping for " \
                                        "the default port")
 
+    # The ranges of the channel mappers are routed by the mappers,
+    # rather than by the address ranges of the ports. The memory side
+    # ports that advertise exactly the range of a mapper are its
+    # channels, in the order of the ports.
+    channel_mappers = VectorParam.ChannelMapper([],
+        "Channel mappers of the memory side ports")
+
 class NoncoherentXBar(BaseXBar):
     type = 'NoncoherentXBar'
     cxx_header = "mem/noncoherent_xbar.hh"
@@ -144,6 +152,15 @@ class SnoopFilter(SimObject):
     # Sanity check on max capacity to track, adjust if needed.
     max_capacity = Param.MemorySize('8MiB', "Maximum capacity of snoop filter")
 
+    # By default the snoop filter tracks any line held above it, up to
+    # its maximum capacity. With a non-zero associativity it models a
+    # finite, inclusive, directory of max_capacity worth of lines: a line
+    # is evicted when its set is full, and invalidated in the caches
+    # holding it.
+    assoc = Param.Unsigned(0, "Associativity, or 0 for an unbounded filter")
+    replacement_policy = Param.BaseReplacementPolicy(LRURP(),
+        "Replacement policy of a bounded snoop filter")
+
 # We use a coherent crossbar to connect multiple requestors to the L2
 # caches. Normally this crossbar would be part of the cache itself.
 class L2XBar(CoherentXBar):
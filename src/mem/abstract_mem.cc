@@ -57,7 +57,8 @@ namespace memory
 {
 
 AbstractMemory::AbstractMemory(const Params &p) :
-    ClockedObject(p), range(p.range), pmemAddr(NULL),
+    ClockedObject(p), range(p.range), channelMapper(p.channel_mapper),
+    channel(p.channel), pmemAddr(NULL),
     backdoor(params().range, nullptr,
              (MemBackdoor::Flags)(MemBackdoor::Readable |
                                   MemBackdoor::Writeable)),
@@ -68,6 +69,12 @@ AbstractMemory::AbstractMemory(const Params &p) :
     panic_if(!range.valid() || !range.size(),
              "Memory range %s must be valid with non-zero size.",
              range.to_string());
+    fatal_if(channelMapper && range != channelMapper->getAddrRange(),
+             "%s must have the range %s of its channel mapper.", name(),
+             channelMapper->getAddrRange().to_string());
+    fatal_if(channelMapper && channel >= channelMapper->numChannels(),
+             "%s is channel %d of the %d channels of its mapper.", name(),
+             channel, channelMapper->numChannels());
 }
 
 void
@@ -108,8 +115,8 @@ AbstractMemory::setBackingStore(uint8_t* pmem_addr)
     if (backdoor.ptr())
         backdoor.invalidate();
 
-    // The back door can't handle interleaved memory.
-    backdoor.ptr(range.interleaved() ? nullptr : pmem_addr);
+    // The back door can't handle interleaved memory, nor channels.
+    backdoor.ptr(range.interleaved() || channelMapper ? nullptr : pmem_addr);
 
     pmemAddr = pmem_addr;
 }
@@ -47,6 +47,7 @@
 #define __MEM_ABSTRACT_MEMORY_HH__
 
 #include "mem/backdoor.hh"
+#include "mem/channel_mapper.hh"
 #include "mem/port.hh"
 #include "params/AbstractMemory.hh"
 #include "sim/clocked_object.hh"
@@ -114,6 +115,12 @@ class AbstractMemory : public ClockedObject
     // Address range of this memory
     AddrRange range;
 
+    // Mapper of the range across channels, if this memory is one of them
+    const ChannelMapper *channelMapper;
+
+    // Channel of the mapper this memory is
+    const unsigned channel;
+
     // Pointer to host memory used to implement this memory
     uint8_t* pmemAddr;
 
@@ -294,11 +301,29 @@ class AbstractMemory : public ClockedObject
     }
 
     /**
-     * Get the memory size.
+     * Get the memory size, which for a channel is its share of the range.
      *
      * @return the size of the memory
      */
-    uint64_t size() const { return range.size(); }
+    uint64_t
+    size() const
+    {
+        return channelMapper ? channelMapper->channelSize() : range.size();
+    }
+
+    /**
+     * Get the channel mapper this memory is a channel of, if any.
+     *
+     * @return the channel mapper, or nullptr
+     */
+    const ChannelMapper *getChannelMapper() const { return channelMapper; }
+
+    /**
+     * Get the channel of the mapper this memory is.
+     *
+     * @return the channel
+     */
+    unsigned getChannel() const { return channel; }
 
     /**
      * Get the start address.
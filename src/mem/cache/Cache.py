@@ -38,7 +38,7 @@
 
 from m5.params import *
 from m5.proxy import *
-from m5.SimObject import SimObject
+from m5.SimObject import SimObject, PyBindMethod
 
 from m5.objects.ClockedObject import ClockedObject
 from m5.objects.Compressors import BaseCacheCompressor
@@ -76,6 +76,10 @@ class BaseCache(ClockedObject):
     cxx_header = "mem/cache/base.hh"
     cxx_class = 'gem5::BaseCache'
 
+    cxx_exports = [
+        PyBindMethod("setFunctionalWarming"),
+    ]
+
     size = Param.MemorySize("Capacity")
     assoc = Param.Unsigned("Associativity")
 
@@ -89,6 +93,14 @@ class BaseCache(ClockedObject):
     max_miss_count = Param.Counter(0,
         "Number of misses to handle before calling exit")
 
+    functional_warming = Param.Bool(False, "Whether atomic accesses start "
+        "out functionally warming the cache, servicing hits on a fast path "
+        "that only counts them as warming hits and trains the prefetcher")
+
+    compress_host_data = Param.Bool(False, "Whether to hold the data of "
+        "the blocks compressed in host memory, to simulate caches larger "
+        "than the host memory could otherwise hold")
+
     mshrs = Param.Unsigned("Number of MSHRs (max outstanding requests)")
     demand_mshr_reserve = Param.Unsigned(1, "MSHRs reserved for demand access")
     tgts_per_mshr = Param.Unsigned("Max number of accesses per MSHR")
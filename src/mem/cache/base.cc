@@ -108,6 +108,7 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       order(0),
       noTargetMSHR(nullptr),
       missCount(p.max_miss_count),
+      functionalWarming(p.functional_warming),
       addrRanges(p.addr_ranges.begin(), p.addr_ranges.end()),
       system(p.system),
       stats(*this)
@@ -245,7 +246,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
+            RequestPtr req2 = Request::create(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -665,7 +666,10 @@ BaseCache::recvAtomic(PacketPtr pkt)
         lat += handleAtomicReqMiss(pkt, blk, writebacks);
     }
 
-    // Note that we don't invoke the prefetcher at all in atomic mode.
+    // Note that we don't invoke the prefetcher at all in atomic mode,
+    // other than to train it while functionally warming (see
+    // warmAccess()), in which case the prefetches it generates are not
+    // issued until the cache goes back to timing mode.
     // It's not clear how to do it properly, particularly for
     // prefetchers that aggressively generate prefetch candidates and
     // rely on bandwidth contention to throttle them; these will tend
@@ -709,6 +713,62 @@ BaseCache::recvAtomic(PacketPtr pkt)
     return lat * clockPeriod();
 }
 
+bool
+BaseCache::warmAccess(PacketPtr pkt, CacheBlk *blk)
+{
+    // Cache maintenance, write cleans and uncacheable accesses are
+    // forwarded below, and writes to compressed blocks may expand them
+    if (pkt->req->isCacheMaintenance() || pkt->req->isUncacheable() ||
+        pkt->cmd == MemCmd::WriteClean || (compressor && pkt->isWrite())) {
+        return false;
+    }
+
+    if (pkt->isEviction()) {
+        // Misses allocate through the regular path. Atomic accesses
+        // leave no MSHR nor writeback behind, so a hit only updates the
+        // block, and a clean eviction that hits is simply dropped
+        if (!blk) {
+            return false;
+        }
+        if (pkt->isWriteback()) {
+            if (pkt->cmd == MemCmd::WritebackDirty) {
+                blk->setCoherenceBits(CacheBlk::DirtyBit);
+            }
+            if (!pkt->hasSharers()) {
+                blk->setCoherenceBits(CacheBlk::WritableBit);
+            }
+            updateBlockData(blk, pkt, true);
+        }
+    } else {
+        if (!blk || !blk->isSet(pkt->needsWritable() ?
+                                CacheBlk::WritableBit :
+                                CacheBlk::ReadableBit)) {
+            ppMiss->notify(pkt);
+            return false;
+        }
+
+        ppHit->notify(pkt);
+        if (blk->wasPrefetched()) {
+            blk->clearPrefetched();
+        }
+
+        satisfyRequest(pkt, blk);
+        maintainClusivity(pkt->fromCache(), blk);
+    }
+
+    DPRINTF(CacheVerbose, "%s: warming hit %s\n", __func__, pkt->print());
+    stats.warmHits++;
+    return true;
+}
+
+void
+BaseCache::setFunctionalWarming(bool warming)
+{
+    DPRINTF(Cache, "%s functional warming\n",
+            warming ? "Starting" : "Stopping");
+    functionalWarming = warming;
+}
+
 void
 BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
 {
@@ -729,7 +789,7 @@ BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
     // see if we have data at all (owned or otherwise)
     bool have_data = blk && blk->isValid()
         && pkt->trySatisfyFunctional(&cbpw, blk_addr, is_secure, blkSize,
-                                     blk->data);
+                                     blkData(blk));
 
     // data we have is dirty if marked as such or if we have an
     // in-service MSHR that is pending a modified line
@@ -772,20 +832,22 @@ BaseCache::updateBlockData(CacheBlk *blk, const PacketPtr cpkt,
     DataUpdate data_update(regenerateBlkAddr(blk), blk->isSecure());
     if (ppDataUpdate->hasListeners()) {
         if (has_old_data) {
-            data_update.oldData = std::vector<uint64_t>(blk->data,
-                blk->data + (blkSize / sizeof(uint64_t)));
+            const uint8_t *blk_data = blkData(blk);
+            data_update.oldData = std::vector<uint64_t>(blk_data,
+                blk_data + (blkSize / sizeof(uint64_t)));
         }
     }
 
     // Actually perform the data update
     if (cpkt) {
-        cpkt->writeDataToBlock(blk->data, blkSize);
+        cpkt->writeDataToBlock(blkData(blk), blkSize);
     }
 
     if (ppDataUpdate->hasListeners()) {
         if (cpkt) {
-            data_update.newData = std::vector<uint64_t>(blk->data,
-                blk->data + (blkSize / sizeof(uint64_t)));
+            const uint8_t *blk_data = blkData(blk);
+            data_update.newData = std::vector<uint64_t>(blk_data,
+                blk_data + (blkSize / sizeof(uint64_t)));
         }
         ppDataUpdate->notify(data_update);
     }
@@ -802,15 +864,16 @@ BaseCache::cmpAndSwap(CacheBlk *blk, PacketPtr pkt)
     uint32_t condition_val32;
 
     int offset = pkt->getOffset(blkSize);
-    uint8_t *blk_data = blk->data + offset;
+    uint8_t *data = blkData(blk);
+    uint8_t *blk_data = data + offset;
 
     assert(sizeof(uint64_t) >= pkt->getSize());
 
     // Get a copy of the old block's contents for the probe before the update
     DataUpdate data_update(regenerateBlkAddr(blk), blk->isSecure());
     if (ppDataUpdate->hasListeners()) {
-        data_update.oldData = std::vector<uint64_t>(blk->data,
-            blk->data + (blkSize / sizeof(uint64_t)));
+        data_update.oldData = std::vector<uint64_t>(data,
+            data + (blkSize / sizeof(uint64_t)));
     }
 
     overwrite_mem = true;
@@ -837,8 +900,8 @@ BaseCache::cmpAndSwap(CacheBlk *blk, PacketPtr pkt)
         blk->setCoherenceBits(CacheBlk::DirtyBit);
 
         if (ppDataUpdate->hasListeners()) {
-            data_update.newData = std::vector<uint64_t>(blk->data,
-                blk->data + (blkSize / sizeof(uint64_t)));
+            data_update.newData = std::vector<uint64_t>(data,
+                data + (blkSize / sizeof(uint64_t)));
             ppDataUpdate->notify(data_update);
         }
     }
@@ -1104,16 +1167,17 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
         if (pkt->isAtomicOp()) {
             // Get a copy of the old block's contents for the probe before
             // the update
+            uint8_t *data = blkData(blk);
             DataUpdate data_update(regenerateBlkAddr(blk), blk->isSecure());
             if (ppDataUpdate->hasListeners()) {
-                data_update.oldData = std::vector<uint64_t>(blk->data,
-                    blk->data + (blkSize / sizeof(uint64_t)));
+                data_update.oldData = std::vector<uint64_t>(data,
+                    data + (blkSize / sizeof(uint64_t)));
             }
 
             // extract data from cache and save it into the data field in
             // the packet as a return value from this atomic op
             int offset = tags->extractBlkOffset(pkt->getAddr());
-            uint8_t *blk_data = blk->data + offset;
+            uint8_t *blk_data = data + offset;
             pkt->setData(blk_data);
 
             // execute AMO operation
@@ -1121,8 +1185,8 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
 
             // Inform of this block's data contents update
             if (ppDataUpdate->hasListeners()) {
-                data_update.newData = std::vector<uint64_t>(blk->data,
-                    blk->data + (blkSize / sizeof(uint64_t)));
+                data_update.newData = std::vector<uint64_t>(data,
+                    data + (blkSize / sizeof(uint64_t)));
                 ppDataUpdate->notify(data_update);
             }
 
@@ -1154,7 +1218,7 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
 
         // all read responses have a data payload
         assert(pkt->hasRespData());
-        pkt->setDataFromBlock(blk->data, blkSize);
+        pkt->setDataFromBlock(blkData(blk), blkSize);
     } else if (pkt->isUpgrade()) {
         // sanity check
         assert(!pkt->hasSharers());
@@ -1242,6 +1306,11 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
     DPRINTF(Cache, "%s for %s %s\n", __func__, pkt->print(),
             blk ? "hit " + blk->print() : "miss");
 
+    if (functionalWarming && system->isAtomicMode() &&
+        warmAccess(pkt, blk)) {
+        return true;
+    }
+
     if (pkt->req->isCacheMaintenance()) {
         // A cache maintenance operation is always forwarded to the
         // memory below even if the block is found in dirty state.
@@ -1697,7 +1766,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1726,7 +1795,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
     blk->clearCoherenceBits(CacheBlk::DirtyBit);
 
     pkt->allocate();
-    pkt->setDataFromBlock(blk->data, blkSize);
+    pkt->setDataFromBlock(blkData(blk), blkSize);
 
     // When a block is compressed, it must first be decompressed before being
     // sent for writeback.
@@ -1740,7 +1809,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1771,7 +1840,7 @@ BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
     blk->clearCoherenceBits(CacheBlk::DirtyBit);
 
     pkt->allocate();
-    pkt->setDataFromBlock(blk->data, blkSize);
+    pkt->setDataFromBlock(blkData(blk), blkSize);
 
     // When a block is compressed, it must first be decompressed before being
     // sent for writeback.
@@ -1814,7 +1883,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
@@ -1823,7 +1892,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
         }
 
         Packet packet(request, MemCmd::WriteReq);
-        packet.dataStatic(blk.data);
+        packet.dataStatic(blkData(&blk));
 
         memSidePort.sendFunctional(&packet);
 
@@ -2271,6 +2340,8 @@ BaseCache::CacheStats::CacheStats(BaseCache &c)
              "number of data expansions"),
     ADD_STAT(dataContractions, statistics::units::Count::get(),
              "number of data contractions"),
+    ADD_STAT(warmHits, statistics::units::Count::get(),
+             "number of accesses serviced while functionally warming"),
     cmd(MemCmd::NUM_MEM_CMDS)
 {
     for (int idx = 0; idx < MemCmd::NUM_MEM_CMDS; ++idx)
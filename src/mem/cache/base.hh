@@ -595,6 +595,22 @@ class BaseCache : public ClockedObject
      */
     virtual Tick recvAtomic(PacketPtr pkt);
 
+    /**
+     * Services an access found in the tags while functionally warming
+     * the cache, reusing the lookup of the regular access path. The
+     * reads, writes and writebacks the regular atomic path would service
+     * from the block are serviced the same way, and update the
+     * replacement state and train the prefetcher, but are only accounted
+     * for as warming hits, without latencies. Any other access is left
+     * to the regular path, which keeps the coherence state, and thus any
+     * snoop filter below, consistent.
+     *
+     * @param pkt The request to perform.
+     * @param blk The block the request maps to, if any.
+     * @return Whether the access was serviced.
+     */
+    bool warmAccess(PacketPtr pkt, CacheBlk *blk);
+
     /**
      * Snoop for the provided request in the cache and return the estimated
      * time taken.
@@ -611,6 +627,20 @@ class BaseCache : public ClockedObject
      */
     virtual void functionalAccess(PacketPtr pkt, bool from_cpu_side);
 
+    /**
+     * Get the data of a block. The tags may hold it compressed, in which
+     * case the pointer must not be kept across accesses to the data of
+     * other blocks.
+     *
+     * @param blk The block, which may be the temporary block.
+     * @return Pointer to the data of the block.
+     */
+    uint8_t *
+    blkData(CacheBlk *blk) const
+    {
+        return blk == tempBlock ? blk->data : tags->getBlkData(blk);
+    }
+
     /**
      * Update the data contents of a block. When no packet is provided no
      * data will be written to the block, which means that this was likely
@@ -976,6 +1006,9 @@ class BaseCache : public ClockedObject
     /** The number of misses to trigger an exit event. */
     Counter missCount;
 
+    /** Whether atomic accesses functionally warm the cache. */
+    bool functionalWarming;
+
     /**
      * The address range to which the cache responds on the CPU side.
      * Normally this is all possible memory addresses. */
@@ -1142,6 +1175,9 @@ class BaseCache : public ClockedObject
          */
         statistics::Scalar dataContractions;
 
+        /** Number of accesses serviced while functionally warming. */
+        statistics::Scalar warmHits;
+
         /** Per-command statistics */
         std::vector<std::unique_ptr<CacheCmdStats>> cmd;
     } stats;
@@ -1276,6 +1312,18 @@ class BaseCache : public ClockedObject
         memSidePort.schedSendEvent(time);
     }
 
+    /**
+     * Turns functional warming of the cache on or off. While warming,
+     * atomic hits take a fast path that skips the statistics and
+     * latency calculations, and the prefetcher is trained on the atomic
+     * accesses.
+     *
+     * @param warming Whether the cache should be warming.
+     */
+    void setFunctionalWarming(bool warming);
+
+    bool isFunctionalWarming() const { return functionalWarming; }
+
     bool inCache(Addr addr, bool is_secure) const {
         return tags->findBlock(addr, is_secure);
     }
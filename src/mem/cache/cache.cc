@@ -378,7 +378,7 @@ Cache::handleTimingReqMiss(PacketPtr pkt, CacheBlk *blk, Tick forward_time,
 
         if (!mshr) {
             // copy the request and create a new SoftPFReq packet
-            RequestPtr req = std::make_shared<Request>(pkt->req->getPaddr(),
+            RequestPtr req = Request::create(pkt->req->getPaddr(),
                                                     pkt->req->getSize(),
                                                     pkt->req->getFlags(),
                                                     pkt->req->requestorId());
@@ -708,9 +708,12 @@ Cache::serviceMSHRTargets(MSHR *mshr, const PacketPtr pkt, CacheBlk *blk)
         // response in extractServiceableTargets. In either case, we
         // don't need to respond now, so pop it off to prevent the loop
         // below from generating another response.
-        assert(initial_tgt->pkt->cmd == MemCmd::LockedRMWReadReq);
+        // Popping the target shifts the others down over it, so keep
+        // its packet to delete
+        PacketPtr rmw_read_pkt = initial_tgt->pkt;
+        assert(rmw_read_pkt->cmd == MemCmd::LockedRMWReadReq);
         mshr->popTarget();
-        delete initial_tgt->pkt;
+        delete rmw_read_pkt;
         initial_tgt = nullptr;
     }
 
@@ -963,7 +966,7 @@ Cache::cleanEvictBlk(CacheBlk *blk)
     assert(blk && blk->isValid() && !blk->isSet(CacheBlk::DirtyBit));
 
     // Creating a zero sized write, a message to the snoop filter
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1213,13 +1216,14 @@ Cache::handleSnoop(PacketPtr pkt, CacheBlk *blk, bool is_timing,
                  "but keeping the block", name(), pkt->print());
 
         if (is_timing) {
-            doTimingSupplyResponse(pkt, blk->data, is_deferred, pending_inval);
+            doTimingSupplyResponse(pkt, blkData(blk), is_deferred,
+                                   pending_inval);
         } else {
             pkt->makeAtomicResponse();
             // packets such as upgrades do not actually have any data
             // payload
             if (pkt->hasData())
-                pkt->setDataFromBlock(blk->data, blkSize);
+                pkt->setDataFromBlock(blkData(blk), blkSize);
         }
 
         // When a block is compressed, it must first be decompressed before
@@ -1319,9 +1323,12 @@ Cache::recvTimingSnoopReq(PacketPtr pkt)
         // this cache, so the behaviour is modelled after handleSnoop,
         // the difference being that instead of querying the block
         // state to determine if it is dirty and writable, we use the
-        // command and fields of the writeback packet
-        bool respond = wb_pkt->cmd == MemCmd::WritebackDirty &&
-            pkt->needsResponse();
+        // command and fields of the writeback packet. As for a dirty
+        // block, cache maintenance snoops get no response, and the
+        // writeback is turned into a WriteClean the destination of the
+        // snoop waits for instead
+        bool dirty = wb_pkt->cmd == MemCmd::WritebackDirty;
+        bool respond = dirty && pkt->needsResponse() && !pkt->isClean();
         bool have_writable = !wb_pkt->hasSharers();
         bool invalidate = pkt->isInvalidate();
 
@@ -1342,7 +1349,40 @@ Cache::recvTimingSnoopReq(PacketPtr pkt)
                                    false, false);
         }
 
-        if (invalidate && wb_pkt->cmd != MemCmd::WriteClean) {
+        if (pkt->isClean() && dirty) {
+            // Replace the writeback with a WriteClean carrying the id
+            // of the snoop, as writecleanBlk does for a block
+            RequestPtr req = Request::create(wb_pkt->getBlockAddr(blkSize),
+                blkSize, 0, Request::wbRequestorId);
+            if (wb_pkt->isSecure()) {
+                req->setFlags(Request::SECURE);
+            }
+            req->taskId(wb_pkt->req->taskId());
+
+            PacketPtr wc_pkt = new Packet(req, MemCmd::WriteClean, blkSize,
+                                          pkt->id);
+            if (pkt->req->getDest()) {
+                req->setFlags(pkt->req->getDest());
+                wc_pkt->setWriteThrough();
+            }
+            if (wb_pkt->hasSharers()) {
+                wc_pkt->setHasSharers();
+            }
+            wc_pkt->allocate();
+            wc_pkt->setData(wb_pkt->getConstPtr<uint8_t>());
+
+            DPRINTF(Cache, "Replace %s with %s\n", wb_pkt->print(),
+                    wc_pkt->print());
+
+            markInService(wb_entry);
+            delete wb_pkt;
+
+            PacketList writebacks;
+            writebacks.push_back(wc_pkt);
+            doWritebacks(writebacks, clockEdge(forwardLatency) +
+                         pkt->headerDelay);
+            pkt->setSatisfied();
+        } else if (invalidate && wb_pkt->cmd != MemCmd::WriteClean) {
             // Invalidation trumps our writeback... discard here
             // Note: markInService will remove entry from writeback buffer.
             markInService(wb_entry);
@@ -213,6 +213,37 @@ class FrequentValuesCompressor(BaseCacheCompressor):
     decomp_chunks_per_cycle = 1
     decomp_extra_latency = 0
 
+class ValueLocalityCompressor(BaseCacheCompressor):
+    type = 'ValueLocalityCompressor'
+    cxx_class = 'gem5::compression::ValueLocality'
+    cxx_header = "mem/cache/compressors/value_locality.hh"
+
+    chunk_size_bits = 32
+    cores = VectorParam.SimObject([], "Cores whose constant loads (as " \
+        "found by their load value predictor) train the dictionary.")
+    dictionary_size = Param.Unsigned(64, "Number of dictionary entries, " \
+        "including the always present zero value.")
+    version_bits = Param.Unsigned(2, "Number of bits of the dictionary " \
+        "version tag stored with each compressed block.")
+    retrain_period = Param.Unsigned(4096, "Number of constant chunks " \
+        "observed between dictionary versions.")
+    counter_bits = Param.Unsigned(16, "Number of bits per frequency counter.")
+
+    candidate_assoc = Param.Int(16, "Associativity of the candidate table.")
+    candidate_entries = Param.MemorySize("1024",
+        "Number of entries of the candidate table.")
+    candidate_indexing_policy = Param.BaseIndexingPolicy(
+        SetAssociative(entry_size = 1, assoc = Parent.candidate_assoc,
+        size = Parent.candidate_entries),
+        "Indexing policy of the candidate table.")
+    candidate_replacement_policy = Param.BaseReplacementPolicy(LFURP(),
+        "Replacement policy of the candidate table.")
+
+    comp_chunks_per_cycle = 1
+    comp_extra_latency = 1
+    decomp_chunks_per_cycle = 1
+    decomp_extra_latency = 0
+
 class MultiCompressor(BaseCacheCompressor):
     type = 'MultiCompressor'
     cxx_class = 'gem5::compression::Multi'
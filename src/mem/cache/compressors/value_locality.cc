@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/compressors/value_locality.hh"
+
+#include <algorithm>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/CacheComp.hh"
+#include "mem/cache/prefetch/associative_set_impl.hh"
+#include "params/ValueLocalityCompressor.hh"
+
+namespace gem5
+{
+
+namespace compression
+{
+
+ValueLocality::ValueLocality(const Params &p)
+  : Base(p), cores(p.cores), dictionarySize(p.dictionary_size),
+    indexBits(ceilLog2(p.dictionary_size)), versionBits(p.version_bits),
+    retrainPeriod(p.retrain_period), observed(0),
+    candidates(p.candidate_assoc, p.candidate_entries,
+      p.candidate_indexing_policy, p.candidate_replacement_policy,
+      CandidateEntry(p.counter_bits)),
+    generation(0), liveBlocks(1ULL << p.version_bits, 0),
+    valueLocalityStats(this)
+{
+    fatal_if(dictionarySize < 2,
+        "The dictionary must have room for at least one trained value.");
+    fatal_if(versionBits < 1 || versionBits > 8,
+        "The dictionary version tag must have between 1 and 8 bits.");
+    fatal_if(retrainPeriod == 0, "The retrain period must be positive.");
+
+    // Until the first training period ends only zero chunks are encoded
+    auto dictionary = std::make_shared<Dictionary>();
+    dictionary->version = 0;
+    dictionary->values.push_back(0);
+    dictionary->indices[0] = 0;
+    current = std::move(dictionary);
+}
+
+std::unique_ptr<Base::CompressionData>
+ValueLocality::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    std::unique_ptr<CompData> comp_data =
+        std::unique_ptr<CompData>(new CompData(current));
+
+    // The version tag is stored with the block
+    std::size_t size = versionBits;
+
+    // Every chunk has a flag bit telling whether it is a dictionary index
+    for (const auto& chunk : chunks) {
+        const auto it = current->indices.find(chunk);
+        if (it != current->indices.end()) {
+            comp_data->compressedChunks.push_back({true, it->second});
+            size += 1 + indexBits;
+            valueLocalityStats.dictionaryHits++;
+        } else {
+            comp_data->compressedChunks.push_back({false, chunk});
+            size += 1 + chunkSizeBits;
+        }
+
+        DPRINTF(CacheComp, "Compressed %016x (%s, version %d)\n", chunk,
+            it != current->indices.end() ? "hit" : "miss",
+            current->version);
+    }
+
+    comp_data->setSizeBits(size);
+
+    // Set latencies based on the degree of parallelization, and any extra
+    // latencies due to shifting or packaging
+    comp_lat = Cycles(compExtraLatency +
+        (chunks.size() / compChunksPerCycle));
+    decomp_lat = Cycles(decompExtraLatency +
+        (chunks.size() / decompChunksPerCycle));
+
+    return comp_data;
+}
+
+void
+ValueLocality::decompress(const CompressionData* comp_data, uint64_t* data)
+{
+    const CompData* casted_comp_data = static_cast<const CompData*>(comp_data);
+    const Dictionary &dictionary = *casted_comp_data->dictionary;
+
+    // Indices are resolved with the version the block was encoded with,
+    // not with the current one
+    std::vector<Chunk> decomp_chunks;
+    for (const auto& comp_chunk : casted_comp_data->compressedChunks) {
+        if (comp_chunk.inDictionary) {
+            assert(comp_chunk.payload < dictionary.values.size());
+            decomp_chunks.push_back(dictionary.values[comp_chunk.payload]);
+        } else {
+            decomp_chunks.push_back(comp_chunk.payload);
+        }
+    }
+
+    fromChunks(decomp_chunks, data);
+}
+
+void
+ValueLocality::train(uint64_t value)
+{
+    CandidateEntry* entry = candidates.findEntry(value, false);
+    if (!entry) {
+        entry = candidates.findVictim(value);
+        assert(entry != nullptr);
+        entry->value = value;
+        candidates.insertEntry(value, false, entry);
+    } else {
+        candidates.accessEntry(entry);
+    }
+    entry->counter++;
+    valueLocalityStats.constantChunks++;
+
+    if (++observed >= retrainPeriod) {
+        observed = 0;
+        buildDictionary();
+    }
+}
+
+void
+ValueLocality::buildDictionary()
+{
+    std::vector<const CandidateEntry*> ranked;
+    for (const auto& entry : candidates) {
+        if (entry.isValid() && entry.value != 0) {
+            ranked.push_back(&entry);
+        }
+    }
+
+    const std::size_t num_values =
+        std::min<std::size_t>(ranked.size(), dictionarySize - 1);
+    std::partial_sort(ranked.begin(), ranked.begin() + num_values,
+        ranked.end(), [](const CandidateEntry* a, const CandidateEntry* b)
+        { return a->counter > b->counter; });
+
+    auto dictionary = std::make_shared<Dictionary>();
+    dictionary->version = (generation + 1) % liveBlocks.size();
+    dictionary->values.push_back(0);
+    dictionary->indices[0] = 0;
+    for (std::size_t i = 0; i < num_values; i++) {
+        dictionary->indices[ranked[i]->value] = dictionary->values.size();
+        dictionary->values.push_back(ranked[i]->value);
+    }
+
+    // The blocks still tagged with the reused version can no longer be
+    // told apart from new ones, so they are moved to the previous version,
+    // which versionOf() accounts for. They are not re-encoded: they keep
+    // their dictionary and compressed size
+    const unsigned version = dictionary->version;
+    valueLocalityStats.retaggedBlocks += liveBlocks[version];
+    liveBlocks[current->version] += liveBlocks[version];
+    liveBlocks[version] = 0;
+    generation++;
+
+    DPRINTF(CacheComp, "Built dictionary version %d with %d values\n",
+        version, dictionary->values.size());
+    current = std::move(dictionary);
+    valueLocalityStats.dictionaryVersions++;
+
+    // Age the counters so that the dictionary follows phase changes
+    for (auto& entry : candidates) {
+        entry.counter >>= 1;
+    }
+}
+
+unsigned
+ValueLocality::versionOf(uint64_t block_generation) const
+{
+    // A block is retagged with the previous version whenever its tag is
+    // reused, moving it num_tags - 1 generations forward each time, until
+    // it is within the generations the tags tell apart
+    const uint64_t num_tags = liveBlocks.size();
+    const uint64_t oldest = generation >= num_tags - 1 ?
+        generation - (num_tags - 1) : 0;
+    if (block_generation < oldest) {
+        block_generation += divCeil(oldest - block_generation, num_tags - 1) *
+            (num_tags - 1);
+    }
+    return block_generation % num_tags;
+}
+
+void
+ValueLocality::constantLoadNotify(const probing::ConstantLoadInfo &info)
+{
+    // Only the loaded bytes are meaningful
+    const unsigned size_bits = std::min(info.size * 8, 64u);
+    uint64_t value = info.value & mask(size_bits);
+
+    // Zero is always in the dictionary, so it needs no training
+    const unsigned chunk_bits = std::min<unsigned>(chunkSizeBits, 64);
+    for (unsigned offset = 0; offset < size_bits; offset += chunk_bits) {
+        const uint64_t chunk = value & mask(chunk_bits);
+        if (chunk != 0) {
+            train(chunk);
+        }
+        value = chunk_bits < 64 ? value >> chunk_bits : 0;
+    }
+}
+
+void
+ValueLocality::dataUpdateNotify(const DataUpdate &data_update)
+{
+    const Addr key = data_update.addr | data_update.isSecure;
+
+    if (data_update.oldData.size() > 0) {
+        auto it = blockGenerations.find(key);
+        if (it != blockGenerations.end()) {
+            const unsigned version = versionOf(it->second);
+            assert(liveBlocks[version] > 0);
+            liveBlocks[version]--;
+            blockGenerations.erase(it);
+        }
+    }
+
+    if (data_update.newData.size() > 0) {
+        blockGenerations[key] = generation;
+        liveBlocks[current->version]++;
+    }
+}
+
+void
+ValueLocality::regProbeListeners()
+{
+    assert(listeners.empty());
+    assert(cache != nullptr);
+    listeners.emplace_back(new DataUpdateListener(
+        *this, cache->getProbeManager(), "Data Update"));
+    for (auto core : cores) {
+        listeners.emplace_back(new ConstantLoadListener(
+            *this, core->getProbeManager(), "ConstantLoad"));
+    }
+}
+
+void
+ValueLocality::ConstantLoadListener::notify(
+    const probing::ConstantLoadInfo &info)
+{
+    parent.constantLoadNotify(info);
+}
+
+void
+ValueLocality::DataUpdateListener::notify(const DataUpdate &data_update)
+{
+    parent.dataUpdateNotify(data_update);
+}
+
+ValueLocality::ValueLocalityStats::ValueLocalityStats(
+    statistics::Group *parent)
+  : statistics::Group(parent, "valueLocality"),
+    ADD_STAT(constantChunks, statistics::units::Count::get(),
+        "Number of constant load chunks used for training"),
+    ADD_STAT(dictionaryVersions, statistics::units::Count::get(),
+        "Number of dictionary versions built"),
+    ADD_STAT(retaggedBlocks, statistics::units::Count::get(),
+        "Number of blocks retagged because their version tag was reused"),
+    ADD_STAT(dictionaryHits, statistics::units::Count::get(),
+        "Number of chunks replaced by a dictionary index")
+{
+}
+
+} // namespace compression
+} // namespace gem5
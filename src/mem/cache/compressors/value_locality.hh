@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_COMPRESSORS_VALUE_LOCALITY_HH__
+#define __MEM_CACHE_COMPRESSORS_VALUE_LOCALITY_HH__
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "base/sat_counter.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/base.hh"
+#include "mem/cache/compressors/base.hh"
+#include "mem/cache/prefetch/associative_set.hh"
+#include "sim/probe/mem.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5
+{
+
+struct ValueLocalityCompressorParams;
+
+namespace compression
+{
+
+/**
+ * A dictionary compressor whose dictionary is trained by the cores rather
+ * than by sampling the cache: every load value a core's LVP unit finds to
+ * be constant is counted, and every retrain period the most frequent
+ * values become a new version of the dictionary. A chunk that is in the
+ * dictionary is replaced by its index, any other chunk is kept verbatim.
+ *
+ * Each compressed block is tagged with the version of the dictionary it
+ * was encoded with, so the dictionary can change under resident blocks.
+ * Only 2^version_bits versions can be told apart; when a tag is reused,
+ * the blocks still under it are retagged as encoded with the version
+ * before the new one. This is an approximation: the blocks keep the
+ * dictionary, and thus the compressed size, they were encoded with, while
+ * hardware would have to re-encode them, or evict them.
+ */
+class ValueLocality : public Base
+{
+  private:
+    class CompData;
+
+    using DataUpdate = BaseCache::DataUpdate;
+
+    class ConstantLoadListener
+        : public ProbeListenerArgBase<probing::ConstantLoadInfo>
+    {
+      protected:
+        ValueLocality &parent;
+
+      public:
+        ConstantLoadListener(ValueLocality &_parent, ProbeManager *pm,
+            const std::string &name)
+          : ProbeListenerArgBase(pm, name), parent(_parent)
+        {
+        }
+        void notify(const probing::ConstantLoadInfo &info) override;
+    };
+
+    class DataUpdateListener : public ProbeListenerArgBase<DataUpdate>
+    {
+      protected:
+        ValueLocality &parent;
+
+      public:
+        DataUpdateListener(ValueLocality &_parent, ProbeManager *pm,
+            const std::string &name)
+          : ProbeListenerArgBase(pm, name), parent(_parent)
+        {
+        }
+        void notify(const DataUpdate &data_update) override;
+    };
+
+    std::vector<std::unique_ptr<ProbeListener>> listeners;
+
+    /** An immutable version of the dictionary. */
+    struct Dictionary
+    {
+        /** The tag compressed blocks refer to this version by. */
+        unsigned version;
+
+        /** The values, by index. Index 0 always holds zero. */
+        std::vector<uint64_t> values;
+
+        /** Reverse map, from value to index. */
+        std::unordered_map<uint64_t, unsigned> indices;
+    };
+
+    /** A value being counted as a dictionary candidate. */
+    class CandidateEntry : public TaggedEntry
+    {
+      public:
+        uint64_t value;
+
+        /** Number of times the value was loaded as a constant. */
+        SatCounter32 counter;
+
+        CandidateEntry(std::size_t num_bits)
+          : TaggedEntry(), value(0), counter(num_bits)
+        {
+        }
+
+        void
+        invalidate() override
+        {
+            TaggedEntry::invalidate();
+            value = 0;
+            counter.reset();
+        }
+    };
+
+    /** The cores whose constant loads train the dictionary. */
+    const std::vector<SimObject *> cores;
+
+    /** Maximum number of dictionary entries. */
+    const unsigned dictionarySize;
+
+    /** Number of bits of a dictionary index. */
+    const unsigned indexBits;
+
+    /** Number of bits of a dictionary version tag. */
+    const unsigned versionBits;
+
+    /** Number of constant chunks observed between dictionary versions. */
+    const unsigned retrainPeriod;
+
+    /** Constant chunks observed since the last dictionary version. */
+    unsigned observed;
+
+    /** The candidate values and their frequencies. */
+    AssociativeSet<CandidateEntry> candidates;
+
+    /** The dictionary new blocks are compressed with. */
+    std::shared_ptr<const Dictionary> current;
+
+    /**
+     * Number of dictionary versions built, the version tag of the current
+     * one being this modulo the number of tags.
+     */
+    uint64_t generation;
+
+    /** Number of resident blocks encoded under each version tag. */
+    std::vector<uint64_t> liveBlocks;
+
+    /**
+     * Generation of the dictionary every resident block was encoded with
+     * when it was inserted, by address and secure bit. The retaggings
+     * since are not recorded, but follow from it.
+     */
+    std::unordered_map<Addr, uint64_t> blockGenerations;
+
+    struct ValueLocalityStats : public statistics::Group
+    {
+        ValueLocalityStats(statistics::Group *parent);
+
+        /** Number of constant load chunks used for training. */
+        statistics::Scalar constantChunks;
+
+        /** Number of dictionary versions built. */
+        statistics::Scalar dictionaryVersions;
+
+        /**
+         * Number of blocks retagged because their tag was reused, which
+         * hardware would have to re-encode.
+         */
+        statistics::Scalar retaggedBlocks;
+
+        /** Number of chunks found in the dictionary. */
+        statistics::Scalar dictionaryHits;
+    } valueLocalityStats;
+
+    /** Counts a constant chunk, building a new dictionary when due. */
+    void train(uint64_t value);
+
+    /** Builds the next dictionary version from the candidates. */
+    void buildDictionary();
+
+    /**
+     * @param block_generation The generation a block was inserted with
+     * @return The version tag the block is currently encoded under.
+     */
+    unsigned versionOf(uint64_t block_generation) const;
+
+    std::unique_ptr<Base::CompressionData> compress(
+        const std::vector<Chunk>& chunks, Cycles& comp_lat,
+        Cycles& decomp_lat) override;
+
+    void decompress(const CompressionData* comp_data, uint64_t* data) override;
+
+  public:
+    typedef ValueLocalityCompressorParams Params;
+    ValueLocality(const Params &p);
+    ~ValueLocality() = default;
+
+    /**
+     * Process a constant load reported by a core.
+     *
+     * @param info The load.
+     */
+    void constantLoadNotify(const probing::ConstantLoadInfo &info);
+
+    /**
+     * Process a cache block contents update, to keep track of the version
+     * tags in use.
+     *
+     * @param data_update The data regarding the entry's contents update.
+     */
+    void dataUpdateNotify(const DataUpdate &data_update);
+
+    void regProbeListeners() override;
+};
+
+class ValueLocality::CompData : public CompressionData
+{
+  public:
+    CompData(std::shared_ptr<const Dictionary> dict)
+      : dictionary(std::move(dict))
+    {
+    }
+
+    /** The dictionary version the data was encoded with. */
+    const std::shared_ptr<const Dictionary> dictionary;
+
+    /**
+     * The compressed chunks: a dictionary index if inDictionary is set,
+     * and the original chunk otherwise.
+     */
+    struct CompressedChunk
+    {
+        bool inDictionary;
+        uint64_t payload;
+    };
+    std::vector<CompressedChunk> compressedChunks;
+};
+
+} // namespace compression
+} // namespace gem5
+
+#endif //__MEM_CACHE_COMPRESSORS_VALUE_LOCALITY_HH__
@@ -231,6 +231,17 @@ MSHR::TargetList::replaceUpgrades()
 }
 
 
+void
+MSHR::TargetList::splice(TargetList &other, iterator first, iterator last)
+{
+    assert(&other != this);
+    reserve(size() + (last - first));
+    for (auto it = first; it != last; it++) {
+        push_back(std::move(*it));
+    }
+    other.erase(first, last);
+}
+
 void
 MSHR::TargetList::clearDownstreamPending(MSHR::TargetList::iterator begin,
                                          MSHR::TargetList::iterator end)
@@ -495,7 +506,7 @@ MSHR::handleSnoop(PacketPtr pkt, Counter _order)
         // the packet and the request as part of handling the deferred
         // snoop.
         PacketPtr cp_pkt = will_respond ? new Packet(pkt, true, true) :
-            new Packet(std::make_shared<Request>(*pkt->req), pkt->cmd,
+            new Packet(Request::create(*pkt->req), pkt->cmd,
                        blkSize, pkt->id);
 
         if (will_respond) {
@@ -575,7 +586,7 @@ MSHR::extractServiceableTargets(PacketPtr pkt)
         ready_targets.populateFlags();
     } else {
         auto it = targets.begin();
-        while (it != targets.end()) {
+        for (; it != targets.end(); it++) {
             ready_targets.push_back(*it);
             if (it->pkt->cmd == MemCmd::LockedRMWReadReq) {
                 // Leave the Locked RMW Read until the corresponding Locked
@@ -583,8 +594,8 @@ MSHR::extractServiceableTargets(PacketPtr pkt)
                 // line is now "locked".
                 break;
             }
-            it = targets.erase(it);
         }
+        targets.erase(targets.begin(), it);
         ready_targets.populateFlags();
     }
     targets.populateFlags();
@@ -613,14 +624,13 @@ MSHR::promoteDeferredTargets()
         // then we can promote provided the targets list is empty and
         // we can service it on its own
         if (targets.empty()) {
-            targets.splice(targets.end(), deferredTargets, it);
+            targets.splice(deferredTargets, it, it + 1);
         }
     } else {
         // if a cache maintenance operation exists, we promote all the
         // deferred targets that precede it, or all deferred targets
         // otherwise
-        targets.splice(targets.end(), deferredTargets,
-                       deferredTargets.begin(), it);
+        targets.splice(deferredTargets, deferredTargets.begin(), it);
     }
 
     deferredTargets.populateFlags();
@@ -647,8 +657,7 @@ MSHR::promoteIf(const std::function<bool (Target &)>& pred)
     // the downstreamPending flag and move them to the target list
     deferredTargets.clearDownstreamPending(deferredTargets.begin(),
                                            last_it);
-    targets.splice(targets.end(), deferredTargets,
-                   deferredTargets.begin(), last_it);
+    targets.splice(deferredTargets, deferredTargets.begin(), last_it);
     // We need to update the flags for the target lists after the
     // modifications
     deferredTargets.populateFlags();
@@ -785,7 +794,7 @@ void
 MSHR::updateLockedRMWReadTarget(PacketPtr pkt)
 {
     assert(!targets.empty() && targets.front().pkt == pkt);
-    RequestPtr r = std::make_shared<Request>(*(pkt->req));
+    RequestPtr r = Request::create(*(pkt->req));
     targets.front().pkt = new Packet(r, MemCmd::LockedRMWReadReq);
 }
 
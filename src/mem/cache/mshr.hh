@@ -52,6 +52,7 @@
 #include <string>
 #include <vector>
 
+#include "base/inline_vector.hh"
 #include "base/printable.hh"
 #include "base/trace.hh"
 #include "base/types.hh"
@@ -166,7 +167,12 @@ class MSHR : public QueueEntry, public Printable
         {}
     };
 
-    class TargetList : public std::list<Target>, public Named
+    /**
+     * The targets of an MSHR. Most MSHRs only see a handful of targets,
+     * so these are held inline, and only spill to a pooled buffer for
+     * heavily coalesced blocks.
+     */
+    class TargetList : public InlineVector<Target, 4>, public Named
     {
 
       public:
@@ -266,6 +272,12 @@ class MSHR : public QueueEntry, public Printable
          * Used to rejig ordering between targets waiting on an MSHR. */
         void replaceUpgrades();
 
+        /**
+         * Move the targets in [first, last) of another list to the end
+         * of this one, keeping their order.
+         */
+        void splice(TargetList &other, iterator first, iterator last);
+
         void clearDownstreamPending();
         void clearDownstreamPending(iterator begin, iterator end);
         bool trySatisfyFunctional(PacketPtr pkt);
@@ -483,7 +495,7 @@ class MSHR : public QueueEntry, public Printable
     {
         DPRINTF(MSHR, "Force deallocating MSHR targets: %s\n",
                 targets.front().pkt->print());
-        targets.pop_front();
+        targets.erase(targets.begin());
     }
 
     bool promoteDeferredTargets();
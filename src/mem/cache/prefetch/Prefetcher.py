@@ -531,3 +531,49 @@ class PIFPrefetcher(QueuedPrefetcher):
         if not isinstance(simObj, SimObject):
             raise TypeError("argument must be of SimObject type")
         self.addEvent(HWPProbeEventRetiredInsts(self, simObj,"RetiredInstsPC"))
+
+class HWPProbeEventLoadValues(HWPProbeEvent):
+    def register(self):
+        if self.obj:
+            for name in self.names:
+                self.prefetcher.getCCObject().addEventProbeLoadValues(
+                    self.obj.getCCObject(), name)
+
+class PointerChasePrefetcher(QueuedPrefetcher):
+    type = 'PointerChasePrefetcher'
+    cxx_class = 'gem5::prefetch::PointerChase'
+    cxx_header = "mem/cache/prefetch/pointer_chase.hh"
+    cxx_exports = [
+        PyBindMethod("addEventProbeLoadValues"),
+    ]
+
+    # Pointers are virtual addresses; register the TLB with registerTLB()
+    # to follow pointers out of the page of the triggering access
+    use_virtual_addresses = True
+    on_inst = False
+
+    region_bits = Param.Unsigned(32, "Number of low bits a pointer may "
+        "differ in from the address of the load that produced it")
+    degree = Param.Unsigned(2,
+        "Number of prefetches to generate along a strided pointer chain")
+    confidence_counter_bits = Param.Unsigned(2,
+        "Number of bits of the stride confidence counter")
+    confidence_threshold = Param.Unsigned(2,
+        "Stride confidence needed to prefetch along a pointer chain")
+    max_pending_targets = Param.Unsigned(16,
+        "Maximum number of pointer targets waiting for a cache access")
+
+    table_assoc = Param.Int(4, "Associativity of the PC table")
+    table_entries = Param.MemorySize("256",
+        "Number of entries of the PC table")
+    table_indexing_policy = Param.BaseIndexingPolicy(
+        SetAssociative(entry_size = 1, assoc = Parent.table_assoc,
+        size = Parent.table_entries),
+        "Indexing policy of the PC table")
+    table_replacement_policy = Param.BaseReplacementPolicy(LRURP(),
+        "Replacement policy of the PC table")
+
+    def listenFromProbeLoadValues(self, simObj):
+        if not isinstance(simObj, SimObject):
+            raise TypeError("argument must be of SimObject type")
+        self.addEvent(HWPProbeEventLoadValues(self, simObj, "LoadValue"))
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/prefetch/pointer_chase.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/HWPrefetch.hh"
+#include "mem/cache/prefetch/associative_set_impl.hh"
+#include "params/PointerChasePrefetcher.hh"
+
+namespace gem5
+{
+
+namespace prefetch
+{
+
+PointerChase::PCEntry::PCEntry(unsigned confidence_bits)
+  : TaggedEntry(), confidence(confidence_bits)
+{
+    invalidate();
+}
+
+void
+PointerChase::PCEntry::invalidate()
+{
+    TaggedEntry::invalidate();
+    lastAddr = 0;
+    lastValue = 0;
+    stride = 0;
+    confidence.reset();
+    lastTarget = MaxAddr;
+}
+
+PointerChase::PointerChase(const PointerChasePrefetcherParams &p)
+  : Queued(p), regionBits(p.region_bits), degree(p.degree),
+    confidenceThreshold(p.confidence_threshold),
+    maxPendingTargets(p.max_pending_targets),
+    pcTable(p.table_assoc, p.table_entries, p.table_indexing_policy,
+        p.table_replacement_policy, PCEntry(p.confidence_counter_bits)),
+    listenersLoadValue()
+{
+    fatal_if(regionBits >= 64, "The pointer region must be smaller than "
+        "the address space.");
+    fatal_if(maxPendingTargets == 0,
+        "At least one pointer target must be allowed to wait.");
+}
+
+bool
+PointerChase::isPointer(Addr load_addr, uint64_t value) const
+{
+    return value != 0 && (value >> regionBits) == (load_addr >> regionBits);
+}
+
+void
+PointerChase::addTarget(Addr target)
+{
+    if (pendingTargets.size() == maxPendingTargets) {
+        pendingTargets.pop_front();
+    }
+    pendingTargets.push_back(blockAddress(target));
+}
+
+void
+PointerChase::notifyLoadValue(const probing::LoadValueInfo &info)
+{
+    PCEntry *entry = pcTable.findEntry(info.pc, /* unused */ false);
+
+    if (info.predicted) {
+        // The address of a load is unknown at decode, so compare the
+        // predicted pointer with the address of its previous instance
+        if (entry == nullptr || !isPointer(entry->lastAddr, info.value)) {
+            return;
+        }
+        pcTable.accessEntry(entry);
+
+        // A stable pointer is predicted over and over; it only needs to
+        // be fetched once
+        const Addr target = blockAddress(info.value);
+        if (target != entry->lastTarget) {
+            DPRINTF(HWPrefetch, "Predicted pointer %#x loaded by PC %#x\n",
+                    info.value, info.pc);
+            entry->lastTarget = target;
+            addTarget(target);
+        }
+        return;
+    }
+
+    if (entry == nullptr) {
+        entry = pcTable.findVictim(info.pc);
+        entry->lastAddr = info.addr;
+        entry->lastValue = info.value;
+        pcTable.insertEntry(info.pc, /* unused */ false, entry);
+        return;
+    }
+    pcTable.accessEntry(entry);
+
+    const int64_t stride = info.value - entry->lastValue;
+    if (stride == entry->stride) {
+        entry->confidence++;
+    } else {
+        entry->confidence--;
+        if (entry->confidence < confidenceThreshold) {
+            entry->stride = stride;
+        }
+    }
+    entry->lastAddr = info.addr;
+    entry->lastValue = info.value;
+
+    // Nodes laid out at a regular distance: the next instances of the
+    // load will follow the stride
+    if (entry->stride != 0 && entry->confidence >= confidenceThreshold &&
+        isPointer(info.addr, info.value)) {
+        DPRINTF(HWPrefetch, "Pointer chain %#x with stride %d loaded by "
+                "PC %#x\n", info.value, entry->stride, info.pc);
+        for (unsigned d = 1; d <= degree; d++) {
+            addTarget(info.value + d * entry->stride);
+        }
+    }
+}
+
+void
+PointerChase::calculatePrefetch(const PrefetchInfo &pfi,
+    std::vector<AddrPriority> &addresses)
+{
+    for (const Addr target : pendingTargets) {
+        addresses.push_back(AddrPriority(target, 0));
+    }
+    pendingTargets.clear();
+}
+
+void
+PointerChase::PrefetchListenerLoadValue::notify(
+    const probing::LoadValueInfo &info)
+{
+    parent.notifyLoadValue(info);
+}
+
+void
+PointerChase::addEventProbeLoadValues(SimObject *obj, const char *name)
+{
+    ProbeManager *pm(obj->getProbeManager());
+    listenersLoadValue.push_back(
+        new PrefetchListenerLoadValue(*this, pm, name));
+}
+
+} // namespace prefetch
+} // namespace gem5
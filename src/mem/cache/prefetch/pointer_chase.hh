@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Describes a content-directed prefetcher for pointer chains, driven by the
+ * load values a core's load value predictor (LVPUnit) predicts and observes.
+ *
+ * Every load value is compared against the address of the load that
+ * produced it: a value in the same address region is taken to be a
+ * pointer. The values each load PC returns are also tracked for a stride,
+ * so that chains of nodes laid out at a regular distance are prefetched
+ * ahead of the traversal.
+ *
+ * Like any queued prefetcher, this one only generates prefetches when the
+ * cache it is attached to is accessed. The pointers found through the
+ * probe wait until the next access to that cache, whichever load or store
+ * it is, and are then queued as its prefetches. A pointer the LVP unit
+ * predicts at decode is thus usually prefetched before the load it was
+ * predicted for reaches the cache, but only if an older access reaches
+ * it first.
+ */
+
+#ifndef __MEM_CACHE_PREFETCH_POINTER_CHASE_HH__
+#define __MEM_CACHE_PREFETCH_POINTER_CHASE_HH__
+
+#include <deque>
+#include <vector>
+
+#include "base/sat_counter.hh"
+#include "base/types.hh"
+#include "mem/cache/prefetch/associative_set.hh"
+#include "mem/cache/prefetch/queued.hh"
+#include "sim/probe/mem.hh"
+
+namespace gem5
+{
+
+struct PointerChasePrefetcherParams;
+
+namespace prefetch
+{
+
+class PointerChase : public Queued
+{
+    /** Number of low bits pointers may differ in from the load address */
+    const unsigned regionBits;
+
+    /** Number of prefetches along a strided chain */
+    const unsigned degree;
+
+    /** Confidence needed to prefetch along a strided chain */
+    const unsigned confidenceThreshold;
+
+    /** Maximum number of targets waiting for the next cache access */
+    const unsigned maxPendingTargets;
+
+    /** Tracks the values loaded by a load PC */
+    struct PCEntry : public TaggedEntry
+    {
+        PCEntry(unsigned confidence_bits);
+
+        void invalidate() override;
+
+        /** Data address of the last instance of the load */
+        Addr lastAddr;
+        /** Value returned by the last instance of the load */
+        uint64_t lastValue;
+        /** Distance between consecutive values */
+        int64_t stride;
+        /** Confidence in the stride */
+        SatCounter8 confidence;
+        /** Last predicted pointer that was prefetched */
+        Addr lastTarget;
+    };
+    AssociativeSet<PCEntry> pcTable;
+
+    /**
+     * Pointer targets found since the last cache access, which are turned
+     * into prefetches by calculatePrefetch().
+     */
+    std::deque<Addr> pendingTargets;
+
+    /**
+     * Probe Listener to handle load value events from the CPU
+     */
+    class PrefetchListenerLoadValue
+        : public ProbeListenerArgBase<probing::LoadValueInfo>
+    {
+      public:
+        PrefetchListenerLoadValue(PointerChase &_parent, ProbeManager *pm,
+                                  const std::string &name)
+            : ProbeListenerArgBase(pm, name),
+              parent(_parent) {}
+        void notify(const probing::LoadValueInfo &info) override;
+      protected:
+        PointerChase &parent;
+    };
+
+    /** Array of probe listeners */
+    std::vector<PrefetchListenerLoadValue *> listenersLoadValue;
+
+    /** @return Whether a value looks like a pointer for the given load */
+    bool isPointer(Addr load_addr, uint64_t value) const;
+
+    /** Queues a pointer target for the next cache access */
+    void addTarget(Addr target);
+
+    /**
+     * Updates the prefetcher with a load value.
+     * @param info The load value, predicted or returned
+     */
+    void notifyLoadValue(const probing::LoadValueInfo &info);
+
+  public:
+    PointerChase(const PointerChasePrefetcherParams &p);
+    ~PointerChase() = default;
+
+    void calculatePrefetch(const PrefetchInfo &pfi,
+                           std::vector<AddrPriority> &addresses) override;
+
+    /**
+     * Add a SimObject and a probe name to monitor the load values
+     * @param obj The SimObject pointer to listen from
+     * @param name The probe name
+     */
+    void addEventProbeLoadValues(SimObject *obj, const char *name);
+};
+
+} // namespace prefetch
+} // namespace gem5
+
+#endif // __MEM_CACHE_PREFETCH_POINTER_CHASE_HH__
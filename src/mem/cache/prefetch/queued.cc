@@ -61,7 +61,7 @@ Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
                                             bool tag_prefetch,
                                             Tick t) {
     /* Create a prefetch memory request */
-    RequestPtr req = std::make_shared<Request>(paddr, blk_size,
+    RequestPtr req = Request::create(paddr, blk_size,
                                                 0, requestor_id);
 
     if (pfInfo.isSecure()) {
@@ -98,6 +98,76 @@ Queued::DeferredPacket::finish(const Fault &fault,
     owner->translationComplete(this, failed);
 }
 
+Queued::DeferredQueue::iterator
+Queued::DeferredQueue::lowestPriority()
+{
+    assert(!entries.empty());
+    const int32_t lowest = entries.rbegin()->first.priority;
+    return entries.lower_bound(Key{lowest, 0});
+}
+
+Queued::DeferredQueue::iterator
+Queued::DeferredQueue::push(const DeferredPacket &dp)
+{
+    iterator it =
+        entries.emplace(Key{dp.priority, nextSeqNum++}, dp).first;
+    index.emplace(indexKey(dp.pfInfo.getAddr(), dp.pfInfo.isSecure()), it);
+    return it;
+}
+
+Queued::DeferredQueue::iterator
+Queued::DeferredQueue::erase(iterator it)
+{
+    index.erase(findIndex(it));
+    return entries.erase(it);
+}
+
+Queued::DeferredQueue::iterator
+Queued::DeferredQueue::find(Addr addr, bool is_secure)
+{
+    auto it = index.find(indexKey(addr, is_secure));
+    return it == index.end() ? entries.end() : it->second;
+}
+
+Queued::DeferredQueue::iterator
+Queued::DeferredQueue::find(const DeferredPacket *dp)
+{
+    auto range = index.equal_range(
+        indexKey(dp->pfInfo.getAddr(), dp->pfInfo.isSecure()));
+    for (auto it = range.first; it != range.second; it++) {
+        if (&it->second->second == dp) {
+            return it->second;
+        }
+    }
+    return entries.end();
+}
+
+Queued::DeferredQueue::iterator
+Queued::DeferredQueue::updatePriority(iterator it, int32_t priority)
+{
+    auto index_it = findIndex(it);
+
+    // Re-key the node in place, so that the packet itself does not move
+    auto node = entries.extract(it);
+    node.key().priority = priority;
+    node.mapped().priority = priority;
+    index_it->second = entries.insert(std::move(node)).position;
+    return index_it->second;
+}
+
+std::unordered_multimap<Addr, Queued::DeferredQueue::iterator>::iterator
+Queued::DeferredQueue::findIndex(iterator it)
+{
+    auto range = index.equal_range(
+        indexKey(it->second.pfInfo.getAddr(), it->second.pfInfo.isSecure()));
+    for (auto index_it = range.first; index_it != range.second; index_it++) {
+        if (index_it->second == it) {
+            return index_it;
+        }
+    }
+    panic("Deferred packet missing from the queue index.");
+}
+
 Queued::Queued(const QueuedPrefetcherParams &p)
     : Base(p), queueSize(p.queue_size),
       missingTranslationQueueSize(
@@ -112,13 +182,13 @@ Queued::Queued(const QueuedPrefetcherParams &p)
 Queued::~Queued()
 {
     // Delete the queued prefetch packets
-    for (DeferredPacket &p : pfq) {
-        delete p.pkt;
+    for (auto &entry : pfq) {
+        delete entry.second.pkt;
     }
 }
 
 void
-Queued::printQueue(const std::list<DeferredPacket> &queue) const
+Queued::printQueue(const DeferredQueue &queue) const
 {
     int pos = 0;
     std::string queue_name = "";
@@ -129,13 +199,13 @@ Queued::printQueue(const std::list<DeferredPacket> &queue) const
         queue_name = "PFTransQ";
     }
 
-    for (const_iterator it = queue.cbegin(); it != queue.cend();
-                                                            it++, pos++) {
-        Addr vaddr = it->pfInfo.getAddr();
+    for (const auto &entry : queue) {
+        const DeferredPacket &dp = entry.second;
+        Addr vaddr = dp.pfInfo.getAddr();
         /* Set paddr to 0 if not yet translated */
-        Addr paddr = it->pkt ? it->pkt->getAddr() : 0;
+        Addr paddr = dp.pkt ? dp.pkt->getAddr() : 0;
         DPRINTF(HWPrefetchQueue, "%s[%d]: Prefetch Req VA: %#x PA: %#x "
-                "prio: %3d\n", queue_name, pos, vaddr, paddr, it->priority);
+                "prio: %3d\n", queue_name, pos++, vaddr, paddr, dp.priority);
     }
 }
 
@@ -177,20 +247,16 @@ Queued::notify(const PacketPtr &pkt, const PrefetchInfo &pfi)
 
     // Squash queued prefetches if demand miss to same line
     if (queueSquash) {
-        auto itr = pfq.begin();
+        auto itr = pfq.find(blk_addr, is_secure);
         while (itr != pfq.end()) {
-            if (itr->pfInfo.getAddr() == blk_addr &&
-                itr->pfInfo.isSecure() == is_secure) {
-                DPRINTF(HWPrefetch, "Removing pf candidate addr: %#x "
-                        "(cl: %#x), demand request going to the same addr\n",
-                        itr->pfInfo.getAddr(),
-                        blockAddress(itr->pfInfo.getAddr()));
-                delete itr->pkt;
-                itr = pfq.erase(itr);
-                statsQueued.pfRemovedDemand++;
-            } else {
-                ++itr;
-            }
+            DPRINTF(HWPrefetch, "Removing pf candidate addr: %#x "
+                    "(cl: %#x), demand request going to the same addr\n",
+                    itr->second.pfInfo.getAddr(),
+                    blockAddress(itr->second.pfInfo.getAddr()));
+            delete itr->second.pkt;
+            pfq.erase(itr);
+            statsQueued.pfRemovedDemand++;
+            itr = pfq.find(blk_addr, is_secure);
         }
     }
 
@@ -251,7 +317,7 @@ Queued::getPacket()
     }
 
     PacketPtr pkt = pfq.front().pkt;
-    pfq.pop_front();
+    pfq.erase(pfq.begin());
 
     prefetchStats.pfIssued++;
     issuedPrefetches += 1;
@@ -287,9 +353,9 @@ void
 Queued::processMissingTranslations(unsigned max)
 {
     unsigned count = 0;
-    iterator it = pfqMissingTranslation.begin();
+    auto it = pfqMissingTranslation.begin();
     while (it != pfqMissingTranslation.end() && count < max) {
-        DeferredPacket &dp = *it;
+        DeferredPacket &dp = it->second;
         // Increase the iterator first because dp.startTranslation can end up
         // calling finishTranslation, which will erase "it"
         it++;
@@ -301,80 +367,62 @@ Queued::processMissingTranslations(unsigned max)
 void
 Queued::translationComplete(DeferredPacket *dp, bool failed)
 {
-    auto it = pfqMissingTranslation.begin();
-    while (it != pfqMissingTranslation.end()) {
-        if (&(*it) == dp) {
-            break;
-        }
-        it++;
-    }
+    auto it = pfqMissingTranslation.find(dp);
     assert(it != pfqMissingTranslation.end());
     if (!failed) {
         DPRINTF(HWPrefetch, "%s Translation of vaddr %#x succeeded: "
                 "paddr %#x \n", tlb->name(),
-                it->translationRequest->getVaddr(),
-                it->translationRequest->getPaddr());
-        Addr target_paddr = it->translationRequest->getPaddr();
+                dp->translationRequest->getVaddr(),
+                dp->translationRequest->getPaddr());
+        Addr target_paddr = dp->translationRequest->getPaddr();
         // check if this prefetch is already redundant
-        if (cacheSnoop && (inCache(target_paddr, it->pfInfo.isSecure()) ||
-                    inMissQueue(target_paddr, it->pfInfo.isSecure()))) {
+        if (cacheSnoop && (inCache(target_paddr, dp->pfInfo.isSecure()) ||
+                    inMissQueue(target_paddr, dp->pfInfo.isSecure()))) {
             statsQueued.pfInCache++;
             DPRINTF(HWPrefetch, "Dropping redundant in "
                     "cache/MSHR prefetch addr:%#x\n", target_paddr);
         } else {
             Tick pf_time = curTick() + clockPeriod() * latency;
-            it->createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
+            dp->createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
                           pf_time);
-            addToQueue(pfq, *it);
+            addToQueue(pfq, *dp);
         }
     } else {
         DPRINTF(HWPrefetch, "%s Translation of vaddr %#x failed, dropping "
                 "prefetch request %#x \n", tlb->name(),
-                it->translationRequest->getVaddr());
+                dp->translationRequest->getVaddr());
     }
     pfqMissingTranslation.erase(it);
 }
 
 bool
-Queued::alreadyInQueue(std::list<DeferredPacket> &queue,
-                                 const PrefetchInfo &pfi, int32_t priority)
+Queued::alreadyInQueue(DeferredQueue &queue, const PrefetchInfo &pfi,
+                       int32_t priority)
 {
-    bool found = false;
-    iterator it;
-    for (it = queue.begin(); it != queue.end() && !found; it++) {
-        found = it->pfInfo.sameAddr(pfi);
+    auto it = queue.find(pfi.getAddr(), pfi.isSecure());
+    if (it == queue.end()) {
+        return false;
     }
 
-    /* If the address is already in the queue, update priority and leave */
-    if (it != queue.end()) {
-        statsQueued.pfBufferHit++;
-        if (it->priority < priority) {
-            /* Update priority value and position in the queue */
-            it->priority = priority;
-            iterator prev = it;
-            while (prev != queue.begin()) {
-                prev--;
-                /* If the packet has higher priority, swap */
-                if (*it > *prev) {
-                    std::swap(*it, *prev);
-                    it = prev;
-                }
-            }
-            DPRINTF(HWPrefetch, "Prefetch addr already in "
-                "prefetch queue, priority updated\n");
-        } else {
-            DPRINTF(HWPrefetch, "Prefetch addr already in "
-                "prefetch queue\n");
-        }
+    /* The address is already in the queue, update priority and leave */
+    statsQueued.pfBufferHit++;
+    if (it->second.priority < priority) {
+        /* Update priority value and position in the queue */
+        queue.updatePriority(it, priority);
+        DPRINTF(HWPrefetch, "Prefetch addr already in "
+            "prefetch queue, priority updated\n");
+    } else {
+        DPRINTF(HWPrefetch, "Prefetch addr already in "
+            "prefetch queue\n");
     }
-    return found;
+    return true;
 }
 
 RequestPtr
 Queued::createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt)
 {
-    RequestPtr translation_req = std::make_shared<Request>(
+    RequestPtr translation_req = Request::create(
             addr, blkSize, pkt->req->getFlags(), requestorId, pfi.getPC(),
             pkt->req->contextId());
     translation_req->setFlags(Request::PREFETCH);
@@ -481,50 +529,23 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
 }
 
 void
-Queued::addToQueue(std::list<DeferredPacket> &queue,
-                             DeferredPacket &dpp)
+Queued::addToQueue(DeferredQueue &queue, DeferredPacket &dpp)
 {
     /* Verify prefetch buffer space for request */
     if (queue.size() == queueSize) {
         statsQueued.pfRemovedFull++;
-        /* Lowest priority packet */
-        iterator it = queue.end();
-        panic_if (it == queue.begin(),
-            "Prefetch queue is both full and empty!");
-        --it;
-        /* Look for oldest in that level of priority */
-        panic_if (it == queue.begin(),
-            "Prefetch queue is full with 1 element!");
-        iterator prev = it;
-        bool cont = true;
-        /* While not at the head of the queue */
-        while (cont && prev != queue.begin()) {
-            prev--;
-            /* While at the same level of priority */
-            cont = prev->priority == it->priority;
-            if (cont)
-                /* update pointer */
-                it = prev;
-        }
+        panic_if(queue.empty(), "Prefetch queue is both full and empty!");
+        panic_if(queue.size() == 1, "Prefetch queue is full with 1 element!");
+        /* Oldest packet of the lowest priority */
+        auto it = queue.lowestPriority();
         DPRINTF(HWPrefetch, "Prefetch queue full, removing lowest priority "
-                            "oldest packet, addr: %#x\n",it->pfInfo.getAddr());
-        delete it->pkt;
+                            "oldest packet, addr: %#x\n",
+                            it->second.pfInfo.getAddr());
+        delete it->second.pkt;
         queue.erase(it);
     }
 
-    if ((queue.size() == 0) || (dpp <= queue.back())) {
-        queue.emplace_back(dpp);
-    } else {
-        iterator it = queue.end();
-        do {
-            --it;
-        } while (it != queue.begin() && dpp > *it);
-        /* If we reach the head, we have to see if the new element is new head
-         * or not */
-        if (it == queue.begin() && dpp <= *it)
-            it++;
-        queue.insert(it, dpp);
-    }
+    queue.push(dpp);
 
     if (debug::HWPrefetchQueue)
         printQueue(queue);
@@ -39,7 +39,8 @@
 #define __MEM_CACHE_PREFETCH_QUEUED_HH__
 
 #include <cstdint>
-#include <list>
+#include <map>
+#include <unordered_map>
 #include <utility>
 
 #include "arch/generic/mmu.hh"
@@ -140,11 +141,92 @@ class Queued : public Base
         void startTranslation(BaseTLB *tlb);
     };
 
-    std::list<DeferredPacket> pfq;
-    std::list<DeferredPacket> pfqMissingTranslation;
+    /**
+     * A queue of deferred packets, ordered by decreasing priority and, for
+     * the same priority, by age. Packets are never moved once queued, as
+     * the TLB holds on to them while they are being translated. Lookups by
+     * prefetch address go through a hash index instead of walking the
+     * queue.
+     */
+    class DeferredQueue
+    {
+      private:
+        /** Position of a packet: its priority, then its insertion order */
+        struct Key
+        {
+            int32_t priority;
+            uint64_t seqNum;
+
+            bool operator<(const Key &that) const
+            {
+                return priority != that.priority ?
+                    priority > that.priority : seqNum < that.seqNum;
+            }
+        };
+
+        using Entries = std::map<Key, DeferredPacket>;
+
+      public:
+        using iterator = Entries::iterator;
+        using const_iterator = Entries::const_iterator;
+
+        iterator begin() { return entries.begin(); }
+        iterator end() { return entries.end(); }
+        const_iterator begin() const { return entries.begin(); }
+        const_iterator end() const { return entries.end(); }
+
+        size_t size() const { return entries.size(); }
+        bool empty() const { return entries.empty(); }
+
+        /** @return The highest priority, oldest, packet */
+        DeferredPacket &front() { return entries.begin()->second; }
+        const DeferredPacket &
+        front() const
+        {
+            return entries.begin()->second;
+        }
+
+        /** @return The lowest priority, oldest, packet */
+        iterator lowestPriority();
+
+        /** Queues a copy of the packet behind those of equal priority */
+        iterator push(const DeferredPacket &dp);
+
+        /** Removes a packet, without deleting its memory packet */
+        iterator erase(iterator it);
+
+        /** @return A packet to the given address, or end() */
+        iterator find(Addr addr, bool is_secure);
+
+        /** @return The entry holding the given packet, or end() */
+        iterator find(const DeferredPacket *dp);
+
+        /** Moves a packet to the position of its new priority */
+        iterator updatePriority(iterator it, int32_t priority);
+
+      private:
+        /** The queued packets */
+        Entries entries;
+
+        /** Hash index on the prefetch address and security bit */
+        std::unordered_multimap<Addr, iterator> index;
+
+        /** Insertion order of the next packet */
+        uint64_t nextSeqNum = 0;
+
+        static Addr
+        indexKey(Addr addr, bool is_secure)
+        {
+            return (addr << 1) | is_secure;
+        }
+
+        /** @return The index entry pointing to the given packet */
+        std::unordered_multimap<Addr, iterator>::iterator
+        findIndex(iterator it);
+    };
 
-    using const_iterator = std::list<DeferredPacket>::const_iterator;
-    using iterator = std::list<DeferredPacket>::iterator;
+    DeferredQueue pfq;
+    DeferredQueue pfqMissingTranslation;
 
     // PARAMETERS
 
@@ -206,7 +288,7 @@ class Queued : public Base
         return pfq.empty() ? MaxTick : pfq.front().tick;
     }
 
-    void printQueue(const std::list<DeferredPacket> &queue) const;
+    void printQueue(const DeferredQueue &queue) const;
 
   private:
 
@@ -215,7 +297,7 @@ class Queued : public Base
      * @param queue selected queue to use
      * @param dpp DeferredPacket to add
      */
-    void addToQueue(std::list<DeferredPacket> &queue, DeferredPacket &dpp);
+    void addToQueue(DeferredQueue &queue, DeferredPacket &dpp);
 
     /**
      * Starts the translations of the queued prefetches with a
@@ -243,8 +325,8 @@ class Queued : public Base
      * @param priority priority of the prefetch request to be added
      * @return True if the prefetch request was found in the queue
      */
-    bool alreadyInQueue(std::list<DeferredPacket> &queue,
-                        const PrefetchInfo &pfi, int32_t priority);
+    bool alreadyInQueue(DeferredQueue &queue, const PrefetchInfo &pfi,
+                        int32_t priority);
 
     /**
      * Returns the maxmimum number of prefetch requests that are allowed
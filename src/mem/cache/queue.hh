@@ -48,7 +48,9 @@
 #include <cassert>
 #include <string>
 #include <type_traits>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
@@ -101,6 +103,48 @@ class Queue : public Drainable, public Named
     /** Holds non allocated entries. */
     typename Entry::List freeList;
 
+    /** Number of bits of an index bucket number. */
+    const unsigned indexBits;
+
+    /**
+     * Hash index of the allocated entries by block address. The entries
+     * of a bucket are chained through QueueEntry::indexNext in allocation
+     * order, so a lookup finds the same entry a walk of the allocated list
+     * would.
+     */
+    std::vector<QueueEntry *> indexBuckets;
+
+    /** @return The index bucket of a block address. */
+    size_t
+    indexBucket(Addr blk_addr) const
+    {
+        return (blk_addr * 0x9e3779b97f4a7c15ULL) >> (64 - indexBits);
+    }
+
+    /** Adds a newly allocated entry to the address index. */
+    void
+    addToIndex(Entry *entry)
+    {
+        QueueEntry **link = &indexBuckets[indexBucket(entry->blkAddr)];
+        while (*link)
+            link = &(*link)->indexNext;
+        *link = entry;
+        entry->indexNext = nullptr;
+    }
+
+    /** Removes an entry being deallocated from the address index. */
+    void
+    removeFromIndex(Entry *entry)
+    {
+        QueueEntry **link = &indexBuckets[indexBucket(entry->blkAddr)];
+        while (*link != entry) {
+            assert(*link);
+            link = &(*link)->indexNext;
+        }
+        *link = entry->indexNext;
+        entry->indexNext = nullptr;
+    }
+
     typename Entry::Iterator addToReadyList(Entry* entry)
     {
         if (readyList.empty() ||
@@ -135,6 +179,8 @@ class Queue : public Drainable, public Named
         Named(name),
         label(_label), numEntries(num_entries + reserve),
         numReserve(reserve), entries(numEntries, name + ".entry"),
+        indexBits(ceilLog2(2 * numEntries)),
+        indexBuckets(1ULL << indexBits, nullptr),
         _numInService(0), allocated(0)
     {
         for (int i = 0; i < numEntries; ++i) {
@@ -168,7 +214,9 @@ class Queue : public Drainable, public Named
     Entry* findMatch(Addr blk_addr, bool is_secure,
                      bool ignore_uncacheable = true) const
     {
-        for (const auto& entry : allocatedList) {
+        QueueEntry *qe = indexBuckets[indexBucket(blk_addr)];
+        for (; qe; qe = qe->indexNext) {
+            Entry *entry = static_cast<Entry *>(qe);
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
             // cache we never check for matches when adding new
@@ -241,6 +289,7 @@ class Queue : public Drainable, public Named
     deallocate(Entry *entry)
     {
         allocatedList.erase(entry->allocIter);
+        removeFromIndex(entry);
         freeList.push_front(entry);
         allocated--;
         if (entry->inService) {
@@ -64,6 +64,12 @@ class BaseTags(ClockedObject):
     sequential_access = Param.Bool(Parent.sequential_access,
         "Whether to access tags and data sequentially")
 
+    # Get whether the data is held compressed from the parent (cache)
+    compress_host_data = Param.Bool(Parent.compress_host_data,
+        "Whether to hold the data of the blocks compressed in host memory")
+    host_staging_blocks = Param.Unsigned(64, "Number of blocks held "
+        "decompressed when the data is held compressed")
+
     # Get indexing policy
     indexing_policy = Param.BaseIndexingPolicy(SetAssociative(),
         "Indexing policy")
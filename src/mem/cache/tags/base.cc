@@ -64,7 +64,11 @@ BaseTags::BaseTags(const Params &p)
       system(p.system), indexingPolicy(p.indexing_policy),
       warmupBound((p.warmup_percentage/100.0) * (p.size / p.block_size)),
       warmedUp(false), numBlocks(p.size / p.block_size),
-      dataBlks(new uint8_t[p.size]), // Allocate data storage in one big chunk
+      // Allocate data storage in one big chunk, unless it is compressed
+      dataBlks(p.compress_host_data ? nullptr : new uint8_t[p.size]),
+      blockStore(p.compress_host_data ?
+          new CompressedBlockStore(this, blkSize, p.host_staging_blocks,
+                                   numBlocks) : nullptr),
       stats(*this)
 {
     registerExitCallback([this]() { cleanupRefs(); });
@@ -132,6 +136,11 @@ BaseTags::moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk)
     assert(!dest_blk->isValid());
     assert(src_blk->isValid());
 
+    // The data of a compressed block moves along with it
+    if (blockStore) {
+        blockStore->move(src_blk, dest_blk);
+    }
+
     // Move src's contents to dest's
     *dest_blk = std::move(*src_blk);
 
@@ -47,6 +47,7 @@
 #define __MEM_CACHE_TAGS_BASE_HH__
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -56,6 +57,7 @@
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/cache/cache_blk.hh"
+#include "mem/cache/tags/compressed_block_store.hh"
 #include "mem/packet.hh"
 #include "params/BaseTags.hh"
 #include "sim/clocked_object.hh"
@@ -99,9 +101,24 @@ class BaseTags : public ClockedObject
     /** the number of blocks in the cache */
     const unsigned numBlocks;
 
-    /** The data blocks, 1 per cache block. */
+    /** The data blocks, 1 per cache block, unless they are compressed. */
     std::unique_ptr<uint8_t[]> dataBlks;
 
+    /** The store of the compressed data blocks, if they are compressed. */
+    std::unique_ptr<CompressedBlockStore> blockStore;
+
+    /**
+     * Get the data chunk of a block, to associate to it on init.
+     *
+     * @param blk_index The index of the block.
+     * @return The chunk, or nullptr if the data blocks are compressed.
+     */
+    uint8_t *
+    dataChunk(std::size_t blk_index) const
+    {
+        return dataBlks ? &dataBlks[blkSize * blk_index] : nullptr;
+    }
+
     /**
      * TODO: It would be good if these stats were acquired after warmup.
      */
@@ -189,6 +206,20 @@ class BaseTags : public ClockedObject
      */
     std::string print();
 
+    /**
+     * Get the data of a block, decompressing it if the data blocks are
+     * compressed. The pointer must not be kept across accesses to the
+     * data of other blocks.
+     *
+     * @param blk The block.
+     * @return Pointer to the data of the block.
+     */
+    uint8_t *
+    getBlkData(CacheBlk *blk)
+    {
+        return blockStore ? blockStore->access(blk) : blk->data;
+    }
+
     /**
      * Finds the block in the cache without touching it.
      *
@@ -260,6 +291,9 @@ class BaseTags : public ClockedObject
         stats.totalRefs += blk->getRefCount();
         stats.sampledRefs++;
 
+        if (blockStore) {
+            blockStore->release(blk);
+        }
         blk->invalidate();
     }
 
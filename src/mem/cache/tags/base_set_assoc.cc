@@ -55,7 +55,9 @@ namespace gem5
 BaseSetAssoc::BaseSetAssoc(const Params &p)
     :BaseTags(p), allocAssoc(p.assoc), blks(p.size / p.block_size),
      sequentialAccess(p.sequential_access),
-     replacementPolicy(p.replacement_policy)
+     replacementPolicy(p.replacement_policy),
+     setAssocIndexing(dynamic_cast<SetAssociative *>(p.indexing_policy)),
+     tagArray(setAssocIndexing ? blks.size() : 0, p.assoc)
 {
     // There must be a indexing policy
     fatal_if(!p.indexing_policy, "An indexing policy is required");
@@ -78,11 +80,38 @@ BaseSetAssoc::tagsInit()
         indexingPolicy->setEntry(blk, blk_index);
 
         // Associate a data chunk to the block
-        blk->data = &dataBlks[blkSize*blk_index];
+        blk->data = dataChunk(blk_index);
 
         // Associate a replacement data entry to the block
         blk->replacementData = replacementPolicy->instantiateEntry();
+
+        // Mirror its tag into the tag array
+        if (setAssocIndexing) {
+            tagArray.bind(*blk, blk_index);
+        }
+    }
+}
+
+CacheBlk*
+BaseSetAssoc::findBlock(Addr addr, bool is_secure) const
+{
+    if (!setAssocIndexing) {
+        return BaseTags::findBlock(addr, is_secure);
+    }
+
+    // Compare all the ways of the set at once
+    const Addr tag = extractTag(addr);
+    const uint32_t set = setAssocIndexing->extractSet(addr);
+    const int way = tagArray.findWay(set,
+                                     TaggedEntry::lookupKey(tag, is_secure));
+    if (way < 0) {
+        return nullptr;
     }
+
+    CacheBlk *blk =
+        static_cast<CacheBlk*>(indexingPolicy->getEntry(set, way));
+    assert(blk->matchTag(tag, is_secure));
+    return blk;
 }
 
 void
@@ -59,6 +59,8 @@
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/tags/indexing_policies/base.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "mem/cache/tags/tag_array.hh"
 #include "mem/packet.hh"
 #include "params/BaseSetAssoc.hh"
 
@@ -87,6 +89,16 @@ class BaseSetAssoc : public BaseTags
     /** Replacement policy */
     replacement_policy::Base *replacementPolicy;
 
+    /** The indexing policy, if it is a plain set associative one. */
+    SetAssociative *const setAssocIndexing;
+
+    /**
+     * Contiguous copy of the block tags. It is only kept, and searched
+     * instead of the blocks, with set associative indexing, as other
+     * policies do not place a set's ways next to each other.
+     */
+    TagArray tagArray;
+
   public:
     /** Convenience typedef. */
      typedef BaseSetAssocParams Params;
@@ -106,6 +118,8 @@ class BaseSetAssoc : public BaseTags
      */
     void tagsInit() override;
 
+    CacheBlk *findBlock(Addr addr, bool is_secure) const override;
+
     /**
      * This function updates the tags when a block is invalidated. It also
      * updates the replacement data.
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/tags/compressed_block_codec.hh"
+
+#include <cassert>
+#include <cstring>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+CompressedBlockCodec::CompressedBlockCodec(unsigned blk_size)
+  : blkSize(blk_size), numWords(blk_size / sizeof(uint64_t)),
+    maskBytes((numWords + 7) / 8)
+{
+    fatal_if(blkSize % sizeof(uint64_t) != 0 || numWords > 64,
+        "Blocks stored compressed must be made of at most 64 words.");
+}
+
+std::size_t
+CompressedBlockCodec::encode(const uint8_t *data, uint8_t *blob) const
+{
+    uint64_t words[64];
+    std::memcpy(words, data, blkSize);
+
+    uint8_t *mask = blob + headerSize;
+    std::memset(mask, 0, maskBytes);
+
+    // The first non-zero word is the base of all deltas
+    uint64_t base = 0;
+    unsigned num_nonzero = 0;
+    uint64_t max_magnitude = 0;
+    for (unsigned i = 0; i < numWords; i++) {
+        if (words[i] == 0) {
+            continue;
+        }
+        mask[i / 8] |= 1 << (i % 8);
+        if (num_nonzero++ == 0) {
+            base = words[i];
+        } else {
+            // Zig-zag the delta, so that its magnitude gives its width
+            const int64_t delta = int64_t(words[i] - base);
+            max_magnitude |= (uint64_t(delta) << 1) ^ uint64_t(delta >> 63);
+        }
+    }
+    if (num_nonzero == 0) {
+        return 0;
+    }
+
+    unsigned width = 0;
+    while (width < sizeof(uint64_t) &&
+           (width == 0 ? max_magnitude != 0 :
+                         (max_magnitude >> (8 * width)) != 0)) {
+        width = width == 0 ? 1 : width * 2;
+    }
+
+    std::size_t size = headerSize + maskBytes + sizeof(uint64_t) +
+        (num_nonzero - 1) * width;
+    if (size >= headerSize + blkSize) {
+        blob[1] = rawFormat;
+        std::memcpy(blob + headerSize, data, blkSize);
+        size = headerSize + blkSize;
+    } else {
+        blob[1] = width;
+        uint8_t *pos = mask + maskBytes;
+        for (unsigned byte = 0; byte < sizeof(uint64_t); byte++) {
+            *pos++ = base >> (8 * byte);
+        }
+        bool first = true;
+        for (unsigned i = 0; i < numWords; i++) {
+            if (words[i] == 0) {
+                continue;
+            }
+            if (first) {
+                first = false;
+                continue;
+            }
+            const uint64_t delta = words[i] - base;
+            for (unsigned byte = 0; byte < width; byte++) {
+                *pos++ = delta >> (8 * byte);
+            }
+        }
+        assert(pos == blob + size);
+    }
+
+    blob[0] = (size + 7) / 8 - 1;
+    return size;
+}
+
+void
+CompressedBlockCodec::decode(const uint8_t *blob, uint8_t *data) const
+{
+    if (blob == nullptr) {
+        std::memset(data, 0, blkSize);
+        return;
+    }
+
+    const uint8_t format = blob[1];
+    if (format == rawFormat) {
+        std::memcpy(data, blob + headerSize, blkSize);
+        return;
+    }
+
+    const uint8_t *mask = blob + headerSize;
+    const uint8_t *pos = mask + maskBytes;
+    uint64_t base = 0;
+    for (unsigned byte = 0; byte < sizeof(uint64_t); byte++) {
+        base |= uint64_t(*pos++) << (8 * byte);
+    }
+
+    uint64_t words[64];
+    bool first = true;
+    for (unsigned i = 0; i < numWords; i++) {
+        if (!(mask[i / 8] & (1 << (i % 8)))) {
+            words[i] = 0;
+        } else if (first) {
+            first = false;
+            words[i] = base;
+        } else {
+            uint64_t delta = 0;
+            for (unsigned byte = 0; byte < format; byte++) {
+                delta |= uint64_t(*pos++) << (8 * byte);
+            }
+            // Sign extend the delta to the full word
+            if (format > 0 && format < sizeof(uint64_t)) {
+                const unsigned shift = 64 - 8 * format;
+                delta = uint64_t(int64_t(delta << shift) >> shift);
+            }
+            words[i] = base + delta;
+        }
+    }
+    std::memcpy(data, words, blkSize);
+}
+
+} // namespace gem5
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declares the codec the compressed block store keeps the data of cache
+ * blocks in host memory with.
+ */
+
+#ifndef __MEM_CACHE_TAGS_COMPRESSED_BLOCK_CODEC_HH__
+#define __MEM_CACHE_TAGS_COMPRESSED_BLOCK_CODEC_HH__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gem5
+{
+
+/**
+ * Compresses the data of cache blocks into blobs, and back.
+ *
+ * Blocks are encoded as a mask of their zero words followed by the first
+ * non-zero word and the deltas of the other non-zero words to it, all of
+ * the narrowest width that fits them, or verbatim if that is not smaller.
+ * Blocks of all zeros have no blob. A blob starts with its size class,
+ * its size in units of 8 bytes minus one, and its format.
+ */
+class CompressedBlockCodec
+{
+  public:
+    /** Size of the header of a blob: its size class and format. */
+    static constexpr unsigned headerSize = 2;
+
+    /**
+     * @param blk_size The size of a block, in bytes, of at most 64 words.
+     */
+    CompressedBlockCodec(unsigned blk_size);
+
+    /** @return The size of the largest blob, a verbatim block. */
+    std::size_t maxBlobSize() const { return headerSize + blkSize; }
+
+    /** @return The number of size classes of the blobs. */
+    unsigned numSizeClasses() const { return (maxBlobSize() + 7) / 8; }
+
+    /** @return The size class of a blob. */
+    static unsigned sizeClass(const uint8_t *blob) { return blob[0]; }
+
+    /**
+     * Compresses the data of a block into a blob.
+     * @param data The data of the block.
+     * @param blob Where to write the blob, of at least maxBlobSize().
+     * @return The size of the blob, or 0 if the data is all zeros.
+     */
+    std::size_t encode(const uint8_t *data, uint8_t *blob) const;
+
+    /**
+     * Decompresses a blob into the data of a block.
+     * @param blob The blob, or nullptr for a block of zeros.
+     * @param data Where to write the data of the block.
+     */
+    void decode(const uint8_t *blob, uint8_t *data) const;
+
+  private:
+    /** Format of the deltas of a blob that holds the block verbatim. */
+    static constexpr uint8_t rawFormat = 0xff;
+
+    const unsigned blkSize;
+    const unsigned numWords;
+    const unsigned maskBytes;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_COMPRESSED_BLOCK_CODEC_HH__
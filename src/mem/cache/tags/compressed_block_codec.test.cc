@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "mem/cache/tags/compressed_block_codec.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/**
+ * Encode and decode a block, checking that it comes back intact in a blob
+ * of a consistent size class.
+ *
+ * @return The size of the blob.
+ */
+std::size_t
+roundTrip(const CompressedBlockCodec &codec,
+          const std::vector<uint64_t> &words)
+{
+    const std::size_t blk_size = words.size() * sizeof(uint64_t);
+    std::vector<uint8_t> data(blk_size);
+    std::memcpy(data.data(), words.data(), blk_size);
+
+    // Poison the blob and the output, so that stale bytes show
+    std::vector<uint8_t> blob(codec.maxBlobSize(), 0xa5);
+    const std::size_t size = codec.encode(data.data(), blob.data());
+    EXPECT_LE(size, codec.maxBlobSize());
+    if (size != 0) {
+        EXPECT_EQ(CompressedBlockCodec::sizeClass(blob.data()),
+                  (size + 7) / 8 - 1);
+        EXPECT_LT(CompressedBlockCodec::sizeClass(blob.data()),
+                  codec.numSizeClasses());
+    }
+
+    std::vector<uint8_t> decoded(blk_size, 0x5a);
+    codec.decode(size ? blob.data() : nullptr, decoded.data());
+    EXPECT_EQ(decoded, data);
+    return size;
+}
+
+} // anonymous namespace
+
+/** Blocks of zeros have no blob, and decode from none. */
+TEST(CompressedBlockCodecTest, Zeros)
+{
+    const CompressedBlockCodec codec(64);
+    EXPECT_EQ(roundTrip(codec, std::vector<uint64_t>(8, 0)), 0);
+}
+
+/** Each width of the deltas, including their sign extension, and the
+ * words of the block equal to the base. */
+TEST(CompressedBlockCodecTest, DeltaWidths)
+{
+    const CompressedBlockCodec codec(64);
+    const uint64_t base = 0x123456789abcdef0ULL;
+
+    // All the non-zero words the same need no deltas
+    const std::size_t same = roundTrip(codec, {0, base, base, 0, base, 0,
+                                               0, base});
+    EXPECT_EQ(same, CompressedBlockCodec::headerSize + 1 + 8);
+
+    // The largest positive and negative deltas of each width
+    std::size_t last = same;
+    for (unsigned width : {1, 2, 4}) {
+        const int64_t max = (int64_t(1) << (8 * width - 1)) - 1;
+        const std::size_t size = roundTrip(codec,
+            {base, base + max, base - max - 1, 0, base + 1, base - 1,
+             base, 0});
+        EXPECT_EQ(size, CompressedBlockCodec::headerSize + 1 + 8 +
+                  5 * width);
+        EXPECT_GT(size, last);
+        last = size;
+    }
+
+    // A delta that only fits in a full word, and wrap-around
+    roundTrip(codec, {base, 0, ~base, 0, 0, 0, 0, 0});
+    roundTrip(codec, {~0ULL, 1, 0, 0, 0, 0, 0, 0});
+}
+
+/** Blocks that do not compress are held verbatim. */
+TEST(CompressedBlockCodecTest, Raw)
+{
+    const CompressedBlockCodec codec(64);
+    std::mt19937_64 rng(1);
+    std::vector<uint64_t> words(8);
+    for (auto &word : words)
+        word = rng() | 1;
+    EXPECT_EQ(roundTrip(codec, words), codec.maxBlobSize());
+}
+
+/** Random blocks of every supported size, with zero words, words close
+ * to each other and words far apart mixed in. */
+TEST(CompressedBlockCodecTest, Random)
+{
+    std::mt19937_64 rng(1);
+    for (unsigned num_words : {1, 2, 7, 8, 16, 33, 64}) {
+        SCOPED_TRACE(num_words);
+        const CompressedBlockCodec codec(num_words * sizeof(uint64_t));
+        for (int i = 0; i < 2000; i++) {
+            const uint64_t base = rng();
+            const unsigned spread = rng() % 65;
+            std::vector<uint64_t> words(num_words);
+            for (auto &word : words) {
+                switch (rng() % 4) {
+                  case 0:
+                    word = 0;
+                    break;
+                  case 1:
+                    word = rng();
+                    break;
+                  default:
+                    word = base + (spread == 64 ? rng() :
+                                   (rng() & ((1ULL << spread) - 1)) -
+                                   (1ULL << spread >> 1));
+                }
+            }
+            roundTrip(codec, words);
+            if (HasFailure())
+                return;
+        }
+    }
+}
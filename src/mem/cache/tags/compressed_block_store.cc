@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/tags/compressed_block_store.hh"
+
+#include <cassert>
+#include <cstring>
+
+#include "base/logging.hh"
+#include "mem/cache/cache_blk.hh"
+
+namespace gem5
+{
+
+CompressedBlockStore::CompressedBlockStore(statistics::Group *parent,
+    unsigned blk_size, unsigned num_frames, std::size_t num_blocks)
+  : codec(blk_size), blkSize(blk_size), numFrames(num_frames),
+    numBlocks(num_blocks), frames(new uint8_t[num_frames * blk_size]),
+    owners(num_frames, nullptr), referenced(num_frames, false), hand(0),
+    sizeClasses(codec.numSizeClasses()), blobBytes(0), numBlobs(0),
+    scratch(codec.maxBlobSize()), stats(parent, *this)
+{
+    fatal_if(numFrames == 0,
+        "At least one block must be staged decompressed.");
+}
+
+int
+CompressedBlockStore::frameOf(const uint8_t *data) const
+{
+    const uintptr_t offset = reinterpret_cast<uintptr_t>(data) -
+        reinterpret_cast<uintptr_t>(frames.get());
+    if (data == nullptr || offset >= uintptr_t(numFrames) * blkSize) {
+        return -1;
+    }
+    return offset / blkSize;
+}
+
+unsigned
+CompressedBlockStore::reclaimFrame()
+{
+    while (owners[hand] != nullptr && referenced[hand]) {
+        referenced[hand] = false;
+        hand = (hand + 1) % numFrames;
+    }
+    const unsigned frame = hand;
+    hand = (hand + 1) % numFrames;
+
+    CacheBlk *owner = owners[frame];
+    if (owner != nullptr) {
+        owner->data = encode(frameData(frame));
+        owners[frame] = nullptr;
+        stats.compressions++;
+    }
+    return frame;
+}
+
+uint8_t *
+CompressedBlockStore::access(CacheBlk *blk)
+{
+    const int staged = frameOf(blk->data);
+    if (staged >= 0) {
+        assert(owners[staged] == blk);
+        referenced[staged] = true;
+        return blk->data;
+    }
+
+    const unsigned frame = reclaimFrame();
+    uint8_t *data = frameData(frame);
+    codec.decode(blk->data, data);
+    if (blk->data != nullptr) {
+        freeBlob(blk->data);
+    }
+    stats.decompressions++;
+
+    blk->data = data;
+    owners[frame] = blk;
+    referenced[frame] = true;
+    return data;
+}
+
+void
+CompressedBlockStore::release(CacheBlk *blk)
+{
+    const int staged = frameOf(blk->data);
+    if (staged >= 0) {
+        assert(owners[staged] == blk);
+        owners[staged] = nullptr;
+        referenced[staged] = false;
+    } else if (blk->data != nullptr) {
+        freeBlob(blk->data);
+    }
+    blk->data = nullptr;
+}
+
+void
+CompressedBlockStore::move(CacheBlk *src, CacheBlk *dest)
+{
+    release(dest);
+    const int staged = frameOf(src->data);
+    if (staged >= 0) {
+        owners[staged] = dest;
+    }
+    dest->data = src->data;
+    src->data = nullptr;
+}
+
+uint8_t *
+CompressedBlockStore::encode(const uint8_t *data)
+{
+    const std::size_t size = codec.encode(data, scratch.data());
+    if (size == 0) {
+        return nullptr;
+    }
+    uint8_t *blob =
+        allocateBlob(CompressedBlockCodec::sizeClass(scratch.data()));
+    std::memcpy(blob, scratch.data(), size);
+    return blob;
+}
+
+uint8_t *
+CompressedBlockStore::allocateBlob(unsigned size_class)
+{
+    assert(size_class < sizeClasses.size());
+    SizeClass &sc = sizeClasses[size_class];
+    const std::size_t size = (size_class + 1) * 8;
+    blobBytes += size;
+    numBlobs++;
+
+    if (!sc.freeBlobs.empty()) {
+        uint8_t *blob = sc.freeBlobs.back();
+        sc.freeBlobs.pop_back();
+        return blob;
+    }
+    if (sc.next == nullptr || sc.next + size > sc.end) {
+        slabs.emplace_back(new uint8_t[slabSize]);
+        sc.next = slabs.back().get();
+        sc.end = sc.next + slabSize;
+    }
+    uint8_t *blob = sc.next;
+    sc.next += size;
+    return blob;
+}
+
+void
+CompressedBlockStore::freeBlob(uint8_t *blob)
+{
+    const unsigned size_class = CompressedBlockCodec::sizeClass(blob);
+    assert(size_class < sizeClasses.size());
+    assert(blobBytes >= (size_class + 1) * 8 && numBlobs > 0);
+    blobBytes -= (size_class + 1) * 8;
+    numBlobs--;
+    sizeClasses[size_class].freeBlobs.push_back(blob);
+}
+
+CompressedBlockStore::StoreStats::StoreStats(statistics::Group *parent,
+    CompressedBlockStore &_store)
+  : statistics::Group(parent, "hostStore"), store(_store),
+    ADD_STAT(decompressions, statistics::units::Count::get(),
+        "Number of blocks decompressed into a staging frame"),
+    ADD_STAT(compressions, statistics::units::Count::get(),
+        "Number of blocks compressed back from a staging frame"),
+    ADD_STAT(compressedBlocks, statistics::units::Count::get(),
+        "Number of non-zero blocks held compressed"),
+    ADD_STAT(compressedBytes, statistics::units::Byte::get(),
+        "Host memory taken by the compressed blocks"),
+    ADD_STAT(hostBytes, statistics::units::Byte::get(),
+        "Host memory taken by the block data, including slack"),
+    ADD_STAT(hostBytesSaved, statistics::units::Byte::get(),
+        "Host memory saved over storing the block data uncompressed")
+{
+}
+
+void
+CompressedBlockStore::StoreStats::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    compressedBlocks = store.numBlobs;
+    compressedBytes = store.blobBytes;
+    const double host_bytes = double(store.slabs.size()) * slabSize +
+        double(store.numFrames) * store.blkSize;
+    hostBytes = host_bytes;
+    hostBytesSaved = double(store.numBlocks) * store.blkSize - host_bytes;
+}
+
+} // namespace gem5
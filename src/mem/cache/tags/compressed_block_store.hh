@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declares a host-memory store that keeps the data of cache blocks
+ * compressed, for caches too large to hold all their data uncompressed in
+ * the simulator's memory.
+ */
+
+#ifndef __MEM_CACHE_TAGS_COMPRESSED_BLOCK_STORE_HH__
+#define __MEM_CACHE_TAGS_COMPRESSED_BLOCK_STORE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "mem/cache/tags/compressed_block_codec.hh"
+
+namespace gem5
+{
+
+class CacheBlk;
+
+/**
+ * Holds the data of cache blocks compressed in host memory. The data of a
+ * block is decompressed into one of a few staging frames when it is
+ * accessed, and compressed back when the frame is reclaimed, in clock
+ * order, for another block.
+ *
+ * The data pointer of each block tells where its data is: in a staging
+ * frame, in a compressed blob, or nowhere, when the block is all zeros.
+ * A pointer returned by access() thus only remains valid until as many
+ * other blocks as there are frames have been accessed.
+ *
+ * Blobs are encoded by a CompressedBlockCodec, and allocated from slabs,
+ * in size classes of 8 bytes.
+ */
+class CompressedBlockStore
+{
+  public:
+    /**
+     * @param parent The statistics group the store reports to.
+     * @param blk_size The size of a block, in bytes.
+     * @param num_frames The number of blocks staged decompressed.
+     * @param num_blocks The number of blocks in the cache, used to report
+     *        the host memory saved.
+     */
+    CompressedBlockStore(statistics::Group *parent, unsigned blk_size,
+                         unsigned num_frames, std::size_t num_blocks);
+
+    /**
+     * Stages the data of a block, decompressing it if needed.
+     * @param blk The block.
+     * @return The decompressed, writable, data of the block.
+     */
+    uint8_t *access(CacheBlk *blk);
+
+    /**
+     * Drops the data of a block being invalidated.
+     * @param blk The block.
+     */
+    void release(CacheBlk *blk);
+
+    /**
+     * Hands the data of a block over to another one, whose own data is
+     * dropped.
+     * @param src The block the data is taken from.
+     * @param dest The block the data is given to.
+     */
+    void move(CacheBlk *src, CacheBlk *dest);
+
+  private:
+    /** Size of the slabs blobs are allocated from, in bytes. */
+    static constexpr std::size_t slabSize = 64 * 1024;
+
+    /** Blobs of the same size class. */
+    struct SizeClass
+    {
+        /** Blobs freed, to be reused before the slab is carved further. */
+        std::vector<uint8_t *> freeBlobs;
+        /** Next blob of the current slab. */
+        uint8_t *next = nullptr;
+        /** End of the current slab. */
+        uint8_t *end = nullptr;
+    };
+
+    /** @return The frame the data pointer is in, or -1 if none. */
+    int frameOf(const uint8_t *data) const;
+
+    /** @return The data of a frame. */
+    uint8_t *frameData(unsigned frame) const
+    {
+        return frames.get() + frame * blkSize;
+    }
+
+    /** @return A frame to stage a block into, after emptying it. */
+    unsigned reclaimFrame();
+
+    /**
+     * Compresses data into a new blob.
+     * @return The blob, or nullptr if the data is all zeros.
+     */
+    uint8_t *encode(const uint8_t *data);
+
+    uint8_t *allocateBlob(unsigned size_class);
+    void freeBlob(uint8_t *blob);
+
+    const CompressedBlockCodec codec;
+    const unsigned blkSize;
+    const unsigned numFrames;
+    const std::size_t numBlocks;
+
+    /** The staging frames. */
+    std::unique_ptr<uint8_t[]> frames;
+    /** The block staged in each frame, if any. */
+    std::vector<CacheBlk *> owners;
+    /** Whether each frame was accessed since the clock hand went by. */
+    std::vector<bool> referenced;
+    /** The clock hand. */
+    unsigned hand;
+
+    std::vector<SizeClass> sizeClasses;
+    std::vector<std::unique_ptr<uint8_t[]>> slabs;
+
+    /** Bytes taken by live blobs. */
+    std::size_t blobBytes;
+    /** Number of live blobs. */
+    std::size_t numBlobs;
+
+    /** Scratch space for encoding a blob before its size is known. */
+    std::vector<uint8_t> scratch;
+
+    struct StoreStats : public statistics::Group
+    {
+        StoreStats(statistics::Group *parent, CompressedBlockStore &store);
+
+        void preDumpStats() override;
+
+        CompressedBlockStore &store;
+
+        /** Number of blocks decompressed into a frame. */
+        statistics::Scalar decompressions;
+        /** Number of blocks compressed back from a frame. */
+        statistics::Scalar compressions;
+        /** Number of blocks held compressed. */
+        statistics::Scalar compressedBlocks;
+        /** Bytes taken by the compressed blocks. */
+        statistics::Scalar compressedBytes;
+        /** Host memory taken by the slabs and frames. */
+        statistics::Scalar hostBytes;
+        /** Host memory saved over storing every block uncompressed. */
+        statistics::Scalar hostBytesSaved;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_COMPRESSED_BLOCK_STORE_HH__
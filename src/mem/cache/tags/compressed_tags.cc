@@ -81,7 +81,7 @@ CompressedTags::tagsInit()
             blk = &blks[blk_index];
 
             // Associate a data chunk to the block
-            blk->data = &dataBlks[blkSize*blk_index];
+            blk->data = dataChunk(blk_index);
 
             // Associate superblock to this block
             blk->setSectorBlock(superblock);
@@ -98,6 +98,11 @@ CompressedTags::tagsInit()
 
         // Link block to indexing policy
         indexingPolicy->setEntry(superblock, superblock_index);
+
+        // Mirror its tag into the tag array
+        if (setAssocIndexing) {
+            tagArray.bind(*superblock, superblock_index);
+        }
     }
 }
 
@@ -90,7 +90,7 @@ FALRU::tagsInit()
     head->prev = nullptr;
     head->next = &(blks[1]);
     head->setPosition(0, 0);
-    head->data = &dataBlks[0];
+    head->data = dataChunk(0);
 
     for (unsigned i = 1; i < numBlocks - 1; i++) {
         blks[i].prev = &(blks[i-1]);
@@ -98,14 +98,14 @@ FALRU::tagsInit()
         blks[i].setPosition(0, i);
 
         // Associate a data chunk to the block
-        blks[i].data = &dataBlks[blkSize*i];
+        blks[i].data = dataChunk(i);
     }
 
     tail = &(blks[numBlocks - 1]);
     tail->prev = &(blks[numBlocks - 2]);
     tail->next = nullptr;
     tail->setPosition(0, numBlocks - 1);
-    tail->data = &dataBlks[(numBlocks - 1) * blkSize];
+    tail->data = dataChunk(numBlocks - 1);
 
     cacheTracking.init(head, tail);
 }
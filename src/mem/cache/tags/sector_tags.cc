@@ -55,7 +55,9 @@ SectorTags::SectorTags(const SectorTagsParams &p)
       numBlocksPerSector(p.num_blocks_per_sector),
       numSectors(numBlocks / numBlocksPerSector),
       sectorShift(floorLog2(blkSize)), sectorMask(numBlocksPerSector - 1),
-      sectorStats(stats, *this)
+      sectorStats(stats, *this),
+      setAssocIndexing(dynamic_cast<SetAssociative *>(p.indexing_policy)),
+      tagArray(setAssocIndexing ? numSectors : 0, p.assoc)
 {
     // There must be a indexing policy
     fatal_if(!p.indexing_policy, "An indexing policy is required");
@@ -95,7 +97,7 @@ SectorTags::tagsInit()
             blk = &blks[blk_index];
 
             // Associate a data chunk to the block
-            blk->data = &dataBlks[blkSize*blk_index];
+            blk->data = dataChunk(blk_index);
 
             // Associate sector block to this block
             blk->setSectorBlock(sec_blk);
@@ -112,6 +114,11 @@ SectorTags::tagsInit()
 
         // Link block to indexing policy
         indexingPolicy->setEntry(sec_blk, sec_blk_index);
+
+        // Mirror its tag into the tag array
+        if (setAssocIndexing) {
+            tagArray.bind(*sec_blk, sec_blk_index);
+        }
     }
 }
 
@@ -256,6 +263,23 @@ SectorTags::findBlock(Addr addr, bool is_secure) const
     // due to sectors being composed of contiguous-address entries
     const Addr offset = extractSectorOffset(addr);
 
+    // Only visit the sectors whose tag matches. There may be more than one
+    // when sectors can be co-allocated, as in compressed caches.
+    if (setAssocIndexing) {
+        const uint32_t set = setAssocIndexing->extractSet(addr);
+        const uint64_t key = TaggedEntry::lookupKey(tag, is_secure);
+        for (int way = tagArray.findWay(set, key); way >= 0;
+             way = tagArray.findWay(set, key, way + 1)) {
+            auto blk = static_cast<SectorBlk*>(
+                indexingPolicy->getEntry(set, way))->blks[offset];
+            if (blk->matchTag(tag, is_secure)) {
+                return blk;
+            }
+        }
+
+        return nullptr;
+    }
+
     // Find all possible sector entries that may contain the given address
     const std::vector<ReplaceableEntry*> entries =
         indexingPolicy->getPossibleEntries(addr);
@@ -40,7 +40,9 @@
 
 #include "base/statistics.hh"
 #include "mem/cache/tags/base.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
 #include "mem/cache/tags/sector_blk.hh"
+#include "mem/cache/tags/tag_array.hh"
 #include "mem/packet.hh"
 #include "params/SectorTags.hh"
 
@@ -106,6 +108,15 @@ class SectorTags : public BaseTags
         statistics::Vector evictionsReplacement;
     } sectorStats;
 
+    /** The indexing policy, if it is a plain set associative one. */
+    SetAssociative *const setAssocIndexing;
+
+    /**
+     * Contiguous copy of the sector tags, kept and searched only with set
+     * associative indexing.
+     */
+    TagArray tagArray;
+
   public:
     /** Convenience typedef. */
      typedef SectorTagsParams Params;
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_TAGS_TAG_ARRAY_HH__
+#define __MEM_CACHE_TAGS_TAG_ARRAY_HH__
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "mem/cache/tags/tagged_entry.hh"
+
+namespace gem5
+{
+
+/**
+ * A structure-of-arrays copy of the tag, valid and secure bits of a set
+ * associative tag store, laid out set by set in entry index order.  Each
+ * entry is folded into a single 64-bit lookup key (see
+ * TaggedEntry::lookupKey()) which the TaggedEntry keeps up to date once it
+ * has been bound to its slot, so a lookup compares a contiguous row of
+ * keys instead of chasing a pointer per way.
+ */
+class TagArray
+{
+  public:
+    /**
+     * @param num_entries Number of entries in the tag store.
+     * @param assoc Number of ways per set.
+     */
+    TagArray(std::size_t num_entries, unsigned assoc)
+        : assoc(assoc), keys(num_entries, TaggedEntry::InvalidLookupKey)
+    {}
+
+    /** Binds an entry to its slot, given the entry's index. */
+    void
+    bind(TaggedEntry &entry, std::size_t index)
+    {
+        entry.bindLookupKey(&keys[index]);
+    }
+
+    /**
+     * Finds the way of a set holding the given key.
+     *
+     * @param set The set to search.
+     * @param key The key, as built by TaggedEntry::lookupKey().
+     * @param way The way to start searching from.
+     * @return The first matching way, or -1 on a miss.
+     */
+    int
+    findWay(uint32_t set, uint64_t key, unsigned way = 0) const
+    {
+        const uint64_t *row = &keys[std::size_t(set) * assoc];
+#if defined(__AVX2__)
+        const __m256i needle = _mm256_set1_epi64x(key);
+        for (; way + 4 <= assoc; way += 4) {
+            const __m256i ways = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(row + way));
+            const int hits = _mm256_movemask_pd(_mm256_castsi256_pd(
+                _mm256_cmpeq_epi64(ways, needle)));
+            if (hits)
+                return way + ctz32(hits);
+        }
+#elif defined(__SSE2__)
+        // SSE2 has no 64-bit compare, so AND each 32-bit half's result
+        // with its neighbour's.
+        const __m128i needle = _mm_set1_epi64x(key);
+        for (; way + 2 <= assoc; way += 2) {
+            const __m128i ways = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(row + way));
+            __m128i eq = _mm_cmpeq_epi32(ways, needle);
+            eq = _mm_and_si128(eq,
+                _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+            const int hits = _mm_movemask_pd(_mm_castsi128_pd(eq));
+            if (hits)
+                return way + ctz32(hits);
+        }
+#endif
+        for (; way < assoc; ++way) {
+            if (row[way] == key)
+                return way;
+        }
+        return -1;
+    }
+
+  private:
+    /** Number of ways per set. */
+    const unsigned assoc;
+
+    /** The lookup keys, indexed by entry index. */
+    std::vector<uint64_t> keys;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_TAG_ARRAY_HH__
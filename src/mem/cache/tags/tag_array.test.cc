@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "mem/cache/tags/tag_array.hh"
+#include "mem/cache/tags/tagged_entry.hh"
+
+using namespace gem5;
+
+/** Bound entries keep their slot in sync with insertions and
+ * invalidations. */
+TEST(TagArrayTest, MirrorsEntries)
+{
+    const unsigned assoc = 4;
+    std::vector<TaggedEntry> entries(2 * assoc);
+    TagArray tag_array(entries.size(), assoc);
+    for (unsigned i = 0; i < entries.size(); i++) {
+        tag_array.bind(entries[i], i);
+    }
+
+    const uint64_t key = TaggedEntry::lookupKey(0x42, false);
+    ASSERT_EQ(tag_array.findWay(1, key), -1);
+
+    entries[assoc + 2].insert(0x42, false);
+    ASSERT_EQ(tag_array.findWay(1, key), 2);
+    ASSERT_EQ(tag_array.findWay(0, key), -1);
+
+    // The secure bit is part of the match
+    ASSERT_EQ(tag_array.findWay(1, TaggedEntry::lookupKey(0x42, true)), -1);
+
+    entries[assoc + 2].invalidate();
+    ASSERT_EQ(tag_array.findWay(1, key), -1);
+}
+
+/** Every way is found, whatever the associativity and starting way, and
+ * the first match from the starting way wins. */
+TEST(TagArrayTest, FindWay)
+{
+    for (unsigned assoc = 1; assoc <= 17; assoc++) {
+        std::vector<TaggedEntry> entries(assoc);
+        TagArray tag_array(assoc, assoc);
+        for (unsigned way = 0; way < assoc; way++) {
+            tag_array.bind(entries[way], way);
+            entries[way].insert(way / 2, way % 2);
+        }
+
+        for (unsigned way = 0; way < assoc; way++) {
+            const uint64_t key = TaggedEntry::lookupKey(way / 2, way % 2);
+            ASSERT_EQ(tag_array.findWay(0, key), way);
+            ASSERT_EQ(tag_array.findWay(0, key, way), way);
+            ASSERT_EQ(tag_array.findWay(0, key, way + 1), -1);
+        }
+        ASSERT_EQ(tag_array.findWay(0, TaggedEntry::lookupKey(assoc, 0)), -1);
+    }
+}
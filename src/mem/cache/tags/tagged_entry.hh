@@ -30,6 +30,7 @@
 #define __CACHE_TAGGED_ENTRY_HH__
 
 #include <cassert>
+#include <cstdint>
 
 #include "base/cprintf.hh"
 #include "base/types.hh"
@@ -46,9 +47,40 @@ namespace gem5
 class TaggedEntry : public ReplaceableEntry
 {
   public:
+    /** Lookup key of an invalid entry; never built by lookupKey(). */
+    static constexpr uint64_t InvalidLookupKey = ~uint64_t(0);
+
     TaggedEntry() : _valid(false), _secure(false), _tag(MaxAddr) {}
     ~TaggedEntry() = default;
 
+    /**
+     * Folds tag information into a single word, so that a valid entry
+     * matches a lookup exactly when their keys are equal.  Tags are
+     * shifted addresses, so the top bit is free for the secure bit.
+     *
+     * @param tag The tag value.
+     * @param is_secure Whether secure bit is set.
+     * @return The lookup key.
+     */
+    static uint64_t
+    lookupKey(Addr tag, bool is_secure)
+    {
+        return (tag << 1) | is_secure;
+    }
+
+    /**
+     * Mirrors this entry's tag information into an external lookup key,
+     * e.g. a slot of a TagArray, from now on.
+     *
+     * @param key The key to keep up to date.
+     */
+    void
+    bindLookupKey(uint64_t *key)
+    {
+        _lookupKey = key;
+        updateLookupKey();
+    }
+
     /**
      * Checks if the entry is valid.
      *
@@ -105,6 +137,7 @@ class TaggedEntry : public ReplaceableEntry
         _valid = false;
         setTag(MaxAddr);
         clearSecure();
+        updateLookupKey();
     }
 
     std::string
@@ -120,10 +153,20 @@ class TaggedEntry : public ReplaceableEntry
      *
      * @param tag The tag value.
      */
-    virtual void setTag(Addr tag) { _tag = tag; }
+    virtual void
+    setTag(Addr tag)
+    {
+        _tag = tag;
+        updateLookupKey();
+    }
 
     /** Set secure bit. */
-    virtual void setSecure() { _secure = true; }
+    virtual void
+    setSecure()
+    {
+        _secure = true;
+        updateLookupKey();
+    }
 
     /** Set valid bit. The block must be invalid beforehand. */
     virtual void
@@ -131,6 +174,7 @@ class TaggedEntry : public ReplaceableEntry
     {
         assert(!isValid());
         _valid = true;
+        updateLookupKey();
     }
 
   private:
@@ -150,8 +194,21 @@ class TaggedEntry : public ReplaceableEntry
     /** The entry's tag. */
     Addr _tag;
 
+    /** External copy of this entry's lookup key, if any. */
+    uint64_t *_lookupKey = nullptr;
+
     /** Clear secure bit. Should be only used by the invalidation function. */
     void clearSecure() { _secure = false; }
+
+    /** Refreshes the external lookup key after a tag information change. */
+    void
+    updateLookupKey()
+    {
+        if (_lookupKey) {
+            *_lookupKey = _valid ? lookupKey(_tag, _secure) :
+                InvalidLookupKey;
+        }
+    }
 };
 
 } // namespace gem5
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/channel_map.hh"
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+ChannelMap::ChannelMap(const std::string &name, const AddrRange &range,
+                       unsigned channels, Addr granularity,
+                       std::vector<unsigned> pattern,
+                       const std::vector<Addr> &hash_masks)
+  : range(range), channels(channels), granuleShift(floorLog2(granularity)),
+    granuleMask(granularity - 1), hashMasks(hash_masks)
+{
+    fatal_if(range.interleaved(),
+             "%s: The range of a channel mapper cannot be interleaved.",
+             name);
+    fatal_if(channels == 0 || channels > UINT16_MAX,
+             "%s: A channel mapper needs between 1 and %d channels.",
+             name, UINT16_MAX);
+    fatal_if(!isPowerOf2(granularity),
+             "%s: The granularity must be a power of two.", name);
+    fatal_if(hashMasks.size() > 32,
+             "%s: The hash has at most 32 bits.", name);
+
+    // Round robin over the channels, unless given a pattern
+    if (pattern.empty()) {
+        for (unsigned c = 0; c < channels; ++c)
+            pattern.push_back(c);
+    }
+
+    periodGranules = pattern.size();
+    fatal_if(periodGranules % channels != 0,
+             "%s: The pattern must map as many granules to every channel.",
+             name);
+    channelGranules = periodGranules / channels;
+
+    const Addr period_size = Addr(periodGranules) << granuleShift;
+    fatal_if(range.size() % period_size != 0,
+             "%s: The range must be made of whole periods of %d bytes.",
+             name, period_size);
+
+    // Rank the positions of every channel in the order of the addresses
+    std::vector<unsigned> ranks(channels, 0);
+    rankTable.resize(periodGranules);
+    for (unsigned pos = 0; pos < periodGranules; ++pos) {
+        fatal_if(pattern[pos] >= channels,
+                 "%s: The pattern maps a granule to channel %d of %d.",
+                 name, pattern[pos], channels);
+        rankTable[pos] = ranks[pattern[pos]]++;
+    }
+    for (unsigned c = 0; c < channels; ++c) {
+        fatal_if(ranks[c] != channelGranules,
+                 "%s: The pattern must map as many granules to every "
+                 "channel.", name);
+    }
+
+    // Permute the channels of the pattern for each hash
+    const bool xor_hash = isPowerOf2(channels);
+    channelTable.resize(channels * periodGranules);
+    positionTable.resize(channels * periodGranules);
+    for (unsigned h = 0; h < channels; ++h) {
+        for (unsigned pos = 0; pos < periodGranules; ++pos) {
+            const unsigned c = xor_hash ? pattern[pos] ^ h :
+                                          (pattern[pos] + h) % channels;
+            channelTable[h * periodGranules + pos] = c;
+            positionTable[(h * channels + c) * channelGranules +
+                          rankTable[pos]] = pos;
+        }
+    }
+}
+
+Addr
+ChannelMap::address(unsigned channel, Addr offset) const
+{
+    assert(channel < channels && offset < channelSize());
+    const Addr local = offset >> granuleShift;
+    const Addr period = local / channelGranules;
+    const unsigned rank = local - period * channelGranules;
+    const unsigned pos = positionTable[
+        (rotation(period) * channels + channel) * channelGranules + rank];
+    const Addr granule = period * periodGranules + pos;
+    return range.start() + ((granule << granuleShift) |
+                            (offset & granuleMask));
+}
+
+} // namespace memory
+} // namespace gem5
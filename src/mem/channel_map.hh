@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declares a channel map, which spreads an address range across any
+ * number of memory channels.
+ */
+
+#ifndef __MEM_CHANNEL_MAP_HH__
+#define __MEM_CHANNEL_MAP_HH__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/bitfield.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * A channel map splits an address range into granules, and maps the
+ * granules of each period of the range to the channels as set by a
+ * pattern, which gives every channel the same number of granules. The
+ * channels of each period are then permuted by a hash of the period
+ * index, XOR-ed into the channel for a power-of-two number of channels
+ * and added to it modulo their number otherwise, so that any number of
+ * channels can be hashed.
+ *
+ * As the hash is constant over a period, the granules of a channel are
+ * packed in the order of their addresses, and the offset of an address
+ * in its channel follows from its period and its position in the period
+ * alone. Both the channel and the rank of every position are kept in
+ * tables, so that decoding an address takes a division, a parity per bit
+ * of the hash and a lookup, whatever the number of channels.
+ *
+ * With a granularity of a page, the position of a page in its period is
+ * its color, which the pattern maps to a channel.
+ */
+class ChannelMap
+{
+  public:
+    /**
+     * @param name Name of the owner, for the error messages
+     * @param range Range spread across the channels
+     * @param channels Number of channels
+     * @param granularity Bytes mapped to a channel at a time
+     * @param pattern Channel of each granule of a period, round robin if
+     *                empty
+     * @param hash_masks Masks of the period index folded into each bit of
+     *                   the hash
+     */
+    ChannelMap(const std::string &name, const AddrRange &range,
+               unsigned channels, Addr granularity,
+               std::vector<unsigned> pattern,
+               const std::vector<Addr> &hash_masks);
+
+    /** @return The range spread across the channels. */
+    const AddrRange &getAddrRange() const { return range; }
+
+    /** @return The number of channels. */
+    unsigned numChannels() const { return channels; }
+
+    /** @return The bytes mapped to a channel at a time. */
+    Addr granularity() const { return Addr(1) << granuleShift; }
+
+    /** @return The bytes of the range mapped to each channel. */
+    Addr channelSize() const { return range.size() / channels; }
+
+    /**
+     * @param addr An address of the range.
+     * @return The channel of the address.
+     */
+    unsigned
+    channel(Addr addr) const
+    {
+        const Addr granule = (addr - range.start()) >> granuleShift;
+        const Addr period = granule / periodGranules;
+        const unsigned pos = granule - period * periodGranules;
+        return channelTable[rotation(period) * periodGranules + pos];
+    }
+
+    /**
+     * @param addr An address of the range.
+     * @return The offset of the address in its channel.
+     */
+    Addr
+    channelOffset(Addr addr) const
+    {
+        const Addr offset = addr - range.start();
+        const Addr granule = offset >> granuleShift;
+        const Addr period = granule / periodGranules;
+        const unsigned pos = granule - period * periodGranules;
+        const Addr local = period * channelGranules + rankTable[pos];
+        return (local << granuleShift) | (offset & granuleMask);
+    }
+
+    /**
+     * The inverse of channel() and channelOffset().
+     *
+     * @param channel A channel.
+     * @param offset An offset in the channel.
+     * @return The address mapped to that offset of the channel.
+     */
+    Addr address(unsigned channel, Addr offset) const;
+
+  private:
+    /** @return The hash of a period, reduced to a channel permutation. */
+    unsigned
+    rotation(Addr period) const
+    {
+        unsigned hash = 0;
+        for (unsigned i = 0; i < hashMasks.size(); ++i)
+            hash |= (popCount(period & hashMasks[i]) & 1) << i;
+        return hash % channels;
+    }
+
+    const AddrRange range;
+    const unsigned channels;
+    const unsigned granuleShift;
+    const Addr granuleMask;
+
+    /** Masks of the period index folded into each bit of the hash. */
+    const std::vector<Addr> hashMasks;
+
+    /** Granules of a period, and of a channel in a period. */
+    unsigned periodGranules;
+    unsigned channelGranules;
+
+    /** Channel of each position of a period, for each rotation. */
+    std::vector<uint16_t> channelTable;
+    /** Rank of each position among those of its channel in a period. */
+    std::vector<unsigned> rankTable;
+    /** Position of each rank of each channel, for each rotation. */
+    std::vector<unsigned> positionTable;
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_CHANNEL_MAP_HH__
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "mem/channel_map.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+const Addr granularity = 256;
+const unsigned numPeriods = 64;
+
+/**
+ * Check that every granule of a map decodes to a channel and an offset
+ * that address() maps back to it, and that the granules of each channel
+ * fill its offsets exactly once.
+ */
+void
+expectRoundTrips(const ChannelMap &map)
+{
+    const AddrRange &range = map.getAddrRange();
+    const unsigned channels = map.numChannels();
+    ASSERT_EQ(map.channelSize() * channels, range.size());
+
+    std::vector<std::set<Addr>> offsets(channels);
+    for (Addr addr = range.start(); addr < range.end();
+         addr += granularity) {
+        // The last byte of the granule, to cover the offset in it too
+        const Addr last = addr + granularity - 1;
+        const unsigned channel = map.channel(last);
+        ASSERT_LT(channel, channels) << std::hex << last;
+        ASSERT_EQ(map.channel(addr), channel) << std::hex << addr;
+
+        const Addr offset = map.channelOffset(last);
+        ASSERT_LT(offset, map.channelSize()) << std::hex << last;
+        ASSERT_EQ(offset % granularity, granularity - 1);
+        ASSERT_EQ(map.channelOffset(addr), offset - (granularity - 1));
+        ASSERT_EQ(map.address(channel, offset), last) << std::hex << last;
+        ASSERT_TRUE(offsets[channel].insert(offset).second)
+            << std::hex << last;
+    }
+    for (const auto &channel_offsets : offsets)
+        ASSERT_EQ(channel_offsets.size(), map.channelSize() / granularity);
+}
+
+/** @return A map of a range of whole periods at a non-zero start. */
+ChannelMap
+makeMap(unsigned channels, const std::vector<unsigned> &pattern = {},
+        const std::vector<Addr> &hash_masks = {})
+{
+    const Addr period_size =
+        (pattern.empty() ? channels : pattern.size()) * granularity;
+    const Addr start = 0x80000000;
+    return ChannelMap("map", AddrRange(start, start + numPeriods *
+                                       period_size),
+                      channels, granularity, pattern, hash_masks);
+}
+
+} // anonymous namespace
+
+/** Round robin maps of a few channel counts. */
+TEST(ChannelMapTest, RoundRobin)
+{
+    for (unsigned channels : {1, 2, 3, 6, 12}) {
+        SCOPED_TRACE(channels);
+        const ChannelMap map = makeMap(channels);
+        expectRoundTrips(map);
+
+        // The granules go round robin over the channels, packed in order
+        const Addr start = map.getAddrRange().start();
+        for (unsigned g = 0; g < 2 * channels; ++g) {
+            ASSERT_EQ(map.channel(start + g * granularity), g % channels);
+            ASSERT_EQ(map.channelOffset(start + g * granularity),
+                      g / channels * granularity);
+        }
+    }
+}
+
+/** The hash permutes the channels of the periods, for power-of-two
+ * channel counts and others alike. */
+TEST(ChannelMapTest, Hashed)
+{
+    const std::vector<Addr> hash_masks = {0x15, 0x2a, 0x33, 0x0f};
+    for (unsigned channels : {3, 4, 6, 12}) {
+        SCOPED_TRACE(channels);
+        const ChannelMap map = makeMap(channels, {}, hash_masks);
+        expectRoundTrips(map);
+
+        // The first granule of some period is not on channel 0
+        const Addr period_size = channels * granularity;
+        const Addr start = map.getAddrRange().start();
+        bool permuted = false;
+        for (unsigned p = 0; p < numPeriods; ++p)
+            permuted |= map.channel(start + p * period_size) != 0;
+        ASSERT_TRUE(permuted);
+    }
+}
+
+/** A custom pattern, with two colors for each of 6 channels. */
+TEST(ChannelMapTest, Pattern)
+{
+    const std::vector<unsigned> pattern =
+        {0, 1, 2, 3, 4, 5, 5, 4, 3, 2, 1, 0};
+    for (const auto &hash_masks :
+             {std::vector<Addr>{}, std::vector<Addr>{0x5, 0xa, 0x30}}) {
+        SCOPED_TRACE(hash_masks.size());
+        const ChannelMap map = makeMap(6, pattern, hash_masks);
+        expectRoundTrips(map);
+    }
+
+    // Without a hash, the pattern sets the channel of every position
+    const ChannelMap map = makeMap(6, pattern);
+    const Addr start = map.getAddrRange().start();
+    for (unsigned pos = 0; pos < pattern.size(); ++pos)
+        ASSERT_EQ(map.channel(start + pos * granularity), pattern[pos]);
+
+    // Patterns of 3 and 12 channels, with uneven runs of a channel
+    expectRoundTrips(makeMap(3, {0, 0, 1, 2, 2, 1}, {0x3}));
+    std::vector<unsigned> twelve;
+    for (unsigned c = 0; c < 12; ++c)
+        twelve.insert(twelve.begin() + (c * 7) % (twelve.size() + 1), c);
+    expectRoundTrips(makeMap(12, twelve));
+    expectRoundTrips(makeMap(12, twelve, {0x9, 0x12, 0x24, 0x3}));
+}
@@ -56,7 +56,8 @@ namespace gem5
 {
 
 CoherentXBar::CoherentXBar(const CoherentXBarParams &p)
-    : BaseXBar(p), system(p.system), snoopFilter(p.snoop_filter),
+    : BaseXBar(p), snoopTag(newRouteTag()), numOutstandingSnoops(0),
+      system(p.system), snoopFilter(p.snoop_filter),
       snoopResponseLatency(p.snoop_response_latency),
       maxOutstandingSnoopCheck(p.max_outstanding_snoops),
       maxRoutingTableSizeCheck(p.max_routing_table_size),
@@ -305,6 +306,9 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     if (snoopFilter && snoop_caches) {
         // Let the snoop filter know about the success of the send operation
         snoopFilter->finishRequest(!success, addr, pkt->isSecure());
+
+        if (snoopFilter->hasEvictions())
+            backInvalidate(true);
     }
 
     // check if we were successful in sending the packet onwards
@@ -328,22 +332,20 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
             // response
             if (expect_snoop_resp) {
                 // we should never have an exsiting request outstanding
-                assert(outstandingSnoop.find(pkt->req) ==
-                       outstandingSnoop.end());
-                outstandingSnoop.insert(pkt->req);
+                pkt->req->setRoute(snoopTag, cpu_side_port_id);
+                ++numOutstandingSnoops;
 
                 // basic sanity check on the outstanding snoops
-                panic_if(outstandingSnoop.size() > maxOutstandingSnoopCheck,
+                panic_if(numOutstandingSnoops > maxOutstandingSnoopCheck,
                          "%s: Outstanding snoop requests exceeded %d\n",
                          name(), maxOutstandingSnoopCheck);
             }
 
             // remember where to route the normal response to
             if (expect_response || expect_snoop_resp) {
-                assert(routeTo.find(pkt->req) == routeTo.end());
-                routeTo[pkt->req] = cpu_side_port_id;
+                setRoute(pkt->req, cpu_side_port_id);
 
-                panic_if(routeTo.size() > maxRoutingTableSizeCheck,
+                panic_if(numRoutes > maxRoutingTableSizeCheck,
                          "%s: Routing table exceeds %d packets\n",
                          name(), maxRoutingTableSizeCheck);
             }
@@ -395,23 +397,20 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
                 assert(rsp_pkt);
 
                 // determine the destination
-                const auto route_lookup = routeTo.find(rsp_pkt->req);
-                assert(route_lookup != routeTo.end());
-                rsp_port_id = route_lookup->second;
+                rsp_port_id = findRoute(rsp_pkt->req);
                 assert(rsp_port_id != InvalidPortID);
                 assert(rsp_port_id < respLayers.size());
                 // remove the request from the routing table
-                routeTo.erase(route_lookup);
+                clearRoute(rsp_pkt->req);
             }
             outstandingCMO.erase(cmo_lookup);
         } else {
             respond_directly = false;
             outstandingCMO.emplace(pkt->id, deferred_rsp);
             if (!pkt->isWrite()) {
-                assert(routeTo.find(pkt->req) == routeTo.end());
-                routeTo[pkt->req] = cpu_side_port_id;
+                setRoute(pkt->req, cpu_side_port_id);
 
-                panic_if(routeTo.size() > maxRoutingTableSizeCheck,
+                panic_if(numRoutes > maxRoutingTableSizeCheck,
                          "%s: Routing table exceeds %d packets\n",
                          name(), maxRoutingTableSizeCheck);
             }
@@ -450,9 +449,7 @@ CoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     RequestPort *src_port = memSidePorts[mem_side_port_id];
 
     // determine the destination
-    const auto route_lookup = routeTo.find(pkt->req);
-    assert(route_lookup != routeTo.end());
-    const PortID cpu_side_port_id = route_lookup->second;
+    const PortID cpu_side_port_id = findRoute(pkt->req);
     assert(cpu_side_port_id != InvalidPortID);
     assert(cpu_side_port_id < respLayers.size());
 
@@ -464,6 +461,10 @@ CoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
         return false;
     }
 
+    // remove the request from the routing table, while the response,
+    // and with it the request, is still ours
+    clearRoute(pkt->req);
+
     DPRINTF(CoherentXBar, "%s: src %s packet %s\n", __func__,
             src_port->name(), pkt->print());
 
@@ -493,9 +494,6 @@ CoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     cpuSidePorts[cpu_side_port_id]->schedTimingResp(pkt, curTick()
                                         + latency);
 
-    // remove the request from the routing table
-    routeTo.erase(route_lookup);
-
     respLayers[cpu_side_port_id]->succeededTiming(packetFinishTime);
 
     // stats updates
@@ -554,8 +552,7 @@ CoherentXBar::recvTimingSnoopReq(PacketPtr pkt, PortID mem_side_port_id)
 
     // if we can expect a response, remember how to route it
     if (!cache_responding && pkt->cacheResponding()) {
-        assert(routeTo.find(pkt->req) == routeTo.end());
-        routeTo[pkt->req] = mem_side_port_id;
+        setRoute(pkt->req, mem_side_port_id);
     }
 
     // a snoop request came from a connected CPU-side-port device (one of
@@ -573,17 +570,15 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
     ResponsePort* src_port = cpuSidePorts[cpu_side_port_id];
 
     // get the destination
-    const auto route_lookup = routeTo.find(pkt->req);
-    assert(route_lookup != routeTo.end());
-    const PortID dest_port_id = route_lookup->second;
+    const PortID dest_port_id = findRoute(pkt->req);
     assert(dest_port_id != InvalidPortID);
 
     // determine if the response is from a snoop request we
     // created as the result of a normal request (in which case it
-    // should be in the outstandingSnoop), or if we merely forwarded
+    // should be marked with the snoop tag), or if we merely forwarded
     // someone else's snoop request
-    const bool forwardAsSnoop = outstandingSnoop.find(pkt->req) ==
-        outstandingSnoop.end();
+    const bool forwardAsSnoop =
+        pkt->req->getRoute(snoopTag) == InvalidPortID;
 
     // test if the crossbar should be considered occupied for the
     // current port, note that the check is bypassed if the response
@@ -610,6 +605,17 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
     DPRINTF(CoherentXBar, "%s: src %s packet %s\n", __func__,
             src_port->name(), pkt->print());
 
+    // remove the request from the routing table, while the response,
+    // and with it the request, is still ours
+    clearRoute(pkt->req);
+    if (!forwardAsSnoop) {
+        // since we created the snoop request as part of recvTiming,
+        // this is no longer an outstanding snoop
+        pkt->req->clearRoute(snoopTag);
+        assert(numOutstandingSnoops > 0);
+        --numOutstandingSnoops;
+    }
+
     // store size and command as they might be modified when
     // forwarding the packet
     unsigned int pkt_size = pkt->hasData() ? pkt->getSize() : 0;
@@ -655,7 +661,6 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
         // i.e. from a coherent requestor connected to the crossbar, and
         // since we created the snoop request as part of recvTiming,
         // this should now be a normal response again
-        outstandingSnoop.erase(pkt->req);
 
         // this is a snoop response from a coherent requestor, hence it
         // should never go back to where the snoop response came from,
@@ -684,9 +689,6 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
         respLayers[dest_port_id]->succeededTiming(packetFinishTime);
     }
 
-    // remove the request from the routing table
-    routeTo.erase(route_lookup);
-
     // stats updates
     transDist[pkt_cmd]++;
     snoops++;
@@ -773,6 +775,9 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
             // between and change the filter state
             snoopFilter->finishRequest(false, pkt->getAddr(), pkt->isSecure());
 
+            if (snoopFilter->hasEvictions())
+                backInvalidate(false);
+
             if (pkt->isEviction()) {
                 // for block-evicting packets, i.e. writebacks and
                 // clean evictions, there is no need to snoop up, as
@@ -1076,6 +1081,35 @@ CoherentXBar::forwardFunctional(PacketPtr pkt, PortID exclude_cpu_side_port_id)
     }
 }
 
+void
+CoherentXBar::backInvalidate(bool is_timing)
+{
+    for (const auto &eviction : snoopFilter->takeEvictions()) {
+        Request::Flags flags = Request::CLEAN | Request::INVALIDATE;
+        if (eviction.isSecure)
+            flags.set(Request::SECURE);
+        RequestPtr req = Request::create(eviction.addr,
+            system->cacheLineSize(), flags, Request::wbRequestorId);
+
+        // the caches do not respond to a clean, be the dirty data in a
+        // block or already in their write buffer, only write it back,
+        // so the snoop can live on the stack
+        Packet pkt(req, MemCmd::CleanInvalidReq);
+        pkt.setExpressSnoop();
+
+        for (const auto& p : eviction.holders) {
+            DPRINTF(CoherentXBar, "%s: dst %s packet %s\n", __func__,
+                    p->name(), pkt.print());
+            if (is_timing)
+                p->sendTimingSnoopReq(&pkt);
+            else
+                p->sendAtomicSnoop(&pkt);
+            snoops++;
+        }
+        assert(!pkt.cacheResponding());
+    }
+}
+
 bool
 CoherentXBar::sinkPacket(const PacketPtr pkt) const
 {
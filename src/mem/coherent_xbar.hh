@@ -47,7 +47,6 @@
 #define __MEM_COHERENT_XBAR_HH__
 
 #include <unordered_map>
-#include <unordered_set>
 
 #include "mem/snoop_filter.hh"
 #include "mem/xbar.hh"
@@ -254,11 +253,15 @@ class CoherentXBar : public BaseXBar
     std::vector<QueuedResponsePort*> snoopPorts;
 
     /**
-     * Store the outstanding requests that we are expecting snoop
-     * responses from so we can determine which snoop responses we
-     * generated and which ones were merely forwarded.
+     * Mark the outstanding requests that we are expecting snoop
+     * responses from, by giving them a route under this tag, so we can
+     * determine which snoop responses we generated and which ones were
+     * merely forwarded.
      */
-    std::unordered_set<RequestPtr> outstandingSnoop;
+    const uint32_t snoopTag;
+
+    /** Number of requests marked as expecting snoop responses. */
+    unsigned numOutstandingSnoops;
 
     /**
      * Store the outstanding cache maintenance that we are expecting
@@ -388,6 +391,15 @@ class CoherentXBar : public BaseXBar
      */
     void forwardFunctional(PacketPtr pkt, PortID exclude_cpu_side_port_id);
 
+    /**
+     * Invalidate the lines evicted by the snoop filter in the caches
+     * holding them, which write back any dirty data on the way. The
+     * invalidations are express snoops, and no response is expected.
+     *
+     * @param is_timing Whether to send timing, rather than atomic, snoops
+     */
+    void backInvalidate(bool is_timing);
+
     /**
      * Determine if the crossbar should sink the packet, as opposed to
      * forwarding it, or responding.
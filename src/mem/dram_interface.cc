@@ -40,6 +40,8 @@
 
 #include "mem/dram_interface.hh"
 
+#include <algorithm>
+
 #include "base/bitfield.hh"
 #include "base/cprintf.hh"
 #include "base/trace.hh"
@@ -59,116 +61,110 @@ namespace memory
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
-    std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
-
-    // Has minBankPrep been called to populate earliest_banks?
-    bool filled_earliest_banks = false;
-    // can the PRE/ACT sequence be done without impacting utlization?
-    bool hidden_bank_prep = false;
+    // The candidates are found through the bank index of the queue,
+    // rather than by walking it, and the oldest of each kind is picked,
+    // which is the packet a walk of the queue in arrival order would
+    // settle on. Search for seamless row hits first, if no seamless row
+    // hit is found then determine if there are other packets that can be
+    // issued without incurring additional bus delay due to bank timing
+    const MemPacketQueue::Entry* seamless = nullptr;
+    Tick seamless_col_at = MaxTick;
+
+    // the oldest row hit, not seamless, but bank prepped and ready
+    const MemPacketQueue::Entry* prepped = nullptr;
+    Tick prepped_col_at = MaxTick;
+
+    // do we have packets to closed rows of available ranks?
+    bool got_misses = false;
+
+    for (uint8_t r = 0; r < ranksPerChannel; r++) {
+        // check if rank is not doing a refresh and thus is available,
+        // if not, skip all its packets
+        if (!ranks[r]->inRefIdleState()) {
+            DPRINTF(DRAM, "%s Rank %d not available\n", __func__, r);
+            continue;
+        }
 
-    // search for seamless row hits first, if no seamless row hit is
-    // found then determine if there are other packets that can be issued
-    // without incurring additional bus delay due to bank timing
-    // Will select closed rows first to enable more open row possibilies
-    // in future selections
-    bool found_hidden_bank = false;
+        for (uint8_t b = 0; b < banksPerRank; b++) {
+            const auto* pkts = queue.bank(pseudoChannel, r * banksPerRank + b);
+            if (!pkts)
+                continue;
+
+            const Bank& bank = ranks[r]->banks[b];
+            const auto* hit = MemPacketQueue::oldestTo(*pkts, bank.openRow);
+            got_misses |= !hit ||
+                MemPacketQueue::rowSize(*pkts, bank.openRow) < pkts->size;
+            if (!hit)
+                continue;
+
+            const Tick col_allowed_at = (*hit->second)->isRead() ?
+                bank.rdAllowedAt : bank.wrAllowedAt;
+
+            // no additional rank-to-rank or same bank-group delays, or we
+            // switched read/write and might as well go for the row hit
+            if (col_allowed_at <= min_col_at) {
+                if (!seamless || hit->first < seamless->first) {
+                    seamless = hit;
+                    seamless_col_at = col_allowed_at;
+                }
+            } else if (!prepped || hit->first < prepped->first) {
+                prepped = hit;
+                prepped_col_at = col_allowed_at;
+            }
+        }
+    }
 
-    // remember if we found a row hit, not seamless, but bank prepped
-    // and ready
-    bool found_prepped_pkt = false;
+    // FCFS within the hits, giving priority to commands that can issue
+    // seamlessly, without additional delay, such as same rank accesses
+    // and/or different bank-group accesses
+    if (seamless) {
+        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
+        return std::make_pair(seamless->second, seamless_col_at);
+    }
 
     // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
-
-    Tick selected_col_at = MaxTick;
-    auto selected_pkt_it = queue.end();
-
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        MemPacket* pkt = *i;
-
-        // select optimal DRAM packet in Q
-        if (pkt->isDram() && (pkt->pseudoChannel == pseudoChannel)) {
-            const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
-            const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
-                                                        bank.wrAllowedAt;
-
-            DPRINTF(DRAM, "%s checking DRAM packet in bank %d, row %d\n",
-                    __func__, pkt->bank, pkt->row);
-
-            // check if rank is not doing a refresh and thus is available,
-            // if not, jump to the next packet
-            if (burstReady(pkt)) {
-
-                DPRINTF(DRAM,
-                        "%s bank %d - Rank %d available\n", __func__,
-                        pkt->bank, pkt->rank);
-
-                // check if it is a row hit
-                if (bank.openRow == pkt->row) {
-                    // no additional rank-to-rank or same bank-group
-                    // delays, or we switched read/write and might as well
-                    // go for the row hit
-                    if (col_allowed_at <= min_col_at) {
-                        // FCFS within the hits, giving priority to
-                        // commands that can issue seamlessly, without
-                        // additional delay, such as same rank accesses
-                        // and/or different bank-group accesses
-                        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        // no need to look through the remaining queue entries
-                        break;
-                    } else if (!found_hidden_bank && !found_prepped_pkt) {
-                        // if we did not find a packet to a closed row that can
-                        // issue the bank commands without incurring delay, and
-                        // did not yet find a packet to a prepped row, remember
-                        // the current one
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        found_prepped_pkt = true;
-                        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
-                    }
-                } else if (!found_earliest_pkt) {
-                    // if we have not initialised the bank status, do it
-                    // now, and only once per scheduling decisions
-                    if (!filled_earliest_banks) {
-                        // determine entries with earliest bank delay
-                        std::tie(earliest_banks, hidden_bank_prep) =
-                            minBankPrep(queue, min_col_at);
-                        filled_earliest_banks = true;
-                    }
+    // just go for the earliest possible, selecting closed rows first
+    // to enable more open row possibilities in future selections
+    const MemPacketQueue::Entry* earliest = nullptr;
+    Tick earliest_col_at = MaxTick;
+    bool hidden_bank_prep = false;
+    if (got_misses) {
+        std::vector<uint32_t> earliest_banks;
+        std::tie(earliest_banks, hidden_bank_prep) =
+            minBankPrep(queue, min_col_at);
+
+        for (uint8_t r = 0; r < ranksPerChannel; r++) {
+            for (uint8_t b = 0; b < banksPerRank; b++) {
+                // bank is amongst first available banks, minBankPrep
+                // will give priority to packets that can issue seamlessly
+                if (!bits(earliest_banks[r], b, b))
+                    continue;
 
-                    // bank is amongst first available banks
-                    // minBankPrep will give priority to packets that can
-                    // issue seamlessly
-                    if (bits(earliest_banks[pkt->rank],
-                             pkt->bank, pkt->bank)) {
-                        found_earliest_pkt = true;
-                        found_hidden_bank = hidden_bank_prep;
-
-                        // give priority to packets that can issue
-                        // bank commands 'behind the scenes'
-                        // any additional delay if any will be due to
-                        // col-to-col command requirements
-                        if (hidden_bank_prep || !found_prepped_pkt) {
-                            selected_pkt_it = i;
-                            selected_col_at = col_allowed_at;
-                        }
-                    }
+                const Bank& bank = ranks[r]->banks[b];
+                const auto* miss = MemPacketQueue::oldestNotTo(
+                    *queue.bank(pseudoChannel, r * banksPerRank + b),
+                    bank.openRow);
+                if (miss && (!earliest || miss->first < earliest->first)) {
+                    earliest = miss;
+                    earliest_col_at = (*miss->second)->isRead() ?
+                        bank.rdAllowedAt : bank.wrAllowedAt;
                 }
-            } else {
-                DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
-                        pkt->bank, pkt->rank);
             }
         }
     }
 
-    if (selected_pkt_it == queue.end()) {
-        DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+    // give priority to packets that can issue bank commands 'behind the
+    // scenes', any additional delay if any will be due to col-to-col
+    // command requirements, and otherwise to the prepped row hits
+    if (earliest && (hidden_bank_prep || !prepped)) {
+        return std::make_pair(earliest->second, earliest_col_at);
+    } else if (prepped) {
+        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
+        return std::make_pair(prepped->second, prepped_col_at);
     }
 
-    return std::make_pair(selected_pkt_it, selected_col_at);
+    DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+    return std::make_pair(queue.end(), MaxTick);
 }
 
 void
@@ -504,41 +500,28 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
         // page, but closes it only if there are no row hits in the queue.
         // In this case, only force an auto precharge when there
         // are no same page hits in the queue
-        bool got_more_hits = false;
-        bool got_bank_conflict = false;
-
+        // 1) if a hit is found, then both open and close adaptive
+        //    policies keep the page open
+        // 2) if no hit is found, got_bank_conflict is set to true if a
+        //    bank conflict request is waiting in the queue
+        // 3) make sure we are not considering the packet that we are
+        //    currently dealing with, which is in the queue of its
+        //    priority
+        size_t same_row = 0;
+        size_t same_bank = 0;
         for (uint8_t i = 0; i < ctrl->numPriorities(); ++i) {
-            auto p = queue[i].begin();
-            // keep on looking until we find a hit or reach the end of the
-            // queue
-            // 1) if a hit is found, then both open and close adaptive
-            //    policies keep the page open
-            // 2) if no hit is found, got_bank_conflict is set to true if a
-            //    bank conflict request is waiting in the queue
-            // 3) make sure we are not considering the packet that we are
-            //    currently dealing with
-            while (!got_more_hits && p != queue[i].end()) {
-
-                if ((*p)->pseudoChannel != pseudoChannel) {
-                    // only consider if this pkt belongs to this interface
-                    ++p;
-                    continue;
-                }
-
-                if (mem_pkt != (*p)) {
-                    bool same_rank_bank = (mem_pkt->rank == (*p)->rank) &&
-                                          (mem_pkt->bank == (*p)->bank);
-
-                    bool same_row = mem_pkt->row == (*p)->row;
-                    got_more_hits |= same_rank_bank && same_row;
-                    got_bank_conflict |= same_rank_bank && !same_row;
-                }
-                ++p;
+            const auto* pkts = queue[i].bank(pseudoChannel, mem_pkt->bankId);
+            if (pkts) {
+                same_row += MemPacketQueue::rowSize(*pkts, mem_pkt->row);
+                same_bank += pkts->size;
             }
-
-            if (got_more_hits)
-                break;
         }
+        assert(same_row > 0);
+        same_row--;
+        same_bank--;
+
+        bool got_more_hits = same_row > 0;
+        bool got_bank_conflict = same_bank > same_row;
 
         // auto pre-charge when either
         // 1) open_adaptive policy, we have not got any more hits, and
@@ -657,6 +640,7 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
       maxAccessesPerRow(_p.max_accesses_per_row),
       timeStampOffset(0), activeRank(0),
       enableDRAMPowerdown(_p.enable_dram_powerdown),
+      refreshElision(_p.refresh_elision),
       lastStatsResetTick(0),
       stats(*this)
 {
@@ -745,9 +729,10 @@ DRAMInterface::init()
 
     // a bit of sanity checks on the interleaving, save it for here to
     // ensure that the system pointer is initialised
-    if (range.interleaved()) {
+    const Addr stripe_size = stripeSize();
+    if (stripe_size) {
         if (addrMapping == enums::RoRaBaChCo) {
-            if (rowBufferSize != range.granularity()) {
+            if (rowBufferSize != stripe_size) {
                 fatal("Channel interleaving of %s doesn't match RoRaBaChCo "
                       "address map\n", name());
             }
@@ -764,13 +749,13 @@ DRAMInterface::init()
 
             // channel striping has to be done at a granularity that
             // is equal or larger to a cache line
-            if (system()->cacheLineSize() > range.granularity()) {
+            if (system()->cacheLineSize() > stripe_size) {
                 fatal("Channel interleaving of %s must be at least as large "
                       "as the cache line size\n", name());
             }
 
             // ...and equal or smaller than the row-buffer size
-            if (rowBufferSize < range.granularity()) {
+            if (rowBufferSize < stripe_size) {
                 fatal("Channel interleaving of %s must be at most as large "
                       "as the row-buffer size\n", name());
             }
@@ -798,6 +783,13 @@ DRAMInterface::isBusy(bool read_queue_empty, bool all_writes_nvm)
 {
     int busy_ranks = 0;
     for (auto r : ranks) {
+        if (r->isRefreshElided()) {
+            // an idle rank is only busy while a refresh would be running
+            if (r->inElidedRefresh())
+                busy_ranks++;
+            continue;
+        }
+
         if (!r->inRefIdleState()) {
             if (r->pwrState != PWR_SREF) {
                 // rank is busy refreshing
@@ -919,6 +911,9 @@ DRAMInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
 
 void DRAMInterface::setupRank(const uint8_t rank, const bool is_read)
 {
+    // an idle rank gets back to simulating its refreshes
+    ranks[rank]->resumeRefresh();
+
     // increment entry count of the rank based on packet type
     if (is_read) {
         ++ranks[rank]->readEntries;
@@ -1038,25 +1033,20 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     // delay on the data bus
     bool hidden_bank_prep = false;
 
-    // determine if we have queued transactions targetting the
-    // bank in question
-    std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->pseudoChannel != pseudoChannel)
-            continue;
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
-            got_waiting[p->bankId] = true;
-    }
-
     // Find command with optimal bank timing
     // Will prioritize commands that can issue seamlessly.
     for (int i = 0; i < ranksPerChannel; i++) {
         for (int j = 0; j < banksPerRank; j++) {
             uint16_t bank_id = i * banksPerRank + j;
 
+            // determine if we have queued transactions targetting the
+            // bank in question
+            const bool got_waiting = ranks[i]->inRefIdleState() &&
+                queue.bank(pseudoChannel, bank_id) != nullptr;
+
             // if we have waiting requests for the bank, and it is
             // amongst the first available, update the mask
-            if (got_waiting[bank_id]) {
+            if (got_waiting) {
                 // make sure this rank is not currently refreshing.
                 assert(ranks[i]->inRefIdleState());
                 // simplistic approximation of when the bank can issue
@@ -1118,7 +1108,8 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
                          int _rank, DRAMInterface& _dram)
     : EventManager(&_dram), dram(_dram),
       pwrStateTrans(PWR_IDLE), pwrStatePostRefresh(PWR_IDLE),
-      pwrStateTick(0), refreshDueAt(0), pwrState(PWR_IDLE),
+      pwrStateTick(0), refreshDueAt(0), refreshElided(false),
+      elidedRefreshAt(0), pwrState(PWR_IDLE),
       refreshState(REF_IDLE), inLowPowerState(false), rank(_rank),
       readEntries(0), writeEntries(0), outstandingEvents(0),
       wakeUpAllowedAt(0), power(_p, false), banks(_p.banks_per_rank),
@@ -1167,6 +1158,7 @@ DRAMInterface::Rank::startup(Tick ref_tick)
 void
 DRAMInterface::Rank::suspend()
 {
+    resumeRefresh();
     deschedule(refreshEvent);
 
     // Update the stats
@@ -1285,6 +1277,17 @@ DRAMInterface::Rank::processWriteDoneEvent()
 void
 DRAMInterface::Rank::processRefreshEvent()
 {
+    // an idle rank would go through this refresh, and the following
+    // ones, without anything getting in the way, so stop simulating them
+    // until the rank is needed again
+    if (refreshState == REF_IDLE && canElideRefresh()) {
+        DPRINTF(DRAM, "Rank %d idle, fast-forwarding its refreshes\n",
+                rank);
+        refreshElided = true;
+        elidedRefreshAt = curTick();
+        return;
+    }
+
     // when first preparing the refresh, remember when it was due
     if ((refreshState == REF_IDLE) || (refreshState == REF_SREF_EXIT)) {
         // remember when the refresh is due
@@ -1810,6 +1813,9 @@ DRAMInterface::Rank::computeStats()
 {
     DPRINTF(DRAM,"Computing stats due to a dump callback\n");
 
+    // Account for any refresh that was not simulated
+    resumeRefresh();
+
     // Update the stats
     updatePowerStats();
 
@@ -1828,6 +1834,93 @@ DRAMInterface::Rank::resetStats() {
 
 }
 
+bool
+DRAMInterface::Rank::canElideRefresh() const
+{
+    if (!dram.refreshElision || dram.enableDRAMPowerdown ||
+        dram.ctrl->drainState() != DrainState::Running) {
+        return false;
+    }
+
+    // nothing must delay the refresh, or happen while it runs
+    if (pwrState != PWR_IDLE || numBanksActive != 0 ||
+        outstandingEvents != 0 || readEntries != 0 || writeEntries != 0 ||
+        powerEvent.scheduled() || wakeUpEvent.scheduled() ||
+        activateEvent.scheduled() || prechargeEvent.scheduled()) {
+        return false;
+    }
+
+    // the refresh would wait for a request being handled to drain
+    if (rank == dram.activeRank &&
+        dram.ctrl->requestEventScheduled(dram.pseudoChannel)) {
+        return false;
+    }
+
+    // the refreshes are passed to DRAMPower after any pending command
+    return std::all_of(cmdList.begin(), cmdList.end(),
+        [](const Command &cmd) { return cmd.timeStamp <= curTick(); });
+}
+
+bool
+DRAMInterface::Rank::inElidedRefresh() const
+{
+    assert(refreshElided);
+    const Tick period = dram.tREFI - dram.tRP;
+    return (curTick() - elidedRefreshAt) % period < dram.tRFC;
+}
+
+void
+DRAMInterface::Rank::resumeRefresh()
+{
+    if (!refreshElided)
+        return;
+    refreshElided = false;
+
+    // an idle rank refreshes every tREFI - tRP, as each refresh event is
+    // scheduled tRP ahead of the refresh being due, and the refresh
+    // starts right away
+    const Tick period = dram.tREFI - dram.tRP;
+    const uint64_t num_refs = (curTick() - elidedRefreshAt) / period + 1;
+    const Tick last_ref_at = elidedRefreshAt + (num_refs - 1) * period;
+    const Tick ref_done_at = last_ref_at + dram.tRFC;
+    const bool refreshing = curTick() < ref_done_at;
+
+    DPRINTF(DRAM, "Rank %d fast-forwarded %d refreshes\n", rank, num_refs);
+
+    // all the commands issued before the rank went idle are done
+    flushCmdList();
+    for (uint64_t i = 0; i < num_refs; i++) {
+        const Tick ref_at = elidedRefreshAt + i * period;
+        power.powerlib.doCommand(MemCommand::REF, 0,
+                                 divCeil(ref_at, dram.tCK) -
+                                 dram.timeStampOffset);
+    }
+
+    // the rank idled between the refreshes, up to the last one, which
+    // may still be running
+    const Tick ref_time = (refreshing ? num_refs - 1 : num_refs) * dram.tRFC;
+    const Tick accounted_at = refreshing ? last_ref_at : ref_done_at;
+    stats.pwrStateTime[PWR_IDLE] += accounted_at - pwrStateTick - ref_time;
+    stats.pwrStateTime[PWR_REF] += ref_time;
+    stats.elidedRefreshes += num_refs;
+    pwrStateTick = accounted_at;
+
+    for (auto &b : banks) {
+        b.actAllowedAt = ref_done_at;
+    }
+
+    if (refreshing) {
+        // pick up the refresh where it would be running
+        pwrState = PWR_REF;
+        refreshState = REF_RUN;
+        ++outstandingEvents;
+        refreshDueAt = last_ref_at + dram.tREFI;
+        schedule(refreshEvent, ref_done_at);
+    } else {
+        schedule(refreshEvent, last_ref_at + period);
+    }
+}
+
 bool
 DRAMInterface::Rank::forceSelfRefreshExit() const {
     return (readEntries != 0) ||
@@ -1992,7 +2085,10 @@ DRAMInterface::RankStats::RankStats(DRAMInterface &_dram, Rank &_rank)
     ADD_STAT(totalIdleTime, statistics::units::Tick::get(),
              "Total Idle time Per DRAM Rank"),
     ADD_STAT(pwrStateTime, statistics::units::Tick::get(),
-             "Time in different power states")
+             "Time in different power states"),
+    ADD_STAT(elidedRefreshes, statistics::units::Count::get(),
+             "Refreshes of the idle rank fast-forwarded rather than "
+             "simulated")
 {
 }
 
@@ -2014,6 +2110,9 @@ DRAMInterface::RankStats::regStats()
 void
 DRAMInterface::RankStats::resetStats()
 {
+    // Account for any refresh that was not simulated before the reset
+    rank.resumeRefresh();
+
     statistics::Group::resetStats();
 
     rank.resetStats();
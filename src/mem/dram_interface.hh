@@ -217,6 +217,11 @@ class DRAMInterface : public MemInterface
          * Track time spent in each power state.
          */
         statistics::Vector pwrStateTime;
+
+        /**
+         * Refreshes of the idle rank accounted for without simulating them.
+         */
+        statistics::Scalar elidedRefreshes;
     };
 
     /**
@@ -256,6 +261,24 @@ class DRAMInterface : public MemInterface
          */
         Tick refreshDueAt;
 
+        /**
+         * Whether the refreshes of the rank, idle since elidedRefreshAt,
+         * are fast-forwarded rather than simulated.
+         */
+        bool refreshElided;
+
+        /**
+         * Tick of the first refresh that was not simulated.
+         */
+        Tick elidedRefreshAt;
+
+        /**
+         * Check if the rank is idle enough for its refreshes to be
+         * fast-forwarded: all banks are closed, nothing is queued or in
+         * flight, and the rank is not set to power down.
+         */
+        bool canElideRefresh() const;
+
         /**
          * Function to update Power Stats
          */
@@ -365,6 +388,27 @@ class DRAMInterface : public MemInterface
          */
         void suspend();
 
+        /**
+         * Bring the refresh and power state of a rank whose refreshes
+         * were fast-forwarded up to date, and resume simulating them. The
+         * number of refreshes since the rank went idle, and the time spent
+         * refreshing and idling, follow from the refresh period, and the
+         * refreshes are passed on to DRAMPower for the energy. A refresh
+         * that would still be running is picked up where it would be.
+         */
+        void resumeRefresh();
+
+        /**
+         * Check if the refreshes of the rank are fast-forwarded.
+         */
+        bool isRefreshElided() const { return refreshElided; }
+
+        /**
+         * Check if a rank whose refreshes are fast-forwarded would be
+         * refreshing at the current tick.
+         */
+        bool inElidedRefresh() const;
+
         /**
          * Check if there is no refresh and no preparation of refresh ongoing
          * i.e. the refresh state machine is in idle
@@ -533,6 +577,9 @@ class DRAMInterface : public MemInterface
     /** Enable or disable DRAM powerdown states. */
     bool enableDRAMPowerdown;
 
+    /** Fast-forward the refreshes of idle ranks. */
+    const bool refreshElision;
+
     /** The time when stats were last reset used to calculate average power */
     Tick lastStatsResetTick;
 
@@ -642,7 +689,7 @@ class DRAMInterface : public MemInterface
      * @return time to send a burst of data without gaps
      */
     Tick
-    burstDelay() const
+    burstDelay() const override
     {
         return (burstInterleave ? tBURST_MAX / 2 : tBURST);
     }
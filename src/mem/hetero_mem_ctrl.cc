@@ -40,10 +40,17 @@
 
 #include "mem/hetero_mem_ctrl.hh"
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/DRAM.hh"
 #include "debug/Drain.hh"
 #include "debug/MemCtrl.hh"
+#include "debug/MemMigration.hh"
 #include "debug/NVM.hh"
 #include "debug/QOS.hh"
 #include "mem/dram_interface.hh"
@@ -59,7 +66,18 @@ namespace memory
 
 HeteroMemCtrl::HeteroMemCtrl(const HeteroMemCtrlParams &p) :
     MemCtrl(p),
-    nvm(p.nvm)
+    nvm(p.nvm),
+    pageMigration(p.page_migration),
+    pageBits(floorLog2(p.migration_page_size)),
+    migrationInterval(p.migration_interval),
+    migrationThreshold(p.migration_threshold),
+    migrationMaxPages(p.migration_max_pages),
+    copyInterval(2 * p.dram->bytesPerBurst() * p.migration_bandwidth),
+    maxCounters(p.hot_page_counters),
+    dramPages(0), clockHand(0), copiedBytes(0),
+    migrationEvent([this]{ processMigrationEvent(); }, name()),
+    copyEvent([this]{ processCopyEvent(); }, name()),
+    migrationStats(*this)
 {
     DPRINTF(MemCtrl, "Setting up controller\n");
     readQueue.resize(p.qos_priorities);
@@ -85,6 +103,263 @@ HeteroMemCtrl::HeteroMemCtrl(const HeteroMemCtrlParams &p) :
         fatal("Write buffer low threshold %d must be smaller than the "
               "high threshold %d\n", p.write_low_thresh_perc,
               p.write_high_thresh_perc);
+
+    if (pageMigration) {
+        const AddrRange &dram_range = dram->getAddrRange();
+        const AddrRange &nvm_range = nvm->getAddrRange();
+        fatal_if(!isPowerOf2(p.migration_page_size),
+                 "%s: The migration page size must be a power of two.",
+                 name());
+        fatal_if(dram->bytesPerBurst() != nvm->bytesPerBurst() ||
+                 p.migration_page_size < dram->bytesPerBurst(),
+                 "%s: Migrating pages needs the same burst size in the dram "
+                 "and the nvm, and pages no smaller than a burst.", name());
+        // the frames are mapped back to addresses by their offset
+        fatal_if(dram_range.interleaved() || nvm_range.interleaved() ||
+                 dram->getChannelMapper() || nvm->getChannelMapper(),
+                 "%s: Migrating pages needs a dram and an nvm that are not "
+                 "interleaved with other channels.", name());
+        fatal_if((dram_range.start() | dram_range.size() |
+                  nvm_range.start() | nvm_range.size()) &
+                 mask(pageBits),
+                 "%s: Migrating pages needs a dram and an nvm made of whole "
+                 "pages.", name());
+
+        dramPages = dram_range.size() >> pageBits;
+        fatal_if(dramPages == 0, "%s: There is no dram to migrate pages to.",
+                 name());
+    }
+}
+
+Addr
+HeteroMemCtrl::pageOf(Addr addr) const
+{
+    const AddrRange &dram_range = dram->getAddrRange();
+    if (dram_range.contains(addr))
+        return (addr - dram_range.start()) >> pageBits;
+
+    assert(nvm->getAddrRange().contains(addr));
+    return dramPages + ((addr - nvm->getAddrRange().start()) >> pageBits);
+}
+
+Addr
+HeteroMemCtrl::frameOf(Addr page) const
+{
+    auto it = pageFrames.find(page);
+    return it == pageFrames.end() ? page : it->second;
+}
+
+Addr
+HeteroMemCtrl::frameAddr(Addr frame) const
+{
+    if (frame < dramPages)
+        return dram->getAddrRange().start() + (frame << pageBits);
+    return nvm->getAddrRange().start() + ((frame - dramPages) << pageBits);
+}
+
+void
+HeteroMemCtrl::setFrame(Addr page, Addr frame)
+{
+    if (page == frame) {
+        pageFrames.erase(page);
+        framePages.erase(frame);
+    } else {
+        pageFrames[page] = frame;
+        framePages[frame] = page;
+    }
+}
+
+void
+HeteroMemCtrl::countAccess(Addr addr)
+{
+    const Addr page = pageOf(addr);
+    auto it = pageCounts.find(page);
+    if (it != pageCounts.end()) {
+        ++it->second;
+    } else if (pageCounts.size() < maxCounters) {
+        pageCounts.emplace(page, 1);
+    }
+}
+
+void
+HeteroMemCtrl::processMigrationEvent()
+{
+    migrationStats.trackedPages.sample(pageCounts.size());
+
+    // only select pages once the last ones are in their frames
+    if (swaps.empty()) {
+        // rank the pages in the nvm that are hot enough to migrate
+        std::vector<std::pair<uint32_t, Addr>> hot_pages;
+        for (const auto &[page, count] : pageCounts) {
+            if (count >= migrationThreshold && frameOf(page) >= dramPages)
+                hot_pages.emplace_back(count, page);
+        }
+        const size_t num_hot = std::min<size_t>(hot_pages.size(),
+                                                migrationMaxPages);
+        std::partial_sort(hot_pages.begin(), hot_pages.begin() + num_hot,
+                          hot_pages.end(), std::greater<>());
+
+        // swap each with the next page of the dram the clock hand finds
+        // colder by the threshold, going round the dram once at most
+        Addr scanned = 0;
+        for (size_t i = 0; i < num_hot && scanned < dramPages; ++i) {
+            const auto [count, hot_page] = hot_pages[i];
+            while (scanned < dramPages) {
+                const Addr cold_page = pageIn(clockHand);
+                clockHand = (clockHand + 1) % dramPages;
+                ++scanned;
+                if (pageCount(cold_page) + migrationThreshold <= count) {
+                    DPRINTF(MemMigration, "Swapping page %#x (%d accesses) "
+                            "with page %#x (%d accesses)\n",
+                            frameAddr(hot_page), count,
+                            frameAddr(cold_page), pageCount(cold_page));
+                    swaps.push_back({hot_page, cold_page});
+                    break;
+                }
+            }
+        }
+
+        if (!swaps.empty()) {
+            copiedBytes = 0;
+            schedule(copyEvent, curTick() + copyInterval);
+        }
+    }
+
+    // age the counters, dropping the pages no longer accessed
+    for (auto it = pageCounts.begin(); it != pageCounts.end();) {
+        it->second /= 2;
+        it = it->second ? std::next(it) : pageCounts.erase(it);
+    }
+
+    schedule(migrationEvent, curTick() + migrationInterval);
+}
+
+void
+HeteroMemCtrl::processCopyEvent()
+{
+    assert(!swaps.empty());
+
+    // a burst copied each way is read from and written to both tiers,
+    // which takes the shared data bus from the requests for as long
+    const Tick bus_time = 2 * (dram->burstDelay() + nvm->burstDelay());
+    dram->nextBurstAt = std::max(dram->nextBurstAt, curTick()) + bus_time;
+    nvm->nextBurstAt = dram->nextBurstAt;
+
+    copiedBytes += dram->bytesPerBurst();
+    migrationStats.copiedBytes += 2 * dram->bytesPerBurst();
+    migrationStats.copyBusTime += bus_time;
+
+    if (copiedBytes == (Addr(1) << pageBits)) {
+        // the copy is over, so the pages switch frames
+        const Swap swap = swaps.front();
+        swaps.pop_front();
+        copiedBytes = 0;
+
+        const Addr hot_frame = frameOf(swap.hotPage);
+        const Addr cold_frame = frameOf(swap.coldPage);
+        setFrame(swap.hotPage, cold_frame);
+        setFrame(swap.coldPage, hot_frame);
+        DPRINTF(MemMigration, "Page %#x now in the dram at %#x, page %#x "
+                "in the nvm at %#x\n", frameAddr(swap.hotPage),
+                frameAddr(cold_frame), frameAddr(swap.coldPage),
+                frameAddr(hot_frame));
+
+        ++migrationStats.promotions;
+        ++migrationStats.demotions;
+    }
+
+    if (!swaps.empty())
+        schedule(copyEvent, curTick() + copyInterval);
+}
+
+void
+HeteroMemCtrl::stopMigration()
+{
+    if (migrationEvent.scheduled())
+        deschedule(migrationEvent);
+    if (copyEvent.scheduled())
+        deschedule(copyEvent);
+
+    // the pages of the swaps dropped stay in their frames
+    migrationStats.abortedSwaps += swaps.size();
+    swaps.clear();
+    copiedBytes = 0;
+}
+
+MemPacket*
+HeteroMemCtrl::decodeBurst(PacketPtr pkt, Addr addr, unsigned size,
+                           bool is_read, MemInterface* mem_intr)
+{
+    MemPacket* mem_pkt;
+    if (pageMigration) {
+        const Addr frame = frameOf(pageOf(addr));
+        const Addr frame_addr = frameAddr(frame) + (addr & mask(pageBits));
+        mem_pkt = MemCtrl::decodeBurst(pkt, frame_addr, size, is_read,
+                                       frame < dramPages ? dram : nvm);
+        // keep the address of the burst, which the write queue is
+        // searched by and the data is accessed at
+        mem_pkt->addr = addr;
+    } else {
+        mem_pkt = MemCtrl::decodeBurst(pkt, addr, size, is_read, mem_intr);
+    }
+
+    if (mem_pkt->isDram())
+        ++migrationStats.dramBursts;
+    else
+        ++migrationStats.nvmBursts;
+
+    return mem_pkt;
+}
+
+void
+HeteroMemCtrl::accessAndRespond(PacketPtr pkt, Tick static_latency,
+                                MemInterface* mem_intr)
+{
+    // mem_intr is the tier the burst went to, which for a migrated page
+    // is not the tier holding the data
+    MemCtrl::accessAndRespond(pkt, static_latency,
+        dram->getAddrRange().contains(pkt->getAddr()) ? dram : nvm);
+}
+
+HeteroMemCtrl::MigrationStats::MigrationStats(HeteroMemCtrl &ctrl)
+    : statistics::Group(&ctrl, "migration"),
+
+    ADD_STAT(dramBursts, statistics::units::Count::get(),
+             "Number of bursts that went to the dram"),
+    ADD_STAT(nvmBursts, statistics::units::Count::get(),
+             "Number of bursts that went to the nvm"),
+    ADD_STAT(dramBurstRate, statistics::units::Ratio::get(),
+             "Percentage of the bursts that went to the dram"),
+
+    ADD_STAT(promotions, statistics::units::Count::get(),
+             "Number of pages migrated to the dram"),
+    ADD_STAT(demotions, statistics::units::Count::get(),
+             "Number of pages migrated to the nvm"),
+    ADD_STAT(abortedSwaps, statistics::units::Count::get(),
+             "Number of page swaps dropped before their copy was over"),
+
+    ADD_STAT(copiedBytes, statistics::units::Byte::get(),
+             "Total bytes copied between the tiers"),
+    ADD_STAT(copyBusTime, statistics::units::Tick::get(),
+             "Total time the data bus was taken by the copies"),
+
+    ADD_STAT(trackedPages, statistics::units::Count::get(),
+             "Number of pages whose accesses were counted at every "
+             "selection of pages to migrate")
+{
+}
+
+void
+HeteroMemCtrl::MigrationStats::regStats()
+{
+    using namespace statistics;
+
+    statistics::Group::regStats();
+
+    dramBurstRate.precision(2);
+    dramBurstRate = (dramBursts / (dramBursts + nvmBursts)) * 100;
+
+    trackedPages.init(10);
 }
 
 Tick
@@ -189,6 +464,9 @@ HeteroMemCtrl::recvTimingReq(PacketPtr pkt)
         }
     }
 
+    if (pageMigration)
+        countAccess(pkt->getAddr());
+
     return true;
 }
 
@@ -365,9 +643,10 @@ HeteroMemCtrl::minWriteToReadDataGap()
 Addr
 HeteroMemCtrl::burstAlign(Addr addr, MemInterface* mem_intr) const
 {
-    // mem_intr will point to dram interface in HeteroMemCtrl
-    if (mem_intr->getAddrRange().contains(addr)) {
-        return (addr & ~(Addr(mem_intr->bytesPerBurst() - 1)));
+    // mem_intr may be the tier a migrated page went to, so align the
+    // address to the bursts of the tier it is in
+    if (dram->getAddrRange().contains(addr)) {
+        return (addr & ~(Addr(dram->bytesPerBurst() - 1)));
     } else {
         assert(nvm->getAddrRange().contains(addr));
         return (addr & ~(Addr(nvm->bytesPerBurst() - 1)));
@@ -412,9 +691,21 @@ HeteroMemCtrl::allIntfDrained() const
     return (dram_drained && nvm_drained);
 }
 
+void
+HeteroMemCtrl::startup()
+{
+    MemCtrl::startup();
+
+    if (pageMigration && isTimingMode && !migrationEvent.scheduled())
+        schedule(migrationEvent, curTick() + migrationInterval);
+}
+
 DrainState
 HeteroMemCtrl::drain()
 {
+    // the swaps are not checkpointed, so drop the ones not done yet
+    stopMigration();
+
     // if there is anything in any of our internal queues, keep track
     // of that as well
     if (!(!totalWriteQueueSize && !totalReadQueueSize && respQueue.empty() &&
@@ -454,6 +745,9 @@ HeteroMemCtrl::drainResume()
 
     // update the mode
     isTimingMode = system()->isTimingMode();
+
+    if (pageMigration && isTimingMode && !migrationEvent.scheduled())
+        schedule(migrationEvent, curTick() + migrationInterval);
 }
 
 AddrRangeList
@@ -46,6 +46,10 @@
 #ifndef __HETERO_MEM_CTRL_HH__
 #define __HETERO_MEM_CTRL_HH__
 
+#include <deque>
+#include <unordered_map>
+
+#include "base/statistics.hh"
 #include "mem/mem_ctrl.hh"
 #include "params/HeteroMemCtrl.hh"
 
@@ -54,6 +58,24 @@ namespace gem5
 
 namespace memory
 {
+/**
+ * A memory controller for a dram and an nvm interface, which share the
+ * data and command bus.
+ *
+ * With page migration enabled, the dram and the nvm are tiers that the
+ * pages of both move between. The controller counts the accesses to
+ * every page, and periodically swaps the hottest pages of the nvm with
+ * pages of the dram that are colder by a threshold, found by a clock
+ * hand over the frames of the dram. The pages of a swap are copied a
+ * burst at a time, at the migration bandwidth, and every copied burst
+ * takes the data bus from the requests for the bursts it reads and
+ * writes in both tiers. A page keeps its frame until its copy is over.
+ *
+ * The migration is a timing model: the accesses to a page go to the
+ * banks of the frame it is in, but its data stays in the backing store
+ * at its address, so that migrating needs no data to be moved, and the
+ * frames of the pages need not be checkpointed.
+ */
 class HeteroMemCtrl : public MemCtrl
 {
   private:
@@ -62,6 +84,126 @@ class HeteroMemCtrl : public MemCtrl
      * Create pointer to interface of the actual nvm media when connected.
      */
     NVMInterface* nvm;
+
+    /** Is page migration enabled? */
+    const bool pageMigration;
+
+    /** Size of a page, as a number of address bits. */
+    const unsigned pageBits;
+
+    /** Time between two selections of pages to migrate. */
+    const Tick migrationInterval;
+
+    /** Accesses a page of the nvm must have over the one it swaps with. */
+    const uint32_t migrationThreshold;
+
+    /** Pages migrated to the dram at most per interval. */
+    const unsigned migrationMaxPages;
+
+    /** Time to copy a burst of a swap each way. */
+    const Tick copyInterval;
+
+    /** Pages whose accesses are counted at most. */
+    const size_t maxCounters;
+
+    /**
+     * The pages and frames of both tiers are numbered from the first
+     * one of the dram, the ones of the nvm following those of the dram.
+     */
+    Addr dramPages;
+
+    /** Frame of every page that is not in its own one. */
+    std::unordered_map<Addr, Addr> pageFrames;
+
+    /** Page in every frame that does not hold its own one. */
+    std::unordered_map<Addr, Addr> framePages;
+
+    /** Accesses to the pages accessed lately, halved every interval. */
+    std::unordered_map<Addr, uint32_t> pageCounts;
+
+    /** Next frame of the dram to consider for a swap. */
+    Addr clockHand;
+
+    /** A hot page of the nvm swapping with a cold page of the dram. */
+    struct Swap
+    {
+        Addr hotPage;
+        Addr coldPage;
+    };
+
+    /** Swaps to do, the one being copied first. */
+    std::deque<Swap> swaps;
+
+    /** Bytes of the first swap copied so far, each way. */
+    Addr copiedBytes;
+
+    /** @return The page of an address of either tier. */
+    Addr pageOf(Addr addr) const;
+
+    /** @return The frame a page is in. */
+    Addr frameOf(Addr page) const;
+
+    /** @return The address of a frame. */
+    Addr frameAddr(Addr frame) const;
+
+    /** @return The page in a frame. */
+    Addr
+    pageIn(Addr frame) const
+    {
+        auto it = framePages.find(frame);
+        return it == framePages.end() ? frame : it->second;
+    }
+
+    /** Move a page to a frame. */
+    void setFrame(Addr page, Addr frame);
+
+    /** @return The accesses to a page lately. */
+    uint32_t
+    pageCount(Addr page) const
+    {
+        auto it = pageCounts.find(page);
+        return it == pageCounts.end() ? 0 : it->second;
+    }
+
+    /** Count an access to the page of an address. */
+    void countAccess(Addr addr);
+
+    /** Select the pages to swap, and age the access counters. */
+    void processMigrationEvent();
+    EventFunctionWrapper migrationEvent;
+
+    /** Copy a burst of the current swap each way. */
+    void processCopyEvent();
+    EventFunctionWrapper copyEvent;
+
+    /** Drop the swaps, and stop migrating until resumed. */
+    void stopMigration();
+
+    struct MigrationStats : public statistics::Group
+    {
+        MigrationStats(HeteroMemCtrl &ctrl);
+
+        void regStats() override;
+
+        /** Bursts that went to either tier. */
+        statistics::Scalar dramBursts;
+        statistics::Scalar nvmBursts;
+        statistics::Formula dramBurstRate;
+
+        /** Pages moved to the dram, and out of it. */
+        statistics::Scalar promotions;
+        statistics::Scalar demotions;
+
+        /** Swaps dropped before their copy was over. */
+        statistics::Scalar abortedSwaps;
+
+        /** Bytes copied between the tiers, and the bus time it took. */
+        statistics::Scalar copiedBytes;
+        statistics::Scalar copyBusTime;
+
+        /** Pages whose accesses were counted, at every selection. */
+        statistics::Histogram trackedPages;
+    } migrationStats;
     MemPacketQueue::iterator chooseNext(MemPacketQueue& queue,
                       Tick extra_col_delay, MemInterface* mem_int) override;
     virtual std::pair<MemPacketQueue::iterator, Tick>
@@ -121,10 +263,26 @@ class HeteroMemCtrl : public MemCtrl
      */
     virtual bool nvmWriteBlock(MemInterface* mem_intr) override;
 
+    /**
+     * Decode a burst in the tier its page is in, which is not the one of
+     * its address for a migrated page.
+     */
+    MemPacket* decodeBurst(PacketPtr pkt, Addr addr, unsigned size,
+                           bool is_read, MemInterface* mem_intr) override;
+
+    /**
+     * Access the data of a packet in the tier of its address, whichever
+     * tier its page is in.
+     */
+    void accessAndRespond(PacketPtr pkt, Tick static_latency,
+                          MemInterface* mem_intr) override;
+
   public:
 
     HeteroMemCtrl(const HeteroMemCtrlParams &p);
 
+    void startup() override;
+
     bool allIntfDrained() const override;
     DrainState drain() override;
     void drainResume() override;
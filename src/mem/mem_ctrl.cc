@@ -40,6 +40,8 @@
 
 #include "mem/mem_ctrl.hh"
 
+#include <algorithm>
+
 #include "base/trace.hh"
 #include "debug/DRAM.hh"
 #include "debug/Drain.hh"
@@ -252,13 +254,8 @@ MemCtrl::addToReadQueue(PacketPtr pkt,
                 burst_helper = new BurstHelper(pkt_count);
             }
 
-            MemPacket* mem_pkt;
-            mem_pkt = mem_intr->decodePacket(pkt, addr, size, true,
-                                                    mem_intr->pseudoChannel);
-
-            // Increment read entries of the rank (dram)
-            // Increment count to trigger issue of non-deterministic read (nvm)
-            mem_intr->setupRank(mem_pkt->rank, true);
+            MemPacket* mem_pkt = decodeBurst(pkt, addr, size, true,
+                                             mem_intr);
             // Default readyTime to Max; will be reset once read is issued
             mem_pkt->readyTime = MaxTick;
             mem_pkt->burstHelper = burst_helper;
@@ -325,15 +322,12 @@ MemCtrl::addToWriteQueue(PacketPtr pkt, unsigned int pkt_count,
         // if the item was not merged we need to create a new write
         // and enqueue it
         if (!merged) {
-            MemPacket* mem_pkt;
-            mem_pkt = mem_intr->decodePacket(pkt, addr, size, false,
-                                                    mem_intr->pseudoChannel);
+            MemPacket* mem_pkt = decodeBurst(pkt, addr, size, false,
+                                             mem_intr);
             // Default readyTime to Max if nvm interface;
             //will be reset once read is issued
             mem_pkt->readyTime = MaxTick;
 
-            mem_intr->setupRank(mem_pkt->rank, false);
-
             assert(totalWriteQueueSize < writeBufferSize);
             stats.wrQLenPdf[totalWriteQueueSize]++;
 
@@ -372,6 +366,20 @@ MemCtrl::addToWriteQueue(PacketPtr pkt, unsigned int pkt_count,
     accessAndRespond(pkt, frontendLatency, mem_intr);
 }
 
+MemPacket*
+MemCtrl::decodeBurst(PacketPtr pkt, Addr addr, unsigned size, bool is_read,
+                     MemInterface* mem_intr)
+{
+    MemPacket* mem_pkt = mem_intr->decodePacket(pkt, addr, size, is_read,
+                                                mem_intr->pseudoChannel);
+
+    // Increment read or write entries of the rank (dram)
+    // Increment count to trigger issue of non-deterministic read (nvm)
+    mem_intr->setupRank(mem_pkt->rank, is_read);
+
+    return mem_pkt;
+}
+
 void
 MemCtrl::printQs() const
 {
@@ -999,7 +1007,7 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
             // log the response
             logResponse(MemCtrl::READ, (*to_read)->requestorId(),
                         mem_pkt->qosValue(), mem_pkt->getAddr(), 1,
-                        mem_pkt->readyTime - mem_pkt->entryTime);
+                        mem_pkt->readyTime);
 
 
             // Insert into response queue. It will be sent back to the
@@ -1087,7 +1095,7 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
         // log the response
         logResponse(MemCtrl::WRITE, mem_pkt->requestorId(),
                     mem_pkt->qosValue(), mem_pkt->getAddr(), 1,
-                    mem_pkt->readyTime - mem_pkt->entryTime);
+                    mem_pkt->readyTime);
 
 
         // remove the request from the queue - the iterator is no longer valid
@@ -55,6 +55,7 @@
 #include "base/callback.hh"
 #include "base/statistics.hh"
 #include "enums/MemSched.hh"
+#include "mem/mem_packet_queue.hh"
 #include "mem/qos/mem_ctrl.hh"
 #include "mem/qport.hh"
 #include "params/MemCtrl.hh"
@@ -215,11 +216,6 @@ class MemPacket
 
 };
 
-// The memory packets are store in a multiple dequeue structure,
-// based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
-
-
 /**
  * The memory controller is a single-channel memory controller capturing
  * the most important timing constraints associated with a
@@ -357,6 +353,20 @@ class MemCtrl : public qos::MemCtrl
     void addToWriteQueue(PacketPtr pkt, unsigned int pkt_count,
                          MemInterface* mem_intr);
 
+    /**
+     * Decode a burst of a packet into a memory packet, and set up the
+     * rank the burst goes to.
+     *
+     * @param pkt The request packet from the outside world
+     * @param addr The address of the burst
+     * @param size The size of the burst
+     * @param is_read Is the burst a read?
+     * @param mem_intr The memory interface the pkt goes to
+     * @return The memory packet of the burst
+     */
+    virtual MemPacket* decodeBurst(PacketPtr pkt, Addr addr, unsigned size,
+                                   bool is_read, MemInterface* mem_intr);
+
     /**
      * Actually do the burst based on media specific access function.
      * Update bus statistics when complete.
@@ -486,7 +496,7 @@ class MemCtrl : public qos::MemCtrl
      * as sizing the read queue, this and the main read queue need to
      * be added together.
      */
-    std::deque<MemPacket*> respQueue;
+    MemPacketQueue respQueue;
 
     /**
      * Holds count of commands issued in burst window starting at
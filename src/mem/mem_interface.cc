@@ -61,8 +61,7 @@ MemInterface::MemInterface(const MemInterfaceParams &_p)
       devicesPerRank(_p.devices_per_rank),
       rowBufferSize(devicesPerRank * deviceRowBufferSize),
       burstsPerRowBuffer(rowBufferSize / burstSize),
-      burstsPerStripe(range.interleaved() ?
-                      range.granularity() / burstSize : 1),
+      burstsPerStripe(stripeSize() ? stripeSize() / burstSize : 1),
       ranksPerChannel(_p.ranks_per_channel),
       banksPerRank(_p.banks_per_rank), rowsPerBank(0),
       tCK(_p.tCK), tCS(_p.tCS), tBURST(_p.tBURST),
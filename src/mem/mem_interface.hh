@@ -53,6 +53,7 @@
 #include <vector>
 
 #include "base/compiler.hh"
+#include "base/logging.hh"
 #include "base/statistics.hh"
 #include "enums/AddrMap.hh"
 #include "enums/PageManage.hh"
@@ -189,6 +190,11 @@ class MemInterface : public AbstractMemory
     Tick nextBurstAt = 0;
     Tick nextReqTime = 0;
 
+    /*
+     * @return time to send a burst of data without gaps
+     */
+    virtual Tick burstDelay() const { return tBURST; }
+
     /**
      * pseudo channel number used for HBM modeling
      */
@@ -213,7 +219,32 @@ class MemInterface : public AbstractMemory
      * @param addr The intput address which should be in the addrRange
      * @return An address in the continues range [0, max)
      */
-    Addr getCtrlAddr(Addr addr) { return range.getOffset(addr); }
+    Addr
+    getCtrlAddr(Addr addr)
+    {
+        if (channelMapper) {
+            panic_if(channelMapper->channel(addr) != channel,
+                     "%s got %#x of channel %d, are the channels connected "
+                     "to the crossbar in order?", name(), addr,
+                     channelMapper->channel(addr));
+            return channelMapper->channelOffset(addr);
+        }
+        return range.getOffset(addr);
+    }
+
+    /**
+     * Get the number of consecutive addresses mapped to this interface
+     * at a time, when its range is interleaved or it is a channel.
+     *
+     * @return The size of a stripe, or 0 if the range is contiguous
+     */
+    Addr
+    stripeSize() const
+    {
+        if (channelMapper)
+            return channelMapper->granularity();
+        return range.interleaved() ? range.granularity() : 0;
+    }
 
     /**
      * Setup the rank based on packet received
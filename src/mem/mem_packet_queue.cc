@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/mem_packet_queue.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "mem/mem_ctrl.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+void
+MemPacketQueue::push_back(MemPacket* pkt)
+{
+    auto it = packets.insert(packets.end(), pkt);
+    const uint64_t seq = nextSeq++;
+    if (!pkt->isDram())
+        return;
+
+    if (pkt->pseudoChannel >= banks.size())
+        banks.resize(pkt->pseudoChannel + 1);
+    auto& channel_banks = banks[pkt->pseudoChannel];
+    if (pkt->bankId >= channel_banks.size())
+        channel_banks.resize(pkt->bankId + 1);
+
+    Bank& bank = channel_banks[pkt->bankId];
+    auto& row = bank.rows[pkt->row];
+    if (row.empty())
+        bank.oldest.emplace(seq, pkt->row);
+    row.emplace_back(seq, it);
+    ++bank.size;
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::erase(iterator it)
+{
+    MemPacket* pkt = *it;
+    if (pkt->isDram()) {
+        Bank& bank = banks[pkt->pseudoChannel][pkt->bankId];
+        auto row_it = bank.rows.find(pkt->row);
+        assert(row_it != bank.rows.end());
+        auto& row = row_it->second;
+
+        if (row.front().second == it) {
+            // the scheduler normally picks the oldest packet to a row
+            bank.oldest.erase({row.front().first, pkt->row});
+            row.pop_front();
+            if (row.empty())
+                bank.rows.erase(row_it);
+            else
+                bank.oldest.emplace(row.front().first, pkt->row);
+        } else {
+            auto entry = std::find_if(row.begin(), row.end(),
+                [it](const Entry& e) { return e.second == it; });
+            assert(entry != row.end());
+            row.erase(entry);
+        }
+        --bank.size;
+    }
+    return packets.erase(it);
+}
+
+} // namespace memory
+} // namespace gem5
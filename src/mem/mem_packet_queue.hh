@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declares the queues of memory packets of the memory controllers, which
+ * index their DRAM packets by bank and row.
+ */
+
+#ifndef __MEM_MEM_PACKET_QUEUE_HH__
+#define __MEM_MEM_PACKET_QUEUE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+class MemPacket;
+
+/**
+ * A queue of memory packets, in arrival order. The memory packets are
+ * stored in multiple such queues, based on their QoS priority.
+ *
+ * The queue also indexes its DRAM packets by bank and row, so that the
+ * scheduler can find the oldest packet to the open row of a bank, or to
+ * any other row of it, without scanning the whole queue.
+ */
+class MemPacketQueue
+{
+  private:
+    typedef std::list<MemPacket*> Packets;
+
+  public:
+    typedef Packets::iterator iterator;
+    typedef Packets::const_iterator const_iterator;
+
+    /** A packet in the index: its arrival order and place in the queue */
+    typedef std::pair<uint64_t, iterator> Entry;
+
+    /** The packets to a bank. */
+    struct Bank
+    {
+        /** The packets to each row, oldest first */
+        std::unordered_map<uint32_t, std::deque<Entry>> rows;
+        /** The arrival order of the oldest packet to each row */
+        std::set<std::pair<uint64_t, uint32_t>> oldest;
+        /** Number of packets to the bank */
+        unsigned size = 0;
+    };
+
+    MemPacketQueue() = default;
+
+    // The index refers to the packets of this very queue
+    MemPacketQueue(const MemPacketQueue&) = delete;
+    MemPacketQueue& operator=(const MemPacketQueue&) = delete;
+    MemPacketQueue(MemPacketQueue&&) = default;
+    MemPacketQueue& operator=(MemPacketQueue&&) = default;
+
+    iterator begin() { return packets.begin(); }
+    iterator end() { return packets.end(); }
+    const_iterator begin() const { return packets.begin(); }
+    const_iterator end() const { return packets.end(); }
+
+    size_t size() const { return packets.size(); }
+    bool empty() const { return packets.empty(); }
+
+    MemPacket* front() const { return packets.front(); }
+    MemPacket* back() const { return packets.back(); }
+
+    void push_back(MemPacket* pkt);
+    void pop_front() { erase(begin()); }
+
+    /** @return The packet that followed the one erased. */
+    iterator erase(iterator it);
+
+    /**
+     * @return The DRAM packets to a bank, or nullptr if there are none.
+     */
+    const Bank*
+    bank(uint8_t pseudo_channel, uint16_t bank_id) const
+    {
+        if (pseudo_channel >= banks.size() ||
+            bank_id >= banks[pseudo_channel].size()) {
+            return nullptr;
+        }
+        const Bank& bank = banks[pseudo_channel][bank_id];
+        return bank.size ? &bank : nullptr;
+    }
+
+    /** @return The oldest packet to a row of a bank, or nullptr. */
+    static const Entry*
+    oldestTo(const Bank& bank, uint32_t row)
+    {
+        auto it = bank.rows.find(row);
+        return it == bank.rows.end() ? nullptr : &it->second.front();
+    }
+
+    /** @return The oldest packet to another row of a bank, or nullptr. */
+    static const Entry*
+    oldestNotTo(const Bank& bank, uint32_t row)
+    {
+        for (const auto& oldest : bank.oldest) {
+            if (oldest.second != row)
+                return &bank.rows.find(oldest.second)->second.front();
+        }
+        return nullptr;
+    }
+
+    /** @return The number of packets to a row of a bank. */
+    static size_t
+    rowSize(const Bank& bank, uint32_t row)
+    {
+        auto it = bank.rows.find(row);
+        return it == bank.rows.end() ? 0 : it->second.size();
+    }
+
+  private:
+    Packets packets;
+
+    /** The banks of the DRAM packets, by pseudo channel and bank id */
+    std::vector<std::vector<Bank>> banks;
+
+    /** Arrival order of the next packet */
+    uint64_t nextSeq = 0;
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_MEM_PACKET_QUEUE_HH__
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/mem_ctrl.hh"
+#include "mem/mem_packet_queue.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+// The memory packets take their entry time from the current tick
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+const unsigned numChannels = 2;
+const unsigned numBanks = 4;
+const unsigned numRows = 4;
+
+/**
+ * Check the index of a queue against a scan of its packets, in order:
+ * the size of every bank, and the oldest packet to and not to each row,
+ * along with the number of packets to it.
+ */
+void
+expectIndexed(const MemPacketQueue &queue)
+{
+    for (unsigned channel = 0; channel <= numChannels; ++channel) {
+        for (unsigned bank_id = 0; bank_id <= numBanks; ++bank_id) {
+            std::vector<const MemPacket *> scan;
+            for (const MemPacket *pkt : queue) {
+                if (pkt->isDram() && pkt->pseudoChannel == channel &&
+                    pkt->bankId == bank_id) {
+                    scan.push_back(pkt);
+                }
+            }
+
+            const MemPacketQueue::Bank *bank = queue.bank(channel, bank_id);
+            ASSERT_EQ(bank == nullptr, scan.empty());
+            if (!bank)
+                continue;
+            ASSERT_EQ(bank->size, scan.size());
+
+            for (uint32_t row = 0; row <= numRows; ++row) {
+                const MemPacket *to = nullptr;
+                const MemPacket *not_to = nullptr;
+                size_t row_size = 0;
+                for (const MemPacket *pkt : scan) {
+                    if (pkt->row == row) {
+                        to = to ? to : pkt;
+                        ++row_size;
+                    } else {
+                        not_to = not_to ? not_to : pkt;
+                    }
+                }
+
+                const auto *entry = MemPacketQueue::oldestTo(*bank, row);
+                ASSERT_EQ(entry ? *entry->second : nullptr, to);
+                entry = MemPacketQueue::oldestNotTo(*bank, row);
+                ASSERT_EQ(entry ? *entry->second : nullptr, not_to);
+                ASSERT_EQ(MemPacketQueue::rowSize(*bank, row), row_size);
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+/** The index follows packets pushed and erased anywhere in the queue,
+ * leaving out the NVM ones. */
+TEST(MemPacketQueueTest, MatchesScan)
+{
+    RequestPtr req = Request::create(0, 64, 0, 0);
+    Packet pkt(req, MemCmd::ReadReq);
+
+    std::mt19937 rng(1);
+    std::vector<std::unique_ptr<MemPacket>> mem_pkts;
+    MemPacketQueue queue;
+    for (int i = 0; i < 5000; ++i) {
+        const unsigned action = rng() % 8;
+        if (action < 4 || queue.empty()) {
+            const unsigned bank = rng() % numBanks;
+            mem_pkts.emplace_back(new MemPacket(&pkt, true, rng() % 8 != 0,
+                rng() % numChannels, 0, bank, rng() % numRows, bank, 0,
+                64));
+            queue.push_back(mem_pkts.back().get());
+        } else if (action < 6) {
+            // The oldest packet to a row, as the scheduler picks it
+            const MemPacket *picked = *std::next(queue.begin(),
+                                                 rng() % queue.size());
+            auto it = queue.begin();
+            while ((*it)->pseudoChannel != picked->pseudoChannel ||
+                   (*it)->bankId != picked->bankId ||
+                   (*it)->row != picked->row ||
+                   (*it)->isDram() != picked->isDram()) {
+                ++it;
+            }
+            queue.erase(it);
+        } else if (action < 7) {
+            queue.erase(std::next(queue.begin(), rng() % queue.size()));
+        } else {
+            queue.pop_front();
+        }
+        expectIndexed(queue);
+        if (HasFailure())
+            return;
+    }
+}
+
+/** A moved queue keeps its index, which refers to its own packets. */
+TEST(MemPacketQueueTest, Move)
+{
+    RequestPtr req = Request::create(0, 64, 0, 0);
+    Packet pkt(req, MemCmd::ReadReq);
+    MemPacket first(&pkt, true, true, 0, 0, 1, 7, 1, 0, 64);
+    MemPacket second(&pkt, true, true, 0, 0, 1, 3, 1, 0, 64);
+
+    std::vector<MemPacketQueue> queues(1);
+    queues[0].push_back(&first);
+    queues[0].push_back(&second);
+    queues.resize(4);
+
+    const MemPacketQueue::Bank *bank = queues[0].bank(0, 1);
+    ASSERT_NE(bank, nullptr);
+    ASSERT_EQ(*MemPacketQueue::oldestNotTo(*bank, 7)->second, &second);
+    queues[0].pop_front();
+    ASSERT_EQ(MemPacketQueue::oldestTo(*bank, 7), nullptr);
+    ASSERT_EQ(*MemPacketQueue::oldestTo(*bank, 3)->second, &second);
+}
@@ -53,6 +53,7 @@
 #include <list>
 
 #include "base/addr_range.hh"
+#include "base/block_pool.hh"
 #include "base/cast.hh"
 #include "base/compiler.hh"
 #include "base/flags.hh"
@@ -350,6 +351,9 @@ class Packet : public Printable
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The dynamic data was allocated by the packet itself, from the
+        /// payload pools rather than with new [].
+        POOLED_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -362,6 +366,9 @@ class Packet : public Printable
 
     Flags flags;
 
+    /** Pools of the data payloads the packets allocate. */
+    typedef SizeClassPools<256> PayloadPools;
+
   public:
     typedef MemCmd::Command Command;
 
@@ -1036,6 +1043,20 @@ class Packet : public Printable
         deleteData();
     }
 
+    /** Packets come from a per-thread pool rather than the heap. */
+    static void *
+    operator new(std::size_t size)
+    {
+        assert(size == sizeof(Packet));
+        return BlockPool<sizeof(Packet), alignof(Packet)>::allocate();
+    }
+
+    static void
+    operator delete(void *ptr)
+    {
+        BlockPool<sizeof(Packet), alignof(Packet)>::deallocate(ptr);
+    }
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1327,10 +1348,12 @@ class Packet : public Printable
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(POOLED_DATA))
+            PayloadPools::deallocate(data, getSize());
+        else if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA);
         data = NULL;
     }
 
@@ -1342,8 +1365,9 @@ class Packet : public Printable
         // payload, actually allocate space
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
-            flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            flags.set(DYNAMIC_DATA|POOLED_DATA);
+            data = static_cast<PacketDataPtr>(
+                PayloadPools::allocate(getSize()));
         }
     }
 
@@ -39,22 +39,32 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/user.h>
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
+#include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
+#include "mem/channel_mapper.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_exit.hh"
 
@@ -76,14 +86,147 @@ namespace gem5
 namespace memory
 {
 
+namespace
+{
+
+/** Size of the pages of the deduplicated checkpoint format. */
+constexpr uint64_t dedupPageSize = 4096;
+
+/** Pages compressed together in a chunk of the page file. */
+constexpr uint64_t dedupChunkPages = 256;
+
+/** Identifies the page file of the deduplicated checkpoint format. */
+constexpr char dedupMagic[8] = { 'g', 'e', 'm', '5', 'p', 'g', 's', '1' };
+
+/** Header of the page file, followed by the size of each chunk. */
+struct DedupHeader
+{
+    char magic[8];
+    uint64_t pageSize;
+    uint64_t numPages;
+    uint64_t chunkPages;
+};
+
+/**
+ * Runs a function on each index of a range, spread over host threads.
+ *
+ * @param threads The number of threads, or 0 for one per host core
+ * @param n The end of the range
+ * @param f The function, called with each index
+ */
+template <typename F>
+void
+parallelFor(unsigned threads, uint64_t n, F &&f)
+{
+    if (threads == 0)
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    std::atomic<uint64_t> next(0);
+    auto work = [&]() {
+        for (uint64_t i = next++; i < n; i = next++)
+            f(i);
+    };
+
+    std::vector<std::thread> workers;
+    for (uint64_t t = 1; t < std::min<uint64_t>(threads, n); t++)
+        workers.emplace_back(work);
+    work();
+    for (auto &worker : workers)
+        worker.join();
+}
+
+/**
+ * Hashes a page, returning 0 if and only if the page is all zeros.
+ */
+uint64_t
+hashPage(const uint8_t *page)
+{
+    uint64_t hash = 0;
+    uint64_t any = 0;
+    for (uint64_t i = 0; i < dedupPageSize; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, page + i, sizeof(word));
+        any |= word;
+        hash = (hash ^ word) * 0x9e3779b97f4a7c15ULL;
+        hash ^= hash >> 29;
+    }
+    if (!any)
+        return 0;
+    return hash ? hash : 1;
+}
+
+bool
+gzWriteAll(gzFile file, const void *data, uint64_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (uint64_t done = 0; done < size; ) {
+        const unsigned pass = std::min<uint64_t>(size - done, INT_MAX);
+        if (gzwrite(file, bytes + done, pass) != (int)pass)
+            return false;
+        done += pass;
+    }
+    return true;
+}
+
+bool
+gzReadAll(gzFile file, void *data, uint64_t size)
+{
+    uint8_t *bytes = (uint8_t *)data;
+    for (uint64_t done = 0; done < size; ) {
+        const unsigned pass = std::min<uint64_t>(size - done, INT_MAX);
+        if (gzread(file, bytes + done, pass) != (int)pass)
+            return false;
+        done += pass;
+    }
+    return true;
+}
+
+bool
+writeAll(int fd, const void *data, uint64_t size, uint64_t offset)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (uint64_t done = 0; done < size; ) {
+        ssize_t ret = pwrite(fd, bytes + done,
+                             std::min<uint64_t>(size - done, INT_MAX),
+                             offset + done);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+        done += ret;
+    }
+    return true;
+}
+
+bool
+readAll(int fd, void *data, uint64_t size, uint64_t offset)
+{
+    uint8_t *bytes = (uint8_t *)data;
+    for (uint64_t done = 0; done < size; ) {
+        ssize_t ret = pread(fd, bytes + done,
+                            std::min<uint64_t>(size - done, INT_MAX),
+                            offset + done);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+        done += ret;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
 PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
-    _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
+                               bool auto_unlink_shared_backstore,
+                               enums::MemoryCheckpointFormat checkpoint_format,
+                               unsigned checkpoint_threads)
+    : _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), checkpointFormat(checkpoint_format),
+    checkpointThreads(checkpoint_threads)
 {
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
@@ -93,6 +236,9 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
     if (mmap_using_noreserve)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
 
+    // the channels of each channel mapper, which share its range
+    std::map<const ChannelMapper *, std::vector<AbstractMemory*>> channels;
+
     // add the memories from the system to the address map as
     // appropriate
     for (const auto& m : _memories) {
@@ -103,6 +249,14 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
             // calculate the total size once and for all
             size += m->size();
 
+            // the range of a mapper is only added for its first channel
+            if (m->getChannelMapper()) {
+                auto &mapped = channels[m->getChannelMapper()];
+                mapped.push_back(m);
+                if (mapped.size() > 1)
+                    continue;
+            }
+
             // add the range to our interval tree and make sure it does not
             // intersect an existing range
             fatal_if(addrMap.insert(m->getAddrRange(), m) == addrMap.end(),
@@ -131,6 +285,28 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
         }
     }
 
+    // every channel of a mapper must be there, once, and like the others
+    for (const auto& c : channels) {
+        const ChannelMapper *mapper = c.first;
+        std::vector<bool> seen(mapper->numChannels(), false);
+        AbstractMemory *f = c.second.front();
+        for (const auto& m : c.second) {
+            fatal_if(seen[m->getChannel()], "%s is channel %d of %s, which "
+                     "another memory already is\n", m->name(),
+                     m->getChannel(), mapper->name());
+            seen[m->getChannel()] = true;
+
+            if (f->isNull() != m->isNull() ||
+                f->isConfReported() != m->isConfReported() ||
+                f->isKvmMap() != m->isKvmMap())
+                fatal("Inconsistent flags in the channels of %s\n",
+                      mapper->name());
+        }
+        fatal_if(c.second.size() != mapper->numChannels(),
+                 "%s has %d channels, but %d memories\n", mapper->name(),
+                 mapper->numChannels(), c.second.size());
+    }
+
     // iterate over the increasing addresses and chunks of contiguous
     // space to be mapped to backing store, create it and inform the
     // memories
@@ -166,6 +342,14 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
                 }
                 intlv_ranges.push_back(r.first);
                 curr_memories.push_back(r.second);
+            } else if (r.second->getChannelMapper()) {
+                // the channels share a backing store, as they are
+                // addressed by the addresses of the whole range
+                createBackingStore(r.first,
+                                   channels[r.second->getChannelMapper()],
+                                   r.second->isConfReported(),
+                                   r.second->isInAddrMap(),
+                                   r.second->isKvmMap());
             } else {
                 std::vector<AbstractMemory*> single_memory{r.second};
                 createBackingStore(r.first, single_memory,
@@ -351,6 +535,11 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
     unsigned int nbr_of_stores = backingStore.size();
     SERIALIZE_SCALAR(nbr_of_stores);
 
+    if (checkpointFormat == enums::dedup) {
+        serializeDedup(cp);
+        return;
+    }
+
     unsigned int store_id = 0;
     // store each backing store memory segment in a file
     for (auto& s : backingStore) {
@@ -363,11 +552,15 @@ void
 PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
                                AddrRange range, uint8_t* pmem) const
 {
+    const bool mapped = checkpointFormat == enums::mapped;
+
     // we cannot use the address range for the name as the
     // memories that are not part of the address map can overlap
-    std::string filename =
-        name() + ".store" + std::to_string(store_id) + ".pmem";
+    std::string filename = name() + ".store" + std::to_string(store_id) +
+        (mapped ? ".pmem.raw" : ".pmem");
     long range_size = range.size();
+    std::string format =
+        enums::MemoryCheckpointFormatStrings[checkpointFormat];
 
     DPRINTF(Checkpoint, "Serializing physical memory %s with size %d\n",
             filename, range_size);
@@ -375,9 +568,21 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
     SERIALIZE_SCALAR(store_id);
     SERIALIZE_SCALAR(filename);
     SERIALIZE_SCALAR(range_size);
+    SERIALIZE_SCALAR(format);
 
     // write memory file
     std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
+    if (mapped)
+        writeMappedStore(filepath, filename, range, pmem);
+    else
+        writeGzipStore(filepath, filename, range, pmem);
+}
+
+void
+PhysicalMemory::writeGzipStore(const std::string &filepath,
+                               const std::string &filename,
+                               AddrRange range, const uint8_t *pmem) const
+{
     gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
     if (compressed_mem == NULL)
         fatal("Can't open physical memory checkpoint file '%s'\n",
@@ -406,6 +611,244 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 
 }
 
+void
+PhysicalMemory::writeMappedStore(const std::string &filepath,
+                                 const std::string &filename,
+                                 AddrRange range, const uint8_t *pmem) const
+{
+    // write a new file and rename it over any existing one, as a
+    // simulation restored from the existing one may still have it mapped
+    std::string temp_path = filepath + ".tmp";
+    int fd = open(temp_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd == -1)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filename);
+
+    // the file spans whole pages, so that all of it can be mapped
+    if (ftruncate(fd, roundUp(range.size(), pageSize)))
+        fatal("Can't size physical memory checkpoint file '%s'\n",
+              filename);
+
+    // write runs of pages that are not all zeros, and leave the others
+    // as holes in the file, bounding the runs as write() does
+    const uint64_t max_run = 1ULL << 30;
+    uint64_t run_start = 0;
+    uint64_t run_size = 0;
+    auto write_run = [&]() {
+        for (uint64_t written = 0; written < run_size; ) {
+            ssize_t ret = pwrite(fd, pmem + run_start + written,
+                                 run_size - written, run_start + written);
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0)
+                fatal("Write failed on physical memory checkpoint file "
+                      "'%s'\n", filename);
+            written += ret;
+        }
+        run_size = 0;
+    };
+
+    for (uint64_t offset = 0; offset < range.size(); offset += pageSize) {
+        const uint64_t page_size =
+            std::min<uint64_t>(pageSize, range.size() - offset);
+        const uint8_t *page = pmem + offset;
+        if (page[0] == 0 && memcmp(page, page + 1, page_size - 1) == 0) {
+            write_run();
+            continue;
+        }
+        if (run_size >= max_run)
+            write_run();
+        if (!run_size)
+            run_start = offset;
+        run_size += page_size;
+    }
+    write_run();
+
+    if (close(fd) || rename(temp_path.c_str(), filepath.c_str()))
+        fatal("Close failed on physical memory checkpoint file '%s'\n",
+              filename);
+}
+
+void
+PhysicalMemory::serializeDedup(CheckpointOut &cp) const
+{
+    std::string pages_filename = name() + ".pages.dedup";
+    SERIALIZE_SCALAR(pages_filename);
+
+    // hash the pages of each store, padding the last page of a store
+    // that does not end on a page boundary
+    struct StorePages
+    {
+        const uint8_t *pmem;
+        uint64_t numPages;
+        std::unique_ptr<uint8_t[]> tail;
+        std::vector<uint64_t> hashes;
+
+        const uint8_t *
+        page(uint64_t i) const
+        {
+            return tail && i == numPages - 1 ?
+                tail.get() : pmem + i * dedupPageSize;
+        }
+    };
+
+    std::vector<StorePages> stores(backingStore.size());
+    for (unsigned int i = 0; i < backingStore.size(); ++i) {
+        const BackingStoreEntry &entry = backingStore[i];
+        StorePages &store = stores[i];
+        const uint64_t size = entry.range.size();
+        store.pmem = entry.pmem;
+        store.numPages = divCeil(size, dedupPageSize);
+        if (size % dedupPageSize) {
+            store.tail.reset(new uint8_t[dedupPageSize]());
+            memcpy(store.tail.get(),
+                   entry.pmem + (store.numPages - 1) * dedupPageSize,
+                   size % dedupPageSize);
+        }
+        store.hashes.resize(store.numPages);
+        parallelFor(checkpointThreads, store.numPages, [&](uint64_t page) {
+            store.hashes[page] = hashPage(store.page(page));
+        });
+    }
+
+    // find the distinct pages that are not all zeros, comparing the pages
+    // that hash the same
+    std::unordered_multimap<uint64_t, uint32_t> seen;
+    std::vector<const uint8_t *> unique_pages;
+    std::vector<std::vector<uint8_t>> bitmaps(stores.size());
+    std::vector<std::vector<uint32_t>> indices(stores.size());
+    uint64_t zero_pages = 0;
+    for (unsigned int i = 0; i < stores.size(); ++i) {
+        const StorePages &store = stores[i];
+        bitmaps[i].resize(divCeil(store.numPages, 8));
+        for (uint64_t page = 0; page < store.numPages; ++page) {
+            const uint64_t hash = store.hashes[page];
+            if (!hash) {
+                ++zero_pages;
+                continue;
+            }
+            bitmaps[i][page / 8] |= 1 << (page % 8);
+
+            const uint8_t *data = store.page(page);
+            uint32_t id = unique_pages.size();
+            auto same_hash = seen.equal_range(hash);
+            for (auto it = same_hash.first; it != same_hash.second; ++it) {
+                if (!memcmp(unique_pages[it->second], data, dedupPageSize)) {
+                    id = it->second;
+                    break;
+                }
+            }
+            if (id == unique_pages.size()) {
+                fatal_if(id == UINT32_MAX,
+                         "Too many distinct pages to checkpoint\n");
+                seen.emplace(hash, id);
+                unique_pages.push_back(data);
+            }
+            indices[i].push_back(id);
+        }
+    }
+
+    DPRINTF(Checkpoint, "Serializing physical memory %s with %d distinct "
+            "pages, and %d pages of zeros\n", pages_filename,
+            unique_pages.size(), zero_pages);
+
+    // write the bitmap and indices of each store
+    for (unsigned int store_id = 0; store_id < stores.size(); ++store_id) {
+        ScopedCheckpointSection sec(cp, csprintf("store%d", store_id));
+
+        std::string filename = name() + ".store" +
+            std::to_string(store_id) + ".pmem.dedup";
+        long range_size = backingStore[store_id].range.size();
+        std::string format = enums::MemoryCheckpointFormatStrings[
+            enums::dedup];
+
+        SERIALIZE_SCALAR(store_id);
+        SERIALIZE_SCALAR(filename);
+        SERIALIZE_SCALAR(range_size);
+        SERIALIZE_SCALAR(format);
+
+        std::string filepath = CheckpointIn::dir() + "/" + filename;
+        gzFile index_file = gzopen(filepath.c_str(), "wb");
+        if (index_file == NULL)
+            fatal("Can't open physical memory checkpoint file '%s'\n",
+                  filename);
+        const auto &bitmap = bitmaps[store_id];
+        const auto &index = indices[store_id];
+        if (!gzWriteAll(index_file, bitmap.data(), bitmap.size()) ||
+            !gzWriteAll(index_file, index.data(),
+                        index.size() * sizeof(uint32_t))) {
+            fatal("Write failed on physical memory checkpoint file '%s'\n",
+                  filename);
+        }
+        if (gzclose(index_file))
+            fatal("Close failed on physical memory checkpoint file '%s'\n",
+                  filename);
+    }
+
+    // write the distinct pages, compressing a batch of chunks at a time
+    // to bound the memory taken by the compressed chunks
+    std::string pages_path = CheckpointIn::dir() + "/" + pages_filename;
+    int fd = open(pages_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd == -1)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              pages_filename);
+
+    const uint64_t num_chunks = divCeil(unique_pages.size(), dedupChunkPages);
+    std::vector<uint64_t> chunk_sizes(num_chunks);
+    uint64_t offset = sizeof(DedupHeader) + num_chunks * sizeof(uint64_t);
+    const uint64_t batch_size = 64;
+    std::vector<std::vector<uint8_t>> compressed(batch_size);
+    for (uint64_t first = 0; first < num_chunks; first += batch_size) {
+        const uint64_t batch = std::min(batch_size, num_chunks - first);
+        std::atomic<bool> failed(false);
+        parallelFor(checkpointThreads, batch, [&](uint64_t i) {
+            const uint64_t begin = (first + i) * dedupChunkPages;
+            const uint64_t pages = std::min<uint64_t>(dedupChunkPages,
+                unique_pages.size() - begin);
+            std::vector<uint8_t> raw(pages * dedupPageSize);
+            for (uint64_t page = 0; page < pages; ++page) {
+                memcpy(raw.data() + page * dedupPageSize,
+                       unique_pages[begin + page], dedupPageSize);
+            }
+            uLongf size = compressBound(raw.size());
+            compressed[i].resize(size);
+            if (compress(compressed[i].data(), &size, raw.data(),
+                         raw.size()) != Z_OK) {
+                failed = true;
+            }
+            compressed[i].resize(size);
+        });
+        if (failed)
+            fatal("Compression failed on physical memory checkpoint file "
+                  "'%s'\n", pages_filename);
+
+        for (uint64_t i = 0; i < batch; ++i) {
+            chunk_sizes[first + i] = compressed[i].size();
+            if (!writeAll(fd, compressed[i].data(), compressed[i].size(),
+                          offset)) {
+                fatal("Write failed on physical memory checkpoint file "
+                      "'%s'\n", pages_filename);
+            }
+            offset += compressed[i].size();
+        }
+    }
+
+    DedupHeader header;
+    memcpy(header.magic, dedupMagic, sizeof(header.magic));
+    header.pageSize = dedupPageSize;
+    header.numPages = unique_pages.size();
+    header.chunkPages = dedupChunkPages;
+    if (!writeAll(fd, &header, sizeof(header), 0) ||
+        !writeAll(fd, chunk_sizes.data(), num_chunks * sizeof(uint64_t),
+                  sizeof(header))) {
+        fatal("Write failed on physical memory checkpoint file '%s'\n",
+              pages_filename);
+    }
+    if (close(fd))
+        fatal("Close failed on physical memory checkpoint file '%s'\n",
+              pages_filename);
+}
+
 void
 PhysicalMemory::unserialize(CheckpointIn &cp)
 {
@@ -424,6 +867,12 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
     unsigned int nbr_of_stores;
     UNSERIALIZE_SCALAR(nbr_of_stores);
 
+    std::string pages_filename;
+    if (UNSERIALIZE_OPT_SCALAR(pages_filename)) {
+        unserializeDedup(cp, pages_filename, nbr_of_stores);
+        return;
+    }
+
     for (unsigned int i = 0; i < nbr_of_stores; ++i) {
         ScopedCheckpointSection sec(cp, csprintf("store%d", i));
         unserializeStore(cp);
@@ -434,8 +883,6 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
 void
 PhysicalMemory::unserializeStore(CheckpointIn &cp)
 {
-    const uint32_t chunk_size = 16384;
-
     unsigned int store_id;
     UNSERIALIZE_SCALAR(store_id);
 
@@ -443,14 +890,17 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
+    // checkpoints predating the format are compressed
+    std::string format = "gzip";
+    UNSERIALIZE_OPT_SCALAR(format);
+
+    if (store_id >= backingStore.size())
+        fatal("Physical memory checkpoint file '%s' is of store %d, but "
+              "there are only %d\n", filename, store_id, backingStore.size());
 
     // we've already got the actual backing store mapped
-    uint8_t* pmem = backingStore[store_id].pmem;
-    AddrRange range = backingStore[store_id].range;
+    const BackingStoreEntry &store = backingStore[store_id];
+    AddrRange range = store.range;
 
     long range_size;
     UNSERIALIZE_SCALAR(range_size);
@@ -462,6 +912,32 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    if (format == enums::MemoryCheckpointFormatStrings[enums::mapped])
+        mapStore(filepath, filename, store);
+    else if (format == enums::MemoryCheckpointFormatStrings[enums::gzip])
+        readGzipStore(filepath, filename, store);
+    else if (format == enums::MemoryCheckpointFormatStrings[enums::dedup])
+        fatal("Physical memory checkpoint file '%s' has no page file\n",
+              filename);
+    else
+        fatal("Unknown format '%s' of physical memory checkpoint file '%s'\n",
+              format, filename);
+}
+
+void
+PhysicalMemory::readGzipStore(const std::string &filepath,
+                              const std::string &filename,
+                              const BackingStoreEntry &store)
+{
+    const uint32_t chunk_size = 16384;
+
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filename);
+
+    uint8_t* pmem = store.pmem;
+    AddrRange range = store.range;
+
     uint64_t curr_size = 0;
     long* temp_page = new long[chunk_size];
     long* pmem_current;
@@ -491,5 +967,225 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
               filename);
 }
 
+void
+PhysicalMemory::mapStore(const std::string &filepath,
+                         const std::string &filename,
+                         const BackingStoreEntry &store)
+{
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd == -1)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filename);
+
+    const uint64_t size = store.range.size();
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) ||
+        (uint64_t)file_stat.st_size < roundUp(size, pageSize))
+        fatal("Physical memory checkpoint file '%s' is truncated\n",
+              filename);
+
+    if (store.shmFd == -1) {
+        // replace the anonymous mapping at the same address, so that the
+        // memories and any KVM mapping of the store remain valid
+        int map_flags = MAP_PRIVATE | MAP_FIXED;
+        if (mmapUsingNoReserve)
+            map_flags |= MAP_NORESERVE;
+        uint8_t *pmem = (uint8_t *)mmap(store.pmem, size,
+                                        PROT_READ | PROT_WRITE,
+                                        map_flags, fd, 0);
+        if (pmem == (uint8_t *)MAP_FAILED) {
+            perror("mmap");
+            fatal("Could not mmap physical memory checkpoint file '%s'\n",
+                  filename);
+        }
+        assert(pmem == store.pmem);
+        DPRINTF(Checkpoint, "Mapped %s copy-on-write\n", filename);
+    } else {
+        for (uint64_t done = 0; done < size; ) {
+            ssize_t ret = pread(fd, store.pmem + done,
+                                std::min<uint64_t>(size - done, INT_MAX),
+                                done);
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0)
+                fatal("Read failed on physical memory checkpoint file "
+                      "'%s'\n", filename);
+            done += ret;
+        }
+    }
+
+    // the mapping keeps the file open
+    close(fd);
+}
+
+void
+PhysicalMemory::unserializeDedup(CheckpointIn &cp,
+                                 const std::string &pages_filename,
+                                 unsigned int nbr_of_stores)
+{
+    std::string pages_path = cp.getCptDir() + "/" + pages_filename;
+    int fd = open(pages_path.c_str(), O_RDONLY);
+    if (fd == -1)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              pages_filename);
+
+    DedupHeader header;
+    if (!readAll(fd, &header, sizeof(header), 0) ||
+        memcmp(header.magic, dedupMagic, sizeof(header.magic)) ||
+        header.pageSize != dedupPageSize || header.chunkPages == 0) {
+        fatal("Physical memory checkpoint file '%s' is not a page file\n",
+              pages_filename);
+    }
+
+    const uint64_t num_chunks = divCeil(header.numPages, header.chunkPages);
+    std::vector<uint64_t> chunk_sizes(num_chunks);
+    if (!readAll(fd, chunk_sizes.data(), num_chunks * sizeof(uint64_t),
+                 sizeof(header))) {
+        fatal("Read failed on physical memory checkpoint file '%s'\n",
+              pages_filename);
+    }
+    std::vector<uint64_t> chunk_offsets(num_chunks);
+    uint64_t offset = sizeof(header) + num_chunks * sizeof(uint64_t);
+    for (uint64_t chunk = 0; chunk < num_chunks; ++chunk) {
+        chunk_offsets[chunk] = offset;
+        offset += chunk_sizes[chunk];
+    }
+
+    // read the bitmap and indices of each store, counting the places each
+    // distinct page goes to
+    struct StoreIndex
+    {
+        const BackingStoreEntry *store;
+        std::vector<uint8_t> bitmap;
+        std::vector<uint32_t> pages;
+    };
+    std::vector<StoreIndex> stores(nbr_of_stores);
+    std::vector<uint64_t> first_place(header.numPages + 1, 0);
+    for (unsigned int i = 0; i < nbr_of_stores; ++i) {
+        ScopedCheckpointSection sec(cp, csprintf("store%d", i));
+
+        unsigned int store_id;
+        UNSERIALIZE_SCALAR(store_id);
+
+        std::string filename;
+        UNSERIALIZE_SCALAR(filename);
+        std::string filepath = cp.getCptDir() + "/" + filename;
+
+        long range_size;
+        UNSERIALIZE_SCALAR(range_size);
+
+        std::string format;
+        UNSERIALIZE_SCALAR(format);
+        if (format != enums::MemoryCheckpointFormatStrings[enums::dedup])
+            fatal("Physical memory checkpoint file '%s' is in the '%s' "
+                  "format, not in that of its page file\n", filename,
+                  format);
+
+        if (store_id >= backingStore.size())
+            fatal("Physical memory checkpoint file '%s' is of store %d, but "
+                  "there are only %d\n", filename, store_id,
+                  backingStore.size());
+
+        const BackingStoreEntry &store = backingStore[store_id];
+        if (range_size != store.range.size())
+            fatal("Memory range size has changed! Saw %lld, expected %lld\n",
+                  range_size, store.range.size());
+
+        gzFile index_file = gzopen(filepath.c_str(), "rb");
+        if (index_file == NULL)
+            fatal("Can't open physical memory checkpoint file '%s'\n",
+                  filename);
+
+        StoreIndex &index = stores[i];
+        index.store = &store;
+        index.bitmap.resize(divCeil(divCeil(range_size, dedupPageSize), 8));
+        bool read = gzReadAll(index_file, index.bitmap.data(),
+                              index.bitmap.size());
+        uint64_t num_pages = 0;
+        for (uint8_t bits : index.bitmap)
+            num_pages += popCount(bits);
+        index.pages.resize(num_pages);
+        read = read && gzReadAll(index_file, index.pages.data(),
+                                 num_pages * sizeof(uint32_t));
+        if (!read)
+            fatal("Read failed on physical memory checkpoint file '%s'\n",
+                  filename);
+        if (gzclose(index_file))
+            fatal("Close failed on physical memory checkpoint file '%s'\n",
+                  filename);
+
+        for (uint32_t page : index.pages) {
+            if (page >= header.numPages)
+                fatal("Physical memory checkpoint file '%s' refers to a "
+                      "missing page\n", filename);
+            ++first_place[page + 1];
+        }
+    }
+
+    for (uint64_t page = 0; page < header.numPages; ++page)
+        first_place[page + 1] += first_place[page];
+
+    struct Place
+    {
+        uint8_t *data;
+        uint64_t size;
+    };
+    std::vector<Place> places(first_place.back());
+    std::vector<uint64_t> next_place(first_place.begin(),
+                                     first_place.end() - 1);
+    for (const auto &index : stores) {
+        const uint64_t size = index.store->range.size();
+        // a shared backing store may still hold the data of the run that
+        // created it, where an anonymous one is zeroed already
+        const bool zero_pages = index.store->shmFd != -1;
+        auto page = index.pages.begin();
+        for (uint64_t i = 0; i * dedupPageSize < size; ++i) {
+            const uint64_t start = i * dedupPageSize;
+            const uint64_t page_size = std::min(dedupPageSize, size - start);
+            if (index.bitmap[i / 8] & (1 << (i % 8))) {
+                places[next_place[*page++]++] = { index.store->pmem + start,
+                    page_size };
+            } else if (zero_pages) {
+                memset(index.store->pmem + start, 0, page_size);
+            }
+        }
+    }
+
+    DPRINTF(Checkpoint, "Unserializing physical memory %s with %d distinct "
+            "pages\n", pages_filename, header.numPages);
+
+    // decompress the chunks, and copy each page to its places, the pages
+    // of zeros having no place
+    std::atomic<bool> failed(false);
+    parallelFor(checkpointThreads, num_chunks, [&](uint64_t chunk) {
+        const uint64_t begin = chunk * header.chunkPages;
+        const uint64_t pages = std::min(header.chunkPages,
+                                        header.numPages - begin);
+        std::vector<uint8_t> compressed(chunk_sizes[chunk]);
+        std::vector<uint8_t> raw(pages * dedupPageSize);
+        uLongf raw_size = raw.size();
+        if (!readAll(fd, compressed.data(), compressed.size(),
+                     chunk_offsets[chunk]) ||
+            uncompress(raw.data(), &raw_size, compressed.data(),
+                       compressed.size()) != Z_OK ||
+            raw_size != raw.size()) {
+            failed = true;
+            return;
+        }
+        for (uint64_t page = 0; page < pages; ++page) {
+            for (uint64_t place = first_place[begin + page];
+                 place < first_place[begin + page + 1]; ++place) {
+                memcpy(places[place].data, raw.data() + page * dedupPageSize,
+                       places[place].size);
+            }
+        }
+    });
+    close(fd);
+
+    if (failed)
+        fatal("Read failed on physical memory checkpoint file '%s'\n",
+              pages_filename);
+}
+
 } // namespace memory
 } // namespace gem5
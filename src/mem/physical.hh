@@ -44,6 +44,7 @@
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
+#include "enums/MemoryCheckpointFormat.hh"
 #include "mem/packet.hh"
 #include "sim/serialize.hh"
 
@@ -158,6 +159,12 @@ class PhysicalMemory : public Serializable
 
     long pageSize;
 
+    // The format backing stores are checkpointed in
+    const enums::MemoryCheckpointFormat checkpointFormat;
+
+    // Host threads compressing and decompressing memory checkpoints
+    const unsigned checkpointThreads;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
@@ -191,7 +198,9 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   enums::MemoryCheckpointFormat checkpoint_format,
+                   unsigned checkpoint_threads);
 
     /**
      * Unmap all the backing store we have used.
@@ -296,6 +305,61 @@ class PhysicalMemory : public Serializable
      */
     void unserializeStore(CheckpointIn &cp);
 
+  private:
+
+    /**
+     * Serialize all the backing stores in the deduplicated format. The
+     * pages of all the stores that are not all zeros are hashed, and each
+     * distinct page is written once, compressed by host threads in chunks,
+     * to a single page file. The file of each store holds a bitmap of its
+     * pages that are not all zeros, and the index of each of them in the
+     * page file.
+     */
+    void serializeDedup(CheckpointOut &cp) const;
+
+    /**
+     * Unserialize backing stores in the deduplicated format, decompressing
+     * the chunks of the page file in host threads, and copying each page
+     * to every place it appears in the stores.
+     *
+     * @param pages_filename The page file
+     * @param nbr_of_stores The number of backing stores
+     */
+    void unserializeDedup(CheckpointIn &cp, const std::string &pages_filename,
+                          unsigned int nbr_of_stores);
+
+    /**
+     * Write a backing store to a gzip-compressed file.
+     */
+    void writeGzipStore(const std::string &filepath,
+                        const std::string &filename,
+                        AddrRange range, const uint8_t *pmem) const;
+
+    /**
+     * Write a backing store to an uncompressed file that spans whole
+     * pages, leaving pages of zeros as holes, so that the file can be
+     * mapped over the backing store when it is restored.
+     */
+    void writeMappedStore(const std::string &filepath,
+                          const std::string &filename,
+                          AddrRange range, const uint8_t *pmem) const;
+
+    /**
+     * Read a backing store from a gzip-compressed file.
+     */
+    void readGzipStore(const std::string &filepath,
+                       const std::string &filename,
+                       const BackingStoreEntry &store);
+
+    /**
+     * Map a file written by writeMappedStore() over a backing store,
+     * privately, so that its pages are only read in when they are first
+     * touched, and copied when they are first written. A shared backing
+     * store is read from the file instead, as it must stay shared.
+     */
+    void mapStore(const std::string &filepath, const std::string &filename,
+                  const BackingStoreEntry &store);
+
 };
 
 } // namespace memory
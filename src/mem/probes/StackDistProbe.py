@@ -53,6 +53,19 @@ class StackDistProbe(BaseMemProbe):
     # enable verification stack
     verify = Param.Bool(False, "Verify behaviuor with reference implementation")
 
+    # sample the lines as in SHARDS, scaling the stack distances of the
+    # sampled lines up by the sampling rate, and lower the rate once the
+    # stack holds the maximum number of lines, if any
+    sampling_rate = Param.Float(1.0, "Fraction of the lines sampled")
+    max_sampled_lines = Param.Unsigned(0, "Lines in the stack at most, "
+                                       "or 0 for no bound")
+
+    # miss ratios of fully associative LRU caches, which a line misses in
+    # when its stack distance is at least their number of lines
+    miss_ratio_sizes = VectorParam.MemorySize(['16KiB', '32KiB', '64KiB',
+        '128KiB', '256KiB', '512KiB', '1MiB', '2MiB', '4MiB', '8MiB',
+        '16MiB', '32MiB'], "Cache sizes of the miss ratio curve")
+
     # linear histogram bins and enable/disable
     linear_hist_bins = Param.Unsigned('16', "Bins in linear histograms")
     disable_linear_hists = Param.Bool(False, "Disable linear histograms")
@@ -48,12 +48,23 @@ StackDistProbe::StackDistProbe(const StackDistProbeParams &p)
       lineSize(p.line_size),
       disableLinearHists(p.disable_linear_hists),
       disableLogHists(p.disable_log_hists),
-      calc(p.verify),
+      verify(p.verify),
+      calc(p.sampling_rate, p.max_sampled_lines),
+      refCalc(p.verify),
       stats(this)
 {
     fatal_if(p.system->cacheLineSize() > p.line_size,
              "The stack distance probe must use a cache line size that is "
              "larger or equal to the system's cahce line size.");
+    fatal_if(verify && (p.sampling_rate != 1 || p.max_sampled_lines),
+             "The stack distance probe can only be verified without "
+             "sampling.");
+    fatal_if(p.miss_ratio_sizes.empty(),
+             "The stack distance probe needs cache sizes for its miss "
+             "ratio curve.");
+
+    for (auto size : p.miss_ratio_sizes)
+        missRatioLines.push_back(size / lineSize);
 }
 
 StackDistProbe::StackDistProbeStats::StackDistProbeStats(
@@ -68,7 +79,16 @@ StackDistProbe::StackDistProbeStats::StackDistProbeStats(
       ADD_STAT(writeLogHist, statistics::units::Ratio::get(),
                "Writes logarithmic distribution"),
       ADD_STAT(infiniteSD, statistics::units::Count::get(),
-               "Number of requests with infinite stack distance")
+               "Number of requests with infinite stack distance"),
+      ADD_STAT(sampledReqs, statistics::units::Count::get(),
+               "Number of requests sampled"),
+      ADD_STAT(samplingRate, statistics::units::Ratio::get(),
+               "Fraction of the lines sampled"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of sampled requests missing in a fully associative "
+               "LRU cache of every size"),
+      ADD_STAT(missRatio, statistics::units::Ratio::get(),
+               "Miss ratio of a fully associative LRU cache of every size")
 {
     using namespace statistics;
 
@@ -93,6 +113,22 @@ StackDistProbe::StackDistProbeStats::StackDistProbeStats(
 
     infiniteSD
         .flags(nozero);
+
+    samplingRate
+        .functor([parent] { return parent->calc.samplingRate(); });
+
+    misses
+        .init(p.miss_ratio_sizes.size());
+
+    missRatio
+        .precision(4);
+    missRatio = misses / sampledReqs;
+
+    for (size_t i = 0; i < p.miss_ratio_sizes.size(); ++i) {
+        const std::string size = std::to_string(p.miss_ratio_sizes[i]);
+        misses.subname(i, size);
+        missRatio.subname(i, size);
+    }
 }
 
 void
@@ -107,8 +143,24 @@ StackDistProbe::handleRequest(const probing::PacketInfo &pkt_info)
     const Addr aligned_addr(roundDown(pkt_info.addr, lineSize));
 
     // Calculate the stack distance
-    const uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
-    if (sd == StackDistCalc::Infinity) {
+    const uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr));
+    if (verify) {
+        const uint64_t ref_sd(
+            refCalc.calcStackDistAndUpdate(aligned_addr).first);
+        panic_if(sd != ref_sd, "Stack distance of %#x is %d, expected %d",
+                 aligned_addr, sd, ref_sd);
+    }
+    if (sd == SampledStackDistCalc::Unsampled)
+        return;
+
+    // Count the misses of the sampled request in every cache size
+    stats.sampledReqs++;
+    for (size_t i = 0; i < missRatioLines.size(); ++i) {
+        if (sd >= missRatioLines[i])
+            stats.misses[i]++;
+    }
+
+    if (sd == SampledStackDistCalc::Infinity) {
         stats.infiniteSD++;
         return;
     }
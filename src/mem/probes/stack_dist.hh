@@ -38,8 +38,11 @@
 #ifndef __MEM_PROBES_STACK_DIST_HH__
 #define __MEM_PROBES_STACK_DIST_HH__
 
+#include <vector>
+
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
+#include "mem/sampled_stack_dist_calc.hh"
 #include "mem/stack_dist_calc.hh"
 #include "sim/stats.hh"
 
@@ -66,8 +69,17 @@ class StackDistProbe : public BaseMemProbe
     // Disable the logarithmic histograms
     const bool disableLogHists;
 
+    // Verify the stack distances with the reference implementation
+    const bool verify;
+
+    // Cache sizes of the miss ratio curve, in lines
+    std::vector<uint64_t> missRatioLines;
+
   protected:
-    StackDistCalc calc;
+    SampledStackDistCalc calc;
+
+    // Reference implementation, only used to verify
+    StackDistCalc refCalc;
 
     struct StackDistProbeStats : public statistics::Group
     {
@@ -87,6 +99,18 @@ class StackDistProbe : public BaseMemProbe
 
         // Writes logarithmic histogram
         statistics::Scalar infiniteSD;
+
+        // Requests sampled
+        statistics::Scalar sampledReqs;
+
+        // Current sampling rate
+        statistics::Value samplingRate;
+
+        // Sampled requests missing in a cache of every size
+        statistics::Vector misses;
+
+        // Miss ratio curve
+        statistics::Formula missRatio;
     } stats;
 };
 
@@ -77,6 +77,12 @@ class QoSMemCtrl(ClockedObject):
     qos_priority_escalation = Param.Bool(False,
         "Enables QoS priority escalation")
 
+    # Buckets of the per-requestor request to response latency histograms
+    qos_latency_bucket = Param.Latency('10ns',
+        "Width of the buckets of the per-requestor latency histograms")
+    qos_latency_buckets = Param.Unsigned(100,
+        "Number of buckets of the per-requestor latency histograms")
+
     # Requestor ID to be mapped to service parameters in QoS schedulers
     qos_requestors = VectorParam.String(['']* 16,
         "Requestor Names to be mapped to service parameters in QoS scheduler")
@@ -121,3 +121,52 @@ class QoSPropFairPolicy(QoSPolicy):
                         request_port.getCCObject(), float(score))
 
     weight = Param.Float(0.5, "Pf score weight")
+
+class QoSBandwidthPolicy(QoSPolicy):
+    type = 'QoSBandwidthPolicy'
+    cxx_header = "mem/qos/policy_bw.hh"
+    cxx_class = 'gem5::memory::qos::BandwidthPolicy'
+
+    cxx_exports = [
+        PyBindMethod('initRequestorName'),
+        PyBindMethod('initRequestorObj'),
+    ]
+
+    _requestor_bandwidths = None
+
+    def setRequestorBandwidth(self, request_port, min_bw='0B/s',
+                              max_bw='0B/s', burst=None):
+        """Guarantees min_bw to a requestor and regulates it to max_bw,
+        either of which may be zero for no guarantee or no limit."""
+        if not self._requestor_bandwidths:
+            self._requestor_bandwidths = []
+
+        self._requestor_bandwidths.append(
+            [request_port, min_bw, max_bw, burst])
+
+    def init(self):
+        if not self._requestor_bandwidths:
+            return
+
+        for bw in self._requestor_bandwidths:
+            request_port = bw[0]
+            # the bandwidths are passed in ticks per byte, like the params
+            min_bw = MemoryBandwidth(bw[1]).getValue()
+            max_bw = MemoryBandwidth(bw[2]).getValue()
+            burst = MemorySize(bw[3] if bw[3] is not None
+                               else self.burst_size).getValue()
+            if isinstance(request_port, str):
+                self.getCCObject().initRequestorName(
+                    request_port, min_bw, max_bw, burst)
+            else:
+                self.getCCObject().initRequestorObj(
+                    request_port.getCCObject(), min_bw, max_bw, burst)
+
+    # bandwidths of the requestors that are not set, none by default
+    default_min_bw = Param.MemoryBandwidth('0B/s',
+        "Bandwidth guaranteed to non-listed requestors")
+    default_max_bw = Param.MemoryBandwidth('0B/s',
+        "Bandwidth non-listed requestors are regulated to (0 for none)")
+
+    burst_size = Param.MemorySize('4KiB',
+        "Bytes a requestor may take at once beyond its bandwidths")
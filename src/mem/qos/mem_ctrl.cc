@@ -60,11 +60,16 @@ MemCtrl::MemCtrl(const QoSMemCtrlParams &p)
     _numPriorities(p.qos_priorities),
     qosPriorityEscalation(p.qos_priority_escalation),
     qosSyncroScheduler(p.qos_syncro_scheduler),
+    latencyBucket(p.qos_latency_bucket),
+    latencyBuckets(p.qos_latency_buckets),
     totalReadQueueSize(0), totalWriteQueueSize(0),
     busState(READ), busStateNext(READ),
     stats(*this),
     _system(p.system)
 {
+    fatal_if(latencyBucket == 0 || latencyBuckets == 0,
+             "The latency histograms need buckets of a non-zero width");
+
     // Set the priority policy
     if (policy) {
         policy->setMemCtrl(this);
@@ -147,7 +152,7 @@ MemCtrl::logRequest(BusState dir, RequestorID id, uint8_t _qos,
 
 void
 MemCtrl::logResponse(BusState dir, RequestorID id, uint8_t _qos,
-                     Addr addr, uint64_t entries, double delay)
+                     Addr addr, uint64_t entries, Tick ready_time)
 {
     panic_if(!hasRequestor(id),
         "Logging response with invalid requestor\n");
@@ -190,9 +195,12 @@ MemCtrl::logResponse(BusState dir, RequestorID id, uint8_t _qos,
         if (it->second.empty()) {
             requestTimes[id].erase(it);
         }
-        // Compute latency
-        double latency = (double) (curTick() + delay - requestTime)
-                / sim_clock::as_float::s;
+        // Compute latency, from the request to the response being
+        // ready, which already accounts for the time spent queued
+        const Tick latency_ticks = ready_time - requestTime;
+        double latency = (double) latency_ticks / sim_clock::as_float::s;
+
+        stats.requestorLatency[id].sample(latency_ticks);
 
         if (latency > 0) {
             // Record per-priority latency stats
@@ -299,6 +307,8 @@ MemCtrl::MemCtrlStats::MemCtrlStats(MemCtrl &mc)
              "per QoS priority minimum request to response latency"),
     ADD_STAT(priorityMaxLatency, statistics::units::Second::get(),
              "per QoS priority maximum request to response latency"),
+    ADD_STAT(requestorLatency, statistics::units::Tick::get(),
+             "per requestor request to response latency distribution"),
     ADD_STAT(numReadWriteTurnArounds, statistics::units::Count::get(),
              "Number of turnarounds from READ to WRITE"),
     ADD_STAT(numWriteReadTurnArounds, statistics::units::Count::get(),
@@ -343,10 +353,18 @@ MemCtrl::MemCtrlStats::regStats()
         .precision(12)
         ;
 
+    requestorLatency
+        .init(max_requestors, 0,
+              memCtrl.latencyBucket * memCtrl.latencyBuckets - 1,
+              memCtrl.latencyBucket)
+        .flags(nozero | nonan)
+        ;
+
     for (int i = 0; i < max_requestors; i++) {
         const std::string name = system->getRequestorName(i);
         avgPriority.subname(i, name);
         avgPriorityDistance.subname(i, name);
+        requestorLatency.subname(i, name);
     }
 
     for (int j = 0; j < num_priorities; ++j) {
@@ -105,6 +105,12 @@ class MemCtrl : public ClockedObject
      */
     const bool qosSyncroScheduler;
 
+    /** Width of the buckets of the per-requestor latency histograms */
+    const Tick latencyBucket;
+
+    /** Number of buckets of the per-requestor latency histograms */
+    const unsigned latencyBuckets;
+
     /** Hash of requestor ID - requestor name */
     std::unordered_map<RequestorID, const std::string> requestors;
 
@@ -162,6 +168,8 @@ class MemCtrl : public ClockedObject
         statistics::Vector priorityMinLatency;
         /** per-priority maximum latency */
         statistics::Vector priorityMaxLatency;
+        /** per-requestor request to response latency histogram */
+        statistics::VectorDistribution requestorLatency;
         /** Count the number of turnarounds READ to WRITE */
         statistics::Scalar numReadWriteTurnArounds;
         /** Count the number of turnarounds WRITE to READ */
@@ -205,10 +213,10 @@ class MemCtrl : public ClockedObject
      * @param _qos packet QoS value
      * @param addr packet address
      * @param entries number of entries to record
-     * @param delay response delay
+     * @param ready_time tick at which the response is ready
      */
     void logResponse(BusState dir, RequestorID id, uint8_t _qos,
-                     Addr addr, uint64_t entries, double delay);
+                     Addr addr, uint64_t entries, Tick ready_time);
 
     /**
      * Assign priority to a packet by executing
@@ -300,7 +300,7 @@ MemSinkCtrl::processNextReqEvent()
                 pkt->req->requestorId(),
                 pkt->qosValue(),
                 pkt->getAddr(),
-                removed_entries, responseLatency);
+                removed_entries, curTick() + responseLatency);
 
     // Schedule the response
     port.schedTimingResp(pkt, curTick() + responseLatency);
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/qos/policy_bw.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/QOS.hh"
+#include "params/QoSBandwidthPolicy.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+GEM5_DEPRECATED_NAMESPACE(QoS, qos);
+namespace qos
+{
+
+BandwidthPolicy::BandwidthPolicy(const Params &p)
+  : Policy(p), defaultMinBw(p.default_min_bw),
+    defaultMaxBw(p.default_max_bw), defaultBurst(p.burst_size),
+    stats(*this)
+{
+    // Check the defaults the same way as any other requestor
+    makeBucket(defaultMinBw, defaultMaxBw, defaultBurst);
+}
+
+BandwidthPolicy::~BandwidthPolicy()
+{}
+
+void
+BandwidthPolicy::init()
+{
+    fatal_if(memCtrl->numPriorities() < 3,
+             "%s needs at least 3 QoS priorities in the memory controller",
+             name());
+}
+
+void
+BandwidthPolicy::regStats()
+{
+    // Unlike the base policy, register the stats of this one
+    statistics::Group::regStats();
+}
+
+BandwidthPolicy::Bucket
+BandwidthPolicy::makeBucket(double min_bw, double max_bw, uint64_t burst)
+{
+    fatal_if(burst == 0, "The burst size of a bandwidth bucket is zero");
+
+    // A zero bandwidth in ticks per byte is a zero (or unset) rate
+    Bucket bucket;
+    bucket.minRate = min_bw ? 1.0 / min_bw : 0;
+    bucket.maxRate = max_bw ? 1.0 / max_bw : 0;
+    bucket.burst = burst;
+
+    fatal_if(bucket.maxRate && bucket.minRate > bucket.maxRate,
+             "The guaranteed bandwidth is above the maximum bandwidth");
+
+    // Start with full buckets, as after a long idle period
+    bucket.minTokens = bucket.burst;
+    bucket.maxTokens = bucket.burst;
+    bucket.lastFill = curTick();
+    return bucket;
+}
+
+template <typename Requestor>
+void
+BandwidthPolicy::initRequestor(const Requestor requestor, double min_bw,
+                               double max_bw, uint64_t burst)
+{
+    RequestorID id = memCtrl->system()->lookupRequestorId(requestor);
+
+    panic_if(id == Request::invldRequestorId,
+             "Unable to find requestor %s\n", requestor);
+
+    buckets[id] = makeBucket(min_bw, max_bw, burst);
+}
+
+void
+BandwidthPolicy::initRequestorName(std::string requestor, double min_bw,
+                                   double max_bw, uint64_t burst)
+{
+    initRequestor(requestor, min_bw, max_bw, burst);
+}
+
+void
+BandwidthPolicy::initRequestorObj(const SimObject* requestor, double min_bw,
+                                  double max_bw, uint64_t burst)
+{
+    initRequestor(requestor, min_bw, max_bw, burst);
+}
+
+void
+BandwidthPolicy::fill(Bucket &bucket)
+{
+    const double elapsed = curTick() - bucket.lastFill;
+    bucket.lastFill = curTick();
+    bucket.minTokens = std::min(bucket.burst,
+                                bucket.minTokens + elapsed * bucket.minRate);
+    bucket.maxTokens = std::min(bucket.burst,
+                                bucket.maxTokens + elapsed * bucket.maxRate);
+}
+
+uint8_t
+BandwidthPolicy::schedule(const RequestorID id, const uint64_t pkt_size)
+{
+    auto it = buckets.find(id);
+    if (it == buckets.end()) {
+        DPRINTF(QOS, "Requestor %s (RequestorID %d) has no bandwidth set, "
+                "assigning the default ones\n",
+                memCtrl->system()->getRequestorName(id), id);
+        it = buckets.emplace(id, makeBucket(defaultMinBw, defaultMaxBw,
+                                            defaultBurst)).first;
+    }
+
+    Bucket &bucket = it->second;
+    fill(bucket);
+
+    // A zero size, as scheduled by the synchronized scheduler, only
+    // tells whether there are tokens left
+    const double size = std::max<uint64_t>(pkt_size, 1);
+    const uint8_t top = memCtrl->numPriorities() - 1;
+    uint8_t priority;
+    if (bucket.minRate && bucket.minTokens >= size) {
+        priority = top;
+        bucket.minTokens -= pkt_size;
+        stats.guaranteedBytes[id] += pkt_size;
+    } else if (!bucket.maxRate || bucket.maxTokens >= size) {
+        priority = top - 1;
+        stats.regulatedBytes[id] += pkt_size;
+    } else {
+        priority = 0;
+        stats.throttledBytes[id] += pkt_size;
+    }
+
+    // Whatever is served counts against the maximum, but the debt of a
+    // requestor that had the memory to itself is bounded by the burst, so
+    // that it is not throttled for long once others compete with it
+    if (bucket.maxRate) {
+        bucket.maxTokens = std::max(-bucket.burst,
+                                    bucket.maxTokens - pkt_size);
+    }
+
+    DPRINTF(QOS, "Requestor %s (RequestorID %d) scheduled %d bytes at "
+            "priority %d, tokens left: %f guaranteed, %f maximum\n",
+            memCtrl->system()->getRequestorName(id), id, pkt_size, priority,
+            bucket.minTokens, bucket.maxTokens);
+
+    return priority;
+}
+
+BandwidthPolicy::BandwidthPolicyStats::BandwidthPolicyStats(
+    BandwidthPolicy &_policy)
+  : statistics::Group(&_policy),
+    policy(_policy),
+    ADD_STAT(guaranteedBytes, statistics::units::Byte::get(),
+             "Bytes scheduled within the guaranteed bandwidth"),
+    ADD_STAT(regulatedBytes, statistics::units::Byte::get(),
+             "Bytes scheduled within the maximum bandwidth"),
+    ADD_STAT(throttledBytes, statistics::units::Byte::get(),
+             "Bytes scheduled over the maximum bandwidth")
+{
+}
+
+void
+BandwidthPolicy::BandwidthPolicyStats::regStats()
+{
+    statistics::Group::regStats();
+
+    using namespace statistics;
+
+    System *system = policy.memCtrl->system();
+    const auto max_requestors = system->maxRequestors();
+
+    guaranteedBytes.init(max_requestors).flags(nozero);
+    regulatedBytes.init(max_requestors).flags(nozero);
+    throttledBytes.init(max_requestors).flags(nozero);
+
+    for (int i = 0; i < max_requestors; i++) {
+        const std::string name = system->getRequestorName(i);
+        guaranteedBytes.subname(i, name);
+        regulatedBytes.subname(i, name);
+        throttledBytes.subname(i, name);
+    }
+}
+
+} // namespace qos
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declares a QoS policy that regulates the memory bandwidth of each
+ * requestor with token buckets, much like the memory bandwidth
+ * partitioning of Arm MPAM.
+ */
+
+#ifndef __MEM_QOS_POLICY_BW_HH__
+#define __MEM_QOS_POLICY_BW_HH__
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "base/compiler.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/qos/policy.hh"
+#include "mem/request.hh"
+
+namespace gem5
+{
+
+struct QoSBandwidthPolicyParams;
+
+namespace memory
+{
+
+GEM5_DEPRECATED_NAMESPACE(QoS, qos);
+namespace qos
+{
+
+/**
+ * Bandwidth Regulation QoS Policy
+ *
+ * Every requestor has a minimum bandwidth it is guaranteed and a maximum
+ * bandwidth it is regulated to, each tracked by a token bucket that fills
+ * at that rate up to a burst size, and that the bytes the requestor asks
+ * for are taken from. A packet gets one of three priorities:
+ *
+ * - the highest one, while the requestor is within its guarantee;
+ * - the next to highest one, while it is within its maximum bandwidth;
+ * - the lowest one, once it is over its maximum bandwidth.
+ *
+ * The regulation is work conserving, like the soft limits of MPAM: a
+ * requestor over its maximum is only served after everyone else, rather
+ * than not at all. With priority escalation enabled in the controller,
+ * the packets already queued follow the priority of their requestor.
+ *
+ * A zero minimum bandwidth gives no guarantee, and a zero maximum
+ * bandwidth no limit.
+ */
+class BandwidthPolicy : public Policy
+{
+    using Params = QoSBandwidthPolicyParams;
+
+  public:
+    BandwidthPolicy(const Params &);
+    virtual ~BandwidthPolicy();
+
+    void init() override;
+
+    void regStats() override;
+
+    /**
+     * Sets the bandwidths of a requestor given by its name, which has
+     * to match a name in the system.
+     *
+     * @param requestor requestor's name to lookup.
+     * @param min_bw guaranteed bandwidth, in ticks per byte
+     * @param max_bw maximum bandwidth, in ticks per byte
+     * @param burst size of the buckets, in bytes
+     */
+    void initRequestorName(std::string requestor, double min_bw,
+                           double max_bw, uint64_t burst);
+
+    /**
+     * Sets the bandwidths of a requestor given by its SimObject.
+     *
+     * @param requestor requestor's SimObject pointer to lookup.
+     * @param min_bw guaranteed bandwidth, in ticks per byte
+     * @param max_bw maximum bandwidth, in ticks per byte
+     * @param burst size of the buckets, in bytes
+     */
+    void initRequestorObj(const SimObject* requestor, double min_bw,
+                          double max_bw, uint64_t burst);
+
+    /**
+     * Schedules a packet by charging its bytes to the buckets of its
+     * requestor.
+     *
+     * @param id requestor id to schedule
+     * @param pkt_size size of the packet
+     * @return QoS priority value
+     */
+    virtual uint8_t
+    schedule(const RequestorID id, const uint64_t pkt_size) override;
+
+  protected:
+    /** The regulation of a requestor. */
+    struct Bucket
+    {
+        /** Guaranteed bandwidth, in bytes per tick. */
+        double minRate;
+        /** Maximum bandwidth, in bytes per tick, or zero for none. */
+        double maxRate;
+        /** Size of both buckets, in bytes. */
+        double burst;
+        /** Bytes left of the guarantee. */
+        double minTokens;
+        /**
+         * Bytes left until the maximum, negative when the requestor
+         * was served beyond it.
+         */
+        double maxTokens;
+        /** Last time the buckets were filled. */
+        Tick lastFill;
+    };
+
+    template <typename Requestor>
+    void initRequestor(const Requestor requestor, double min_bw,
+                       double max_bw, uint64_t burst);
+
+    /** @return A bucket with the given bandwidths, in ticks per byte. */
+    static Bucket makeBucket(double min_bw, double max_bw, uint64_t burst);
+
+    /** Fills the buckets for the time elapsed since they last were. */
+    static void fill(Bucket &bucket);
+
+    /** Bandwidths of the requestors that are not set, in ticks per byte. */
+    const double defaultMinBw;
+    const double defaultMaxBw;
+    const uint64_t defaultBurst;
+
+    /** The regulation of every requestor seen so far. */
+    std::unordered_map<RequestorID, Bucket> buckets;
+
+    struct BandwidthPolicyStats : public statistics::Group
+    {
+        BandwidthPolicyStats(BandwidthPolicy &policy);
+
+        void regStats() override;
+
+        const BandwidthPolicy &policy;
+
+        /** Bytes scheduled within the guarantee, per requestor. */
+        statistics::Vector guaranteedBytes;
+        /** Bytes scheduled within the maximum, per requestor. */
+        statistics::Vector regulatedBytes;
+        /** Bytes scheduled over the maximum, per requestor. */
+        statistics::Vector throttledBytes;
+    } stats;
+};
+
+} // namespace qos
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_QOS_POLICY_BW_HH__
@@ -54,11 +54,16 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "base/amo.hh"
+#include "base/block_pool.hh"
 #include "base/compiler.hh"
 #include "base/flags.hh"
+#include "base/inline_vector.hh"
+#include "base/logging.hh"
+#include "base/refcnt.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
 #include "mem/htm.hh"
@@ -91,10 +96,16 @@ class Packet;
 class Request;
 class ThreadContext;
 
-typedef std::shared_ptr<Request> RequestPtr;
+/**
+ * Requests are shared by all the packets of a transaction through an
+ * intrusive, non-atomic, reference count. A transaction is only ever
+ * handled by one thread at a time, as the event queues hand packets over
+ * with their locks held.
+ */
+typedef RefCountingPtr<Request> RequestPtr;
 typedef uint16_t RequestorID;
 
-class Request
+class Request : public RefCounted
 {
   public:
     typedef uint64_t FlagsType;
@@ -470,6 +481,15 @@ class Request
     /** The cause for HTM transaction abort */
     HtmFailureFaultCause _htmAbortCause = HtmFailureFaultCause::INVALID;
 
+    /**
+     * The ports the crossbars on the way of this request route its
+     * responses back through, by crossbar tag. They are kept here, rather
+     * than in the packets, as all the packets of a transaction share the
+     * request, including those the caches create to respond to snoops. A
+     * copy of the request is a new transaction, and starts without any.
+     */
+    InlineVector<std::pair<uint32_t, PortID>, 4> routes;
+
   public:
 
     /**
@@ -522,6 +542,30 @@ class Request
 
     ~Request() {}
 
+    /** Requests come from a per-thread pool rather than the heap. */
+    static void *
+    operator new(std::size_t size)
+    {
+        assert(size == sizeof(Request));
+        return BlockPool<sizeof(Request), alignof(Request)>::allocate();
+    }
+
+    static void
+    operator delete(void *ptr)
+    {
+        BlockPool<sizeof(Request), alignof(Request)>::deallocate(ptr);
+    }
+
+    /**
+     * Create a new request, taking the constructor arguments.
+     */
+    template <typename... Args>
+    static RequestPtr
+    create(Args&&... args)
+    {
+        return RequestPtr(new Request(std::forward<Args>(args)...));
+    }
+
     /**
      * Factory method for creating memory management requests, with
      * unspecified addr and size.
@@ -529,7 +573,7 @@ class Request
     static RequestPtr
     createMemManagement(Flags flags, RequestorID id)
     {
-        auto mgmt_req = std::make_shared<Request>();
+        auto mgmt_req = create();
         mgmt_req->_flags.set(flags);
         mgmt_req->_requestorId = id;
         mgmt_req->_time = curTick();
@@ -611,8 +655,8 @@ class Request
         assert(hasVaddr());
         assert(!hasPaddr());
         assert(split_addr > _vaddr && split_addr < _vaddr + _size);
-        req1 = std::make_shared<Request>(*this);
-        req2 = std::make_shared<Request>(*this);
+        req1 = Request::create(*this);
+        req2 = Request::create(*this);
         req1->_size = split_addr - _vaddr;
         req2->_vaddr = split_addr;
         req2->_size = _size - req1->_size;
@@ -963,6 +1007,43 @@ class Request
     void incAccessDepth() const { depth++; }
     int getAccessDepth() const { return depth; }
 
+    /**
+     * Set/Get/Clear the port a crossbar routes the response to this
+     * request through. A crossbar routes at most one response per request
+     * at a time.
+     *
+     * @param xbar The route tag of the crossbar.
+     */
+    void
+    setRoute(uint32_t xbar, PortID port)
+    {
+        assert(getRoute(xbar) == InvalidPortID);
+        routes.emplace_back(xbar, port);
+    }
+
+    /** @return The port, or InvalidPortID if the crossbar has none. */
+    PortID
+    getRoute(uint32_t xbar) const
+    {
+        for (const auto &route : routes) {
+            if (route.first == xbar)
+                return route.second;
+        }
+        return InvalidPortID;
+    }
+
+    void
+    clearRoute(uint32_t xbar)
+    {
+        for (auto it = routes.begin(); it != routes.end(); ++it) {
+            if (it->first == xbar) {
+                routes.erase(it);
+                return;
+            }
+        }
+        panic("No route of crossbar %d to clear\n", xbar);
+    }
+
     /**
      * Set/Get the time taken for this request to be successfully translated.
      */
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/sampled_stack_dist_calc.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** Slots the tree has at least, so that it is not compacted too often. */
+constexpr uint64_t MinSlots = 1024;
+
+} // anonymous namespace
+
+SampledStackDistCalc::SampledStackDistCalc(double sampling_rate,
+                                           size_t max_addrs)
+    : maxAddrs(max_addrs),
+      threshold(std::llround(sampling_rate * HashModulus)),
+      slotAddr(MinSlots), tree(MinSlots + 1, 0), nextSlot(0)
+{
+    fatal_if(!(sampling_rate > 0 && sampling_rate <= 1),
+             "The stack distance sampling rate must be in (0, 1], not %f.",
+             sampling_rate);
+}
+
+void
+SampledStackDistCalc::add(uint64_t slot, int64_t value)
+{
+    for (uint64_t i = slot + 1; i < tree.size(); i += i & -i)
+        tree[i] += value;
+}
+
+uint64_t
+SampledStackDistCalc::prefixSum(uint64_t slot) const
+{
+    uint64_t sum = 0;
+    for (uint64_t i = slot + 1; i > 0; i -= i & -i)
+        sum += tree[i];
+    return sum;
+}
+
+void
+SampledStackDistCalc::compact()
+{
+    // Renumber the slots in use in their order, which keeps the order
+    // of the stack
+    uint64_t used = 0;
+    for (uint64_t slot = 0; slot < nextSlot; ++slot) {
+        auto it = lastSlot.find(slotAddr[slot]);
+        if (it != lastSlot.end() && it->second == slot) {
+            it->second = used;
+            slotAddr[used++] = it->first;
+        }
+    }
+    assert(used == lastSlot.size());
+    nextSlot = used;
+
+    // Leave as many slots free as there are in use, so that compacting
+    // takes O(1) per access amortized
+    const uint64_t slots = std::max(2 * used, MinSlots);
+    slotAddr.resize(slots);
+
+    // Build the tree in linear time, every slot in use counting one
+    tree.assign(slots + 1, 0);
+    for (uint64_t i = 1; i <= slots; ++i) {
+        tree[i] += i <= used;
+        const uint64_t parent = i + (i & -i);
+        if (parent <= slots)
+            tree[parent] += tree[i];
+    }
+}
+
+void
+SampledStackDistCalc::evict()
+{
+    while (lastSlot.size() > maxAddrs) {
+        // Lower the threshold to the highest hash, evicting all the
+        // addresses that have it
+        threshold = hashes.top().first;
+        while (!hashes.empty() && hashes.top().first >= threshold) {
+            auto it = lastSlot.find(hashes.top().second);
+            add(it->second, -1);
+            lastSlot.erase(it);
+            hashes.pop();
+        }
+    }
+}
+
+uint64_t
+SampledStackDistCalc::calcStackDistAndUpdate(const Addr r_address)
+{
+    const uint64_t addr_hash = hash(r_address);
+    if (addr_hash >= threshold)
+        return Unsampled;
+
+    if (nextSlot == slotAddr.size())
+        compact();
+
+    uint64_t stack_dist = Infinity;
+    auto it = lastSlot.find(r_address);
+    if (it != lastSlot.end()) {
+        // The addresses after this one in the stack are the slots in
+        // use after its own
+        const uint64_t dist = lastSlot.size() - prefixSum(it->second);
+        add(it->second, -1);
+        it->second = nextSlot;
+
+        // Scale the distance up by the sampling rate
+        stack_dist = std::llround(dist / samplingRate());
+    } else {
+        lastSlot.emplace(r_address, nextSlot);
+        if (maxAddrs)
+            hashes.emplace(addr_hash, r_address);
+    }
+
+    slotAddr[nextSlot] = r_address;
+    add(nextSlot, 1);
+    ++nextSlot;
+
+    if (maxAddrs && lastSlot.size() > maxAddrs)
+        evict();
+
+    return stack_dist;
+}
+
+} // namespace gem5
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declares a stack distance calculator that takes O(log n) per access,
+ * and can sample the addresses to bound its memory.
+ */
+
+#ifndef __MEM_SAMPLED_STACK_DIST_CALC_HH__
+#define __MEM_SAMPLED_STACK_DIST_CALC_HH__
+
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * The sampled stack distance calculator gives the stack distance of
+ * every address it is passed, as the number of unique addresses passed
+ * since the last time it was, like StackDistCalc does, but in O(log n)
+ * time for n addresses in the stack.
+ *
+ * Every address in the stack has a slot, which is the time it was last
+ * passed at, and a Fenwick tree counts the slots in use. The stack
+ * distance of an address is then the number of slots in use after its
+ * own, which the tree gives as a prefix sum. The slots are renumbered
+ * once they run out, which keeps the tree twice the size of the stack
+ * at most however long the run.
+ *
+ * To bound the size of the stack, the addresses can be sampled as in
+ * SHARDS (Waldspurger et al., FAST'15): only the addresses whose hash
+ * is below a threshold go in the stack, the hashes being uniform, and
+ * the stack distances of the sampled addresses are scaled up by the
+ * sampling rate. With a maximum number of addresses in the stack, the
+ * threshold is lowered to the hash of the address with the highest one
+ * whenever the stack goes over that number, evicting the address, so
+ * that the rate adapts to the footprint of the run.
+ */
+class SampledStackDistCalc
+{
+  public:
+    /**
+     * @param sampling_rate Fraction of the addresses to sample, in
+     *        (0, 1], where 1 samples all of them
+     * @param max_addrs Addresses in the stack at most, or 0 for no bound
+     */
+    SampledStackDistCalc(double sampling_rate = 1.0, size_t max_addrs = 0);
+
+    /**
+     * A convenient way of refering to infinity.
+     */
+    static constexpr uint64_t Infinity = std::numeric_limits<uint64_t>::max();
+
+    /**
+     * The stack distance of an address that is not sampled.
+     */
+    static constexpr uint64_t Unsampled = Infinity - 1;
+
+    /**
+     * Process the given address, moving it to the top of the stack if
+     * it is sampled.
+     *
+     * @param r_address The current address to process
+     * @return The stack distance of the address, scaled by the sampling
+     *         rate, Infinity if it was not in the stack, or Unsampled
+     */
+    uint64_t calcStackDistAndUpdate(const Addr r_address);
+
+    /** @return The current sampling rate. */
+    double
+    samplingRate() const
+    {
+        return double(threshold) / HashModulus;
+    }
+
+    /** @return The number of addresses in the stack. */
+    size_t stackSize() const { return lastSlot.size(); }
+
+  private:
+    /** The hashes are taken modulo this, and compared to the threshold. */
+    static constexpr uint64_t HashModulus = uint64_t(1) << 32;
+
+    /** @return A uniform hash of an address, below HashModulus. */
+    static uint64_t
+    hash(Addr addr)
+    {
+        // the finalizer of MurmurHash3
+        addr ^= addr >> 33;
+        addr *= 0xff51afd7ed558ccdULL;
+        addr ^= addr >> 33;
+        addr *= 0xc4ceb9fe1a85ec53ULL;
+        addr ^= addr >> 33;
+        return addr & (HashModulus - 1);
+    }
+
+    /** Add a value to the count of a slot in the tree. */
+    void add(uint64_t slot, int64_t value);
+
+    /** @return The number of slots in use up to a slot, included. */
+    uint64_t prefixSum(uint64_t slot) const;
+
+    /** Renumber the slots in use, and resize the tree to the stack. */
+    void compact();
+
+    /** Evict the addresses of the highest hashes, lowering the rate. */
+    void evict();
+
+    /** Addresses in the stack at most, or 0 for no bound. */
+    const size_t maxAddrs;
+
+    /** The addresses sampled have a hash below the threshold. */
+    uint64_t threshold;
+
+    /** Slot of every address in the stack. */
+    std::unordered_map<Addr, uint64_t> lastSlot;
+
+    /** Address of every slot, whether in use or not. */
+    std::vector<Addr> slotAddr;
+
+    /** Fenwick tree of the slots in use, indexed from 1. */
+    std::vector<uint64_t> tree;
+
+    /** Next slot to use, slots being used in the order of time. */
+    uint64_t nextSlot;
+
+    /**
+     * The addresses in the stack by their hash, highest first, when the
+     * stack has a maximum size.
+     */
+    std::priority_queue<std::pair<uint64_t, Addr>> hashes;
+};
+
+} // namespace gem5
+
+#endif //__MEM_SAMPLED_STACK_DIST_CALC_HH__
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "mem/sampled_stack_dist_calc.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** A naive stack, the top of which is its back. */
+uint64_t
+naiveStackDist(std::vector<Addr> &stack, Addr addr)
+{
+    auto it = std::find(stack.begin(), stack.end(), addr);
+    uint64_t dist = SampledStackDistCalc::Infinity;
+    if (it != stack.end()) {
+        dist = stack.end() - it - 1;
+        stack.erase(it);
+    }
+    stack.push_back(addr);
+    return dist;
+}
+
+} // anonymous namespace
+
+TEST(SampledStackDistCalcTest, Distances)
+{
+    SampledStackDistCalc calc;
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0xa0),
+              SampledStackDistCalc::Infinity);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0xa0), 0);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0xb0),
+              SampledStackDistCalc::Infinity);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0xc0),
+              SampledStackDistCalc::Infinity);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0xb0), 1);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0xa0), 2);
+    EXPECT_EQ(calc.stackSize(), 3);
+}
+
+TEST(SampledStackDistCalcTest, MatchesNaiveStack)
+{
+    // Enough accesses for the slots to be renumbered many times
+    SampledStackDistCalc calc;
+    std::vector<Addr> stack;
+    std::mt19937_64 rng(1);
+    std::geometric_distribution<Addr> dist(0.002);
+    for (int i = 0; i < 100000; ++i) {
+        const Addr addr = dist(rng) * 64;
+        ASSERT_EQ(calc.calcStackDistAndUpdate(addr),
+                  naiveStackDist(stack, addr)) << "access " << i;
+    }
+    EXPECT_EQ(calc.stackSize(), stack.size());
+}
+
+TEST(SampledStackDistCalcTest, Sampling)
+{
+    SampledStackDistCalc calc(0.25);
+    const int addrs = 40000;
+    int sampled = 0;
+    for (int i = 0; i < addrs; ++i) {
+        if (calc.calcStackDistAndUpdate(i * 64) !=
+            SampledStackDistCalc::Unsampled) {
+            ++sampled;
+        }
+    }
+    EXPECT_NEAR(sampled, addrs / 4, addrs / 40);
+
+    // A loop over all the addresses reuses every sampled one at about
+    // the number of addresses
+    for (int i = 0; i < addrs; ++i) {
+        const uint64_t sd = calc.calcStackDistAndUpdate(i * 64);
+        if (sd != SampledStackDistCalc::Unsampled) {
+            EXPECT_NEAR(sd, addrs, addrs / 10);
+        }
+    }
+}
+
+TEST(SampledStackDistCalcTest, BoundedStack)
+{
+    SampledStackDistCalc calc(1.0, 1000);
+    const int addrs = 100000;
+    for (int loop = 0; loop < 2; ++loop) {
+        for (int i = 0; i < addrs; ++i) {
+            const uint64_t sd = calc.calcStackDistAndUpdate(i * 64);
+            if (loop && sd != SampledStackDistCalc::Unsampled) {
+                EXPECT_NEAR(sd, addrs, addrs / 5);
+            }
+        }
+    }
+    EXPECT_LE(calc.stackSize(), 1000);
+    EXPECT_NEAR(calc.samplingRate(), 0.01, 0.002);
+}
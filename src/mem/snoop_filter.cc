@@ -42,9 +42,11 @@
 
 #include "mem/snoop_filter.hh"
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/SnoopFilter.hh"
+#include "mem/cache/replacement_policies/base.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -52,12 +54,111 @@ namespace gem5
 
 const int SnoopFilter::SNOOP_MASK_SIZE;
 
+SnoopFilter::SnoopFilter(const SnoopFilterParams &p)
+    : SimObject(p), reqLookupResult{invalidLine, SnoopItem()},
+      linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
+      maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
+      assoc(p.assoc), replacementPolicy(p.replacement_policy),
+      table(floorLog2(linesize), assoc ? maxEntryCount : 0,
+            checkedAssoc(p)),
+      stats(this)
+{
+    if (!bounded())
+        return;
+
+    fatal_if(!replacementPolicy,
+             "%s: a bounded snoop filter needs a replacement policy\n",
+             name());
+
+    const std::size_t num_sets = maxEntryCount / assoc;
+    replEntries.resize(maxEntryCount);
+    for (std::size_t set = 0; set < num_sets; set++) {
+        for (unsigned way = 0; way < assoc; way++) {
+            ReplaceableEntry &entry = replEntries[set * assoc + way];
+            entry.setPosition(set, way);
+            entry.replacementData = replacementPolicy->instantiateEntry();
+        }
+    }
+}
+
+unsigned
+SnoopFilter::checkedAssoc(const SnoopFilterParams &p)
+{
+    const unsigned max_entry_count =
+        p.max_capacity / p.system->cacheLineSize();
+    fatal_if(p.assoc && (max_entry_count % p.assoc != 0 ||
+                         !isPowerOf2(max_entry_count / p.assoc)),
+             "%s: the number of sets of the snoop filter must be a power "
+             "of 2, got %d lines of %d ways\n", p.name, max_entry_count,
+             p.assoc);
+    return p.assoc;
+}
+
+std::size_t
+SnoopFilter::allocateSlot(Addr line_addr)
+{
+    if (!bounded())
+        return table.insert(line_addr);
+
+    if (table.freeSlot(line_addr) == noSlot)
+        evictFromSet(table.setOf(line_addr));
+
+    const std::size_t slot = table.insert(line_addr);
+    replacementPolicy->reset(replEntries[slot].replacementData);
+    return slot;
+}
+
 void
-SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
+SnoopFilter::eraseSlot(std::size_t slot)
 {
-    SnoopItem& sf_item = sf_it->second;
+    table.erase(slot);
+    if (bounded())
+        replacementPolicy->invalidate(replEntries[slot].replacementData);
+}
+
+void
+SnoopFilter::evictFromSet(std::size_t set)
+{
+    // Lines with requests in flight will be updated by their responses
+    ReplacementCandidates candidates;
+    for (std::size_t way = set * assoc; way < (set + 1) * assoc; way++) {
+        if (table.item(way).requested.none())
+            candidates.push_back(&replEntries[way]);
+    }
+    panic_if(candidates.empty(), "all lines of snoop filter set %d have "
+             "requests in flight, increase its associativity\n", set);
+
+    const ReplaceableEntry *victim = replacementPolicy->getVictim(candidates);
+    const std::size_t slot = victim->getSet() * assoc + victim->getWay();
+    const Addr line_addr = table.lineAddr(slot);
+    const SnoopItem &sf_item = table.item(slot);
+
+    DPRINTF(SnoopFilter, "%s: evicting %#llx SF value %x.%x\n", __func__,
+            line_addr, sf_item.requested, sf_item.holder);
+
+    evictions.push_back(Eviction{line_addr & ~Addr(LineSecure),
+                                 bool(line_addr & LineSecure),
+                                 maskToPortList(sf_item.holder)});
+    stats.evictions++;
+    stats.backInvalidations += sf_item.holder.count();
+
+    eraseSlot(slot);
+}
+
+std::vector<SnoopFilter::Eviction>
+SnoopFilter::takeEvictions()
+{
+    std::vector<Eviction> evicted;
+    evicted.swap(evictions);
+    return evicted;
+}
+
+void
+SnoopFilter::eraseIfNullEntry(std::size_t slot)
+{
+    SnoopItem& sf_item = table.item(slot);
     if ((sf_item.requested | sf_item.holder).none()) {
-        cachedLocations.erase(sf_it);
+        eraseSlot(slot);
         DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
                 __func__);
     }
@@ -78,8 +179,9 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         line_addr |= LineSecure;
     }
     SnoopMask req_port = portToMask(cpu_side_port);
-    reqLookupResult.it = cachedLocations.find(line_addr);
-    bool is_hit = (reqLookupResult.it != cachedLocations.end());
+    std::size_t slot = table.find(line_addr);
+    bool is_hit = (slot != noSlot);
+    reqLookupResult.lineAddr = is_hit ? line_addr : invalidLine;
 
     // If the snoop filter has no entry, and we should not allocate,
     // do not create a new snoop filter entry, simply return a NULL
@@ -87,12 +189,20 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
     if (!is_hit && !allocate)
         return snoopDown(lookupLatency);
 
-    // If no hit in snoop filter create a new element and update iterator
+    // A bounded snoop filter may have evicted the line, and invalidated
+    // it above, while its eviction was on the way; there is nothing
+    // left to track
+    if (!is_hit && cpkt->isEviction() && bounded())
+        return snoopDown(lookupLatency);
+
+    // If no hit in snoop filter create a new element
     if (!is_hit) {
-        reqLookupResult.it =
-            cachedLocations.emplace(line_addr, SnoopItem()).first;
+        slot = allocateSlot(line_addr);
+        reqLookupResult.lineAddr = line_addr;
+    } else if (bounded()) {
+        replacementPolicy->touch(replEntries[slot].replacementData);
     }
-    SnoopItem& sf_item = reqLookupResult.it->second;
+    SnoopItem& sf_item = table.item(slot);
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -140,10 +250,11 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         }
     } else { // if (!cpkt->needsResponse())
         assert(cpkt->isEviction());
-        // make sure that the sender actually had the line
-        panic_if((sf_item.holder & req_port).none(), "requestor %x is not a " \
-                 "holder :( SF value %x.%x\n", req_port,
-                 sf_item.requested, sf_item.holder);
+        // make sure that the sender actually had the line, unless a
+        // bounded snoop filter evicted it since
+        panic_if(!bounded() && (sf_item.holder & req_port).none(),
+                 "requestor %x is not a holder :( SF value %x.%x\n",
+                 req_port, sf_item.requested, sf_item.holder);
         // CleanEvicts and Writebacks -> the sender and all caches above
         // it may not have the line anymore.
         if (!cpkt->isBlockCached()) {
@@ -159,26 +270,29 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
-    if (reqLookupResult.it != cachedLocations.end()) {
+    if (reqLookupResult.lineAddr != invalidLine) {
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
         Addr line_addr = (addr & ~(Addr(linesize - 1)));
         if (is_secure) {
             line_addr |= LineSecure;
         }
-        assert(reqLookupResult.it->first == line_addr);
+        assert(reqLookupResult.lineAddr == line_addr);
+        const std::size_t slot = table.find(line_addr);
+        assert(slot != noSlot);
         if (will_retry) {
             SnoopItem retry_item = reqLookupResult.retryItem;
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult.it->second = retry_item;
+            table.item(slot) = retry_item;
 
             DPRINTF(SnoopFilter, "%s:   restored SF value %x.%x\n",
                     __func__,  retry_item.requested, retry_item.holder);
         }
 
-        eraseIfNullEntry(reqLookupResult.it);
+        eraseIfNullEntry(slot);
+        reqLookupResult.lineAddr = invalidLine;
     }
 }
 
@@ -193,10 +307,10 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = (sf_it != cachedLocations.end());
+    const std::size_t slot = table.find(line_addr);
+    bool is_hit = (slot != noSlot);
 
-    panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
+    panic_if(!is_hit && (table.size() >= maxEntryCount) && !bounded(),
              "snoop filter exceeded capacity of %d cache blocks\n",
              maxEntryCount);
 
@@ -206,7 +320,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (!is_hit)
         return snoopDown(lookupLatency);
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = table.item(slot);
 
     SnoopMask interested = (sf_item.holder | sf_item.requested);
 
@@ -236,7 +350,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         sf_item.holder = 0;
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(slot);
     }
 
     return snoopSelected(maskToPortList(interested), lookupLatency);
@@ -266,7 +380,13 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     }
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    const std::size_t slot = table.find(line_addr);
+
+    // The destination should have had a request in, which keeps the line
+    // tracked
+    panic_if(slot == noSlot, "SF has no entry for %#llx, missing the "
+             "original request\n", line_addr);
+    SnoopItem& sf_item = table.item(slot);
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -313,8 +433,8 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = sf_it != cachedLocations.end();
+    const std::size_t slot = table.find(line_addr);
+    bool is_hit = slot != noSlot;
 
     // Nothing to do if it is not a hit
     if (!is_hit)
@@ -324,7 +444,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     // Modified state, and we know that there are no other copies, or
     // they will all be invalidated imminently
     if (!cpkt->hasSharers()) {
-        SnoopItem& sf_item = sf_it->second;
+        SnoopItem& sf_item = table.item(slot);
 
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
@@ -332,7 +452,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
 
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(slot);
     }
 }
 
@@ -355,12 +475,12 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    if (sf_it == cachedLocations.end())
+    const std::size_t slot = table.find(line_addr);
+    if (slot == noSlot)
         return;
 
     SnoopMask response_mask = portToMask(cpu_side_port);
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = table.item(slot);
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -379,7 +499,7 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
         if (cpkt->isInvalidate()) {
             sf_item.holder &= ~response_mask;
         }
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(slot);
     } else {
         // Any other response implies that a cache above will have the
         // block.
@@ -407,7 +527,13 @@ SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
                "holder of the requested data."),
       ADD_STAT(hitMultiSnoops, statistics::units::Count::get(),
                "Number of snoops hitting in the snoop filter with multiple "
-               "(>1) holders of the requested data.")
+               "(>1) holders of the requested data."),
+      ADD_STAT(evictions, statistics::units::Count::get(),
+               "Number of lines evicted from the snoop filter to make room "
+               "for others."),
+      ADD_STAT(backInvalidations, statistics::units::Count::get(),
+               "Number of invalidations of evicted lines sent to the caches "
+               "holding them.")
 {}
 
 void
@@ -44,12 +44,15 @@
 #define __MEM_SNOOP_FILTER_HH__
 
 #include <bitset>
-#include <unordered_map>
+#include <cstddef>
 #include <utility>
+#include <vector>
 
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/qport.hh"
+#include "mem/snoop_filter_table.hh"
 #include "params/SnoopFilter.hh"
 #include "sim/sim_object.hh"
 #include "sim/system.hh"
@@ -57,6 +60,11 @@
 namespace gem5
 {
 
+namespace replacement_policy
+{
+class Base;
+}
+
 /**
  * This snoop filter keeps track of which connected port has a
  * particular line of data. It can be queried (through lookup*) on
@@ -85,6 +93,13 @@ namespace gem5
  *     upper cache dropped a line, making the snoop filter pessimistic for now
  * (4) ordering: there is no single point of order in the system.  Instead,
  *     requesting MSHRs track order between local requests and remote snoops
+ *
+ * The lines are tracked in an open-addressed table. By default it grows
+ * to track any line held above, up to the maximum capacity. Given an
+ * associativity, it instead models a finite, inclusive directory: the
+ * table is set-associative, and a line is evicted by the replacement
+ * policy when its set is full. The crossbar then invalidates it in the
+ * caches holding it, which write back any dirty data.
  */
 class SnoopFilter : public SimObject
 {
@@ -95,13 +110,16 @@ class SnoopFilter : public SimObject
 
     typedef std::vector<QueuedResponsePort*> SnoopList;
 
-    SnoopFilter (const SnoopFilterParams &p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()),
-        linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
-        maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
-        stats(this)
+    /** A line evicted to make room for another one. */
+    struct Eviction
     {
-    }
+        Addr addr;
+        bool isSecure;
+        /** The ports of the caches that must invalidate the line. */
+        SnoopList holders;
+    };
+
+    SnoopFilter(const SnoopFilterParams &p);
 
     /**
      * Init a new snoop filter and tell it about all the cpu_sideports
@@ -200,6 +218,17 @@ class SnoopFilter : public SimObject
      */
     void updateResponse(const Packet *cpkt, const ResponsePort& cpu_side_port);
 
+    /** @return Whether lines were evicted, and are yet to be invalidated. */
+    bool hasEvictions() const { return !evictions.empty(); }
+
+    /**
+     * Take the lines evicted since the last call, for the crossbar to
+     * invalidate them in the caches above.
+     *
+     * @return The evicted lines.
+     */
+    std::vector<Eviction> takeEvictions();
+
     virtual void regStats();
 
   protected:
@@ -220,10 +249,6 @@ class SnoopFilter : public SimObject
         SnoopMask requested;
         SnoopMask holder;
     };
-    /**
-     * HashMap of SnoopItems indexed by line address
-     */
-    typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
 
     /**
      * Simple factory methods for standard return values.
@@ -258,13 +283,48 @@ class SnoopFilter : public SimObject
 
   private:
 
+    typedef SnoopFilterTable<SnoopItem> Table;
+
     /**
-     * Removes snoop filter items which have no requestors and no holders.
+     * Check that the associativity gives a power of 2 number of sets,
+     * before the table is built with it.
+     *
+     * @return The associativity.
+     */
+    static unsigned checkedAssoc(const SnoopFilterParams &p);
+
+    /** Line address that no line can have. */
+    static constexpr Addr invalidLine = MaxAddr;
+
+    /** Slot index returned when a line is not tracked. */
+    static constexpr std::size_t noSlot = Table::noSlot;
+
+    /** @return Whether the filter has a finite, set-associative, table. */
+    bool bounded() const { return table.bounded(); }
+
+    /**
+     * Start tracking a line, which must not be tracked yet, evicting
+     * another line of its set if the table is bounded and the set full.
+     *
+     * @param line_addr The line address, with its status bits.
+     * @return The slot tracking the line.
+     */
+    std::size_t allocateSlot(Addr line_addr);
+
+    /** Stop tracking the line in a slot. */
+    void eraseSlot(std::size_t slot);
+
+    /**
+     * Evict a line from a full set of a bounded table, recording it for
+     * the crossbar to invalidate. Lines with requests in flight are not
+     * evicted.
      */
-    void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
+    void evictFromSet(std::size_t set);
 
-    /** Simple hash set of cached addresses. */
-    SnoopFilterCache cachedLocations;
+    /**
+     * Removes snoop filter items which have no requestors and no holders.
+     */
+    void eraseIfNullEntry(std::size_t slot);
 
     /**
      * A request lookup must be followed by a call to finishRequest to inform
@@ -274,8 +334,11 @@ class SnoopFilter : public SimObject
      */
     struct ReqLookupResult
     {
-        /** Iterator used to store the result from lookupRequest. */
-        SnoopFilterCache::iterator it;
+        /**
+         * Line looked up by lookupRequest, or invalidLine if it is not
+         * tracked.
+         */
+        Addr lineAddr;
 
         /**
          * Variable to temporarily store value of snoopfilter entry
@@ -283,18 +346,6 @@ class SnoopFilter : public SimObject
          * (because of crossbar retry)
          */
         SnoopItem retryItem;
-
-        /**
-         * The constructor must be informed of the internal cache's end
-         * iterator, so do not allow the compiler to implictly define it.
-         *
-         * @param end_it Iterator to the end of the internal cache.
-         */
-        ReqLookupResult(SnoopFilterCache::iterator end_it)
-            : it(end_it), retryItem{0, 0}
-        {
-        }
-        ReqLookupResult() = delete;
     } reqLookupResult;
 
     /** List of all attached snooping CPU-side ports. */
@@ -305,8 +356,22 @@ class SnoopFilter : public SimObject
     const unsigned linesize;
     /** Latency for doing a lookup in the filter */
     const Cycles lookupLatency;
-    /** Max capacity in terms of cache blocks tracked, for sanity checking */
+    /**
+     * Max capacity in terms of cache blocks tracked, for sanity checking,
+     * or the number of slots of a bounded table.
+     */
     const unsigned maxEntryCount;
+    /** Associativity of a bounded table, 0 if unbounded. */
+    const unsigned assoc;
+    /** Replacement policy of a bounded table. */
+    replacement_policy::Base *replacementPolicy;
+
+    /** The table of tracked lines. */
+    Table table;
+    /** Replacement state of each slot, in a bounded table. */
+    std::vector<ReplaceableEntry> replEntries;
+    /** Lines evicted, and yet to be invalidated by the crossbar. */
+    std::vector<Eviction> evictions;
 
     /**
      * Use the lower bits of the address to keep track of the line status
@@ -329,6 +394,9 @@ class SnoopFilter : public SimObject
         statistics::Scalar totSnoops;
         statistics::Scalar hitSingleSnoops;
         statistics::Scalar hitMultiSnoops;
+
+        statistics::Scalar evictions;
+        statistics::Scalar backInvalidations;
     } stats;
 };
 
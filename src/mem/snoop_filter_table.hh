@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declares the table of the lines tracked by a snoop filter.
+ */
+
+#ifndef __MEM_SNOOP_FILTER_TABLE_HH__
+#define __MEM_SNOOP_FILTER_TABLE_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Table of the lines a snoop filter tracks, with an item for each. The
+ * line addresses may carry status bits below the line offset.
+ *
+ * By default the table is open-addressed, with linear probing, and grows
+ * to hold any number of lines. Given an associativity, it instead has a
+ * fixed number of sets of that many slots, a line going in the set of
+ * its address, and a line of a full set has to be erased for another
+ * one to go in. The slots of the lines then never move, so that they can
+ * index other state, such as that of a replacement policy.
+ */
+template <typename Item>
+class SnoopFilterTable
+{
+  public:
+    /** Slot index returned when a line is not tracked. */
+    static constexpr std::size_t noSlot =
+        std::numeric_limits<std::size_t>::max();
+
+    /** Number of slots an unbounded table starts with. */
+    static constexpr std::size_t initialSlots = 1024;
+
+    /**
+     * @param line_shift Number of address bits below the line address
+     * @param num_slots Number of slots of a bounded table
+     * @param assoc Associativity of a bounded table, 0 if unbounded
+     */
+    SnoopFilterTable(unsigned line_shift, std::size_t num_slots = 0,
+                     unsigned assoc = 0)
+        : lineShift(line_shift), assoc(assoc),
+          numSets(assoc ? num_slots / assoc : 0),
+          slots(assoc ? num_slots : initialSlots, Slot{invalidLine, Item()}),
+          numEntries(0)
+    {
+        assert(!assoc || (num_slots % assoc == 0 && isPowerOf2(numSets)));
+    }
+
+    /** @return Whether the table has a finite, set-associative, size. */
+    bool bounded() const { return assoc != 0; }
+
+    /** @return The number of tracked lines. */
+    std::size_t size() const { return numEntries; }
+
+    /** @return The number of slots. */
+    std::size_t numSlots() const { return slots.size(); }
+
+    /** @return The set of a line, in a bounded table. */
+    std::size_t
+    setOf(Addr line_addr) const
+    {
+        assert(bounded());
+        return (line_addr >> lineShift) & (numSets - 1);
+    }
+
+    /** @return The line tracked in a slot. */
+    Addr lineAddr(std::size_t slot) const { return slots[slot].lineAddr; }
+
+    /** @return The item of the line tracked in a slot. */
+    Item &item(std::size_t slot) { return slots[slot].item; }
+    const Item &item(std::size_t slot) const { return slots[slot].item; }
+
+    /** @return The slot tracking a line, or noSlot if none. */
+    std::size_t find(Addr line_addr) const;
+
+    /**
+     * @return A free slot of the set of a line, in a bounded table, or
+     *         noSlot if the set is full.
+     */
+    std::size_t freeSlot(Addr line_addr) const;
+
+    /**
+     * Start tracking a line, which must not be tracked yet, with a
+     * default item. The set of the line must not be full, in a bounded
+     * table, while an unbounded one grows as needed.
+     *
+     * @return The slot tracking the line.
+     */
+    std::size_t insert(Addr line_addr);
+
+    /** Stop tracking the line in a slot. */
+    void erase(std::size_t slot);
+
+  private:
+    /** Line address of the empty slots, which no line can have. */
+    static constexpr Addr invalidLine = MaxAddr;
+
+    /** Slot of the table. */
+    struct Slot
+    {
+        /** Line address, with its status bits, or invalidLine if empty. */
+        Addr lineAddr;
+        Item item;
+    };
+
+    /** @return The first slot probed for a line, in an unbounded table. */
+    std::size_t
+    homeSlot(Addr line_addr) const
+    {
+        const uint64_t hash = (line_addr >> lineShift) *
+            0x9e3779b97f4a7c15ULL;
+        return (hash ^ (hash >> 32)) & (slots.size() - 1);
+    }
+
+    /** Place a slot in an unbounded table, which has room for it. */
+    std::size_t place(const Slot &slot);
+
+    /** Double the number of slots of an unbounded table. */
+    void grow();
+
+    /** Number of address bits below the line address. */
+    const unsigned lineShift;
+    /** Associativity of a bounded table, 0 if unbounded. */
+    const unsigned assoc;
+    /** Number of sets of a bounded table. */
+    const std::size_t numSets;
+
+    /** The slots, by set in a bounded table. */
+    std::vector<Slot> slots;
+    /** Number of tracked lines. */
+    std::size_t numEntries;
+};
+
+template <typename Item>
+std::size_t
+SnoopFilterTable<Item>::find(Addr line_addr) const
+{
+    if (bounded()) {
+        const std::size_t first = setOf(line_addr) * assoc;
+        for (std::size_t slot = first; slot < first + assoc; slot++) {
+            if (slots[slot].lineAddr == line_addr)
+                return slot;
+        }
+        return noSlot;
+    }
+
+    // Probe linearly, up to the first empty slot
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t slot = homeSlot(line_addr); ;
+         slot = (slot + 1) & mask) {
+        if (slots[slot].lineAddr == line_addr)
+            return slot;
+        if (slots[slot].lineAddr == invalidLine)
+            return noSlot;
+    }
+}
+
+template <typename Item>
+std::size_t
+SnoopFilterTable<Item>::freeSlot(Addr line_addr) const
+{
+    assert(bounded());
+    const std::size_t first = setOf(line_addr) * assoc;
+    for (std::size_t slot = first; slot < first + assoc; slot++) {
+        if (slots[slot].lineAddr == invalidLine)
+            return slot;
+    }
+    return noSlot;
+}
+
+template <typename Item>
+std::size_t
+SnoopFilterTable<Item>::insert(Addr line_addr)
+{
+    assert(line_addr != invalidLine);
+    assert(find(line_addr) == noSlot);
+
+    if (bounded()) {
+        const std::size_t slot = freeSlot(line_addr);
+        assert(slot != noSlot);
+        numEntries++;
+        slots[slot] = Slot{line_addr, Item()};
+        return slot;
+    }
+
+    // Keep the table at most three quarters full, so that probing
+    // stays short
+    if ((numEntries + 1) * 4 > slots.size() * 3)
+        grow();
+    numEntries++;
+    return place(Slot{line_addr, Item()});
+}
+
+template <typename Item>
+void
+SnoopFilterTable<Item>::erase(std::size_t slot)
+{
+    assert(slots[slot].lineAddr != invalidLine);
+    assert(numEntries > 0);
+    numEntries--;
+
+    if (bounded()) {
+        slots[slot].lineAddr = invalidLine;
+        return;
+    }
+
+    // Shift the following lines back into the hole, unless it is before
+    // their first probed slot, so that no probe stops short of them
+    const std::size_t mask = slots.size() - 1;
+    std::size_t hole = slot;
+    for (std::size_t next = (slot + 1) & mask;
+         slots[next].lineAddr != invalidLine; next = (next + 1) & mask) {
+        const std::size_t home = homeSlot(slots[next].lineAddr);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+    }
+    slots[hole].lineAddr = invalidLine;
+}
+
+template <typename Item>
+std::size_t
+SnoopFilterTable<Item>::place(const Slot &slot)
+{
+    const std::size_t mask = slots.size() - 1;
+    std::size_t index = homeSlot(slot.lineAddr);
+    while (slots[index].lineAddr != invalidLine)
+        index = (index + 1) & mask;
+    slots[index] = slot;
+    return index;
+}
+
+template <typename Item>
+void
+SnoopFilterTable<Item>::grow()
+{
+    std::vector<Slot> old_slots(slots.size() * 2, Slot{invalidLine, Item()});
+    old_slots.swap(slots);
+    for (const auto &slot : old_slots) {
+        if (slot.lineAddr != invalidLine)
+            place(slot);
+    }
+}
+
+} // namespace gem5
+
+#endif // __MEM_SNOOP_FILTER_TABLE_HH__
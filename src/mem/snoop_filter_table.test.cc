@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "mem/snoop_filter_table.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+typedef SnoopFilterTable<int> Table;
+
+const unsigned lineShift = 6;
+
+/** Check that the table tracks exactly the lines of a reference map. */
+void
+expectTracks(const Table &table, const std::map<Addr, int> &lines)
+{
+    ASSERT_EQ(table.size(), lines.size());
+    for (const auto &line : lines) {
+        const std::size_t slot = table.find(line.first);
+        ASSERT_NE(slot, Table::noSlot) << std::hex << line.first;
+        ASSERT_EQ(table.lineAddr(slot), line.first);
+        ASSERT_EQ(table.item(slot), line.second);
+    }
+}
+
+} // anonymous namespace
+
+/** Lines are found with their items, and their status bits. */
+TEST(SnoopFilterTableTest, InsertFind)
+{
+    Table table(lineShift);
+    ASSERT_FALSE(table.bounded());
+    ASSERT_EQ(table.find(0x40), Table::noSlot);
+
+    table.item(table.insert(0x40)) = 1;
+    table.item(table.insert(0x41)) = 2;
+    ASSERT_EQ(table.size(), 2);
+    ASSERT_EQ(table.item(table.find(0x40)), 1);
+    ASSERT_EQ(table.item(table.find(0x41)), 2);
+    ASSERT_EQ(table.find(0x80), Table::noSlot);
+
+    table.erase(table.find(0x40));
+    ASSERT_EQ(table.find(0x40), Table::noSlot);
+    ASSERT_EQ(table.item(table.find(0x41)), 2);
+}
+
+/** An unbounded table grows, and keeps every line reachable by its
+ * probes however the lines are erased. */
+TEST(SnoopFilterTableTest, Unbounded)
+{
+    Table table(lineShift);
+    std::map<Addr, int> lines;
+    std::mt19937_64 rng(1);
+    // Few enough lines for the probe sequences to collide often
+    std::uniform_int_distribution<Addr> line_dist(0, 8 * 1024);
+    for (int i = 0; i < 100000; i++) {
+        const Addr line_addr = line_dist(rng) << lineShift | (i & 1);
+        const std::size_t slot = table.find(line_addr);
+        auto it = lines.find(line_addr);
+        ASSERT_EQ(slot == Table::noSlot, it == lines.end());
+        if (it == lines.end()) {
+            table.item(table.insert(line_addr)) = i;
+            lines.emplace(line_addr, i);
+        } else {
+            ASSERT_EQ(table.item(slot), it->second);
+            table.erase(slot);
+            lines.erase(it);
+        }
+    }
+    expectTracks(table, lines);
+    ASSERT_GT(table.numSlots(), Table::initialSlots);
+    ASSERT_LE(table.size() * 4, table.numSlots() * 3);
+}
+
+/** A line evicted from a full set of a bounded table frees its slot for
+ * the new line, while the other lines keep theirs. */
+TEST(SnoopFilterTableTest, BoundedEviction)
+{
+    const unsigned assoc = 4;
+    const std::size_t num_sets = 8;
+    Table table(lineShift, num_sets * assoc, assoc);
+    ASSERT_TRUE(table.bounded());
+
+    // Fill set 3, and one line of set 5
+    const Addr set_stride = num_sets << lineShift;
+    const Addr base = 3 << lineShift;
+    std::vector<std::size_t> slots;
+    for (unsigned way = 0; way < assoc; way++) {
+        const Addr line_addr = base + way * set_stride;
+        ASSERT_NE(table.freeSlot(line_addr), Table::noSlot);
+        slots.push_back(table.insert(line_addr));
+        table.item(slots.back()) = way;
+        ASSERT_EQ(table.setOf(line_addr), 3);
+        ASSERT_EQ(slots.back() / assoc, 3);
+    }
+    const std::size_t other = table.insert(5 << lineShift);
+    ASSERT_EQ(other / assoc, 5);
+
+    // The set is full for a new line, but not the others
+    const Addr new_line = base + assoc * set_stride;
+    ASSERT_EQ(table.freeSlot(new_line), Table::noSlot);
+    ASSERT_NE(table.freeSlot(4 << lineShift), Table::noSlot);
+
+    // Evict a line for the new one, which takes its slot
+    const std::size_t victim = slots[1];
+    table.erase(victim);
+    ASSERT_EQ(table.find(base + set_stride), Table::noSlot);
+    ASSERT_EQ(table.freeSlot(new_line), victim);
+    ASSERT_EQ(table.insert(new_line), victim);
+    ASSERT_EQ(table.item(victim), 0);
+    ASSERT_EQ(table.freeSlot(new_line), Table::noSlot);
+
+    // The other lines have not moved
+    for (unsigned way = 0; way < assoc; way++) {
+        if (slots[way] == victim)
+            continue;
+        ASSERT_EQ(table.find(base + way * set_stride), slots[way]);
+        ASSERT_EQ(table.item(slots[way]), way);
+    }
+    ASSERT_EQ(table.find(5 << lineShift), other);
+    ASSERT_EQ(table.size(), assoc + 1);
+}
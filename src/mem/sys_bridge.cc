@@ -36,7 +36,7 @@ SysBridge::PacketData
 SysBridge::BridgingPort::replaceReqID(PacketPtr pkt)
 {
     RequestPtr old_req = pkt->req;
-    RequestPtr new_req = std::make_shared<Request>(
+    RequestPtr new_req = Request::create(
             old_req->getPaddr(), old_req->getSize(), old_req->getFlags(), id);
     pkt->req = new_req;
     return {old_req};
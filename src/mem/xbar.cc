@@ -45,6 +45,8 @@
 
 #include "mem/xbar.hh"
 
+#include <algorithm>
+
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
@@ -61,6 +63,7 @@ BaseXBar::BaseXBar(const BaseXBarParams &p)
       responseLatency(p.response_latency),
       headerLatency(p.header_latency),
       width(p.width),
+      routeTag(newRouteTag()), numRoutes(0),
       gotAddrRanges(p.port_default_connection_count +
                           p.port_mem_side_ports_connection_count, false),
       gotAllAddrRanges(false), defaultPortID(InvalidPortID),
@@ -73,6 +76,15 @@ BaseXBar::BaseXBar(const BaseXBarParams &p)
       ADD_STAT(pktSize, statistics::units::Byte::get(),
                "Cumulative packet size per connected requestor and responder")
 {
+    for (const auto *mapper : p.channel_mappers)
+        channelPorts.push_back({mapper, {}});
+}
+
+uint32_t
+BaseXBar::newRouteTag()
+{
+    static uint32_t next_tag = 0;
+    return next_tag++;
 }
 
 BaseXBar::~BaseXBar()
@@ -334,6 +346,13 @@ BaseXBar::findPort(AddrRange addr_range)
     // ranges of all connected CPU-side-port modules
     assert(gotAllAddrRanges);
 
+    // Check the channel mappers, which decode their range on their own
+    for (const auto& c : channelPorts) {
+        if (addr_range.isSubset(c.mapper->getAddrRange())) {
+            return c.ports[c.mapper->channel(addr_range.start())];
+        }
+    }
+
     // Check the address map interval tree
     auto i = portMap.contains(addr_range);
     if (i != portMap.end()) {
@@ -413,12 +432,40 @@ BaseXBar::recvRangeChange(PortID mem_side_port_id)
                 else
                     p++;
             }
+            for (auto& c : channelPorts) {
+                c.ports.erase(std::remove(c.ports.begin(), c.ports.end(),
+                                          mem_side_port_id),
+                              c.ports.end());
+            }
         }
 
         AddrRangeList ranges = memSidePorts[mem_side_port_id]->
                                getAddrRanges();
 
         for (const auto& r: ranges) {
+            // the range of a channel mapper makes the port a channel,
+            // numbered in the order of the ports
+            auto c = std::find_if(channelPorts.begin(), channelPorts.end(),
+                [&r](const ChannelPorts &c) {
+                    return r == c.mapper->getAddrRange();
+                });
+            if (c != channelPorts.end()) {
+                DPRINTF(AddrRanges, "Adding channel of %s for id %d\n",
+                        c->mapper->name(), mem_side_port_id);
+                c->ports.insert(std::upper_bound(c->ports.begin(),
+                                                 c->ports.end(),
+                                                 mem_side_port_id),
+                                mem_side_port_id);
+                continue;
+            }
+            for (const auto& c : channelPorts) {
+                fatal_if(r.intersects(c.mapper->getAddrRange()),
+                         "%s has a port responding within range %s of "
+                         "%s:\n\t%s\n", name(), r.to_string(),
+                         c.mapper->name(),
+                         memSidePorts[mem_side_port_id]->getPeer());
+            }
+
             DPRINTF(AddrRanges, "Adding range %s for id %d\n",
                     r.to_string(), mem_side_port_id);
             if (portMap.insert(r, mem_side_port_id) == portMap.end()) {
@@ -451,6 +498,21 @@ BaseXBar::recvRangeChange(PortID mem_side_port_id)
                     defaultRange.to_string());
         }
 
+        // add the ranges of the channel mappers, once all their
+        // channels are there
+        for (const auto& c : channelPorts) {
+            fatal_if(c.ports.size() != c.mapper->numChannels(),
+                     "%s has %d ports for the %d channels of %s\n", name(),
+                     c.ports.size(), c.mapper->numChannels(),
+                     c.mapper->name());
+            const AddrRange &r = c.mapper->getAddrRange();
+            if (!(useDefaultRange && r.isSubset(defaultRange))) {
+                xbarRanges.push_back(r);
+                DPRINTF(AddrRanges, "-- Adding mapped range %s\n",
+                        r.to_string());
+            }
+        }
+
         // merge all interleaved ranges and add any range that is not
         // a subset of the default range
         std::vector<AddrRange> intlv_ranges;
@@ -47,10 +47,11 @@
 #define __MEM_XBAR_HH__
 
 #include <deque>
-#include <unordered_map>
+#include <vector>
 
 #include "base/addr_range_map.hh"
 #include "base/types.hh"
+#include "mem/channel_mapper.hh"
 #include "mem/qport.hh"
 #include "params/BaseXBar.hh"
 #include "sim/clocked_object.hh"
@@ -318,13 +319,52 @@ class BaseXBar : public ClockedObject
 
     AddrRangeMap<PortID, 3> portMap;
 
+    /** The memory-side ports of the channels of a channel mapper. */
+    struct ChannelPorts
+    {
+        const memory::ChannelMapper *mapper;
+        /** The port of each channel, in the order of the port ids. */
+        std::vector<PortID> ports;
+    };
+
+    /** The channel mappers, looked up before the address map. */
+    std::vector<ChannelPorts> channelPorts;
+
     /**
      * Remember where request packets came from so that we can route
-     * responses to the appropriate port. This relies on the fact that
-     * the underlying Request pointer inside the Packet stays
+     * responses to the appropriate port. The port is kept in the
+     * Request, under the tag of this crossbar, which relies on the fact
+     * that the underlying Request pointer inside the Packet stays
      * constant.
      */
-    std::unordered_map<RequestPtr, PortID> routeTo;
+    const uint32_t routeTag;
+
+    /** Number of responses currently routed by this crossbar. */
+    unsigned numRoutes;
+
+    /** @return A route tag no other crossbar uses. */
+    static uint32_t newRouteTag();
+
+    void
+    setRoute(const RequestPtr &req, PortID port)
+    {
+        req->setRoute(routeTag, port);
+        ++numRoutes;
+    }
+
+    /** @return The port to route the response through, if any. */
+    PortID findRoute(const RequestPtr &req) const
+    {
+        return req->getRoute(routeTag);
+    }
+
+    void
+    clearRoute(const RequestPtr &req)
+    {
+        req->clearRoute(routeTag);
+        assert(numRoutes > 0);
+        --numRoutes;
+    }
 
     /** all contigous ranges seen by this crossbar */
     AddrRangeList xbarRanges;
@@ -0,0 +1,283 @@
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import m5
+from m5.objects import BaseCache, SamplingController
+from m5.util import inform
+
+from enum import Enum
+from typing import Optional, Tuple
+
+from .simulator import Simulator
+from ..components.boards.abstract_board import AbstractBoard
+from ..components.processors.cpu_types import CPUTypes
+from ..components.processors.simple_switchable_processor import (
+    SimpleSwitchableProcessor,
+)
+
+
+class _Phase(Enum):
+    FUNCTIONAL_WARMING = "functional warming"
+    DETAILED_WARMING = "detailed warming"
+    MEASUREMENT = "measurement"
+
+
+class SampledSimulator(Simulator):
+    """
+    This SampledSimulator class runs a SMARTS-style sampled simulation: the
+    IPC of the workload is estimated from short windows of detailed
+    simulation, taken at regular intervals, rather than by simulating all
+    of it in detail.
+
+    **Warning:** The simulate package is still in a beta state. The gem5
+    project does not guarantee the APIs within this package will remain
+    consistent in future across upcoming releases.
+
+    The board must have a `SimpleSwitchableProcessor` that starts with
+    atomic cores, which functionally warm the caches and predictors between
+    windows, and switches to the detailed cores (typically O3) the windows
+    are measured on. Each sampling unit runs:
+
+        1. `functional_warming_insts` instructions on the atomic cores. The
+           caches service hits on their functional warming fast path and
+           train their prefetchers, and the load values train the LVP unit
+           of the O3 cores.
+        2. `detailed_warming_insts` instructions on the detailed cores, to
+           fill the pipeline and any structure that is not warmed
+           functionally. These are not measured.
+        3. `measurement_insts` instructions on the detailed cores, whose IPC
+           is added to the sample by a `SamplingController`.
+
+    The run ends when `max_samples` windows have been measured, when the
+    confidence interval of the estimate is within `target_error` of the
+    mean (after at least `min_samples` windows), or when an exit event
+    handler says so. The estimate is reported in the statistics of the
+    controller (`board.sampling_controller`) and through
+    `get_ipc_estimate()`.
+
+    Example
+    -------
+
+    ```
+    processor = SimpleSwitchableProcessor(
+        starting_core_type=CPUTypes.ATOMIC,
+        switch_core_type=CPUTypes.O3,
+        num_cores=1,
+    )
+    ...
+    simulator = SampledSimulator(
+        board=board,
+        functional_warming_insts=1000000,
+        detailed_warming_insts=2000,
+        measurement_insts=1000,
+        target_error=0.03,
+    )
+    simulator.run()
+    ```
+    """
+
+    # The exit cause of the end of a phase.
+    _phase_cause = "sampling phase ended"
+
+    def __init__(
+        self,
+        board: AbstractBoard,
+        functional_warming_insts: int,
+        detailed_warming_insts: int,
+        measurement_insts: int,
+        max_samples: Optional[int] = None,
+        target_error: Optional[float] = None,
+        min_samples: int = 30,
+        z_score: float = 3.0,
+        **kwargs,
+    ) -> None:
+        """
+        :param board: The board to be simulated.
+        :param functional_warming_insts: The number of instructions run on
+        the atomic cores before each window.
+        :param detailed_warming_insts: The number of instructions run on the
+        detailed cores before each window is measured.
+        :param measurement_insts: The number of instructions measured in each
+        window.
+        :param max_samples: An optional maximum number of windows.
+        :param target_error: An optional bound on the half width of the
+        confidence interval, relative to the mean IPC, under which the run
+        ends.
+        :param min_samples: The number of windows to measure before the
+        target error is checked, so that the normal approximation holds.
+        :param z_score: The number of standard errors the confidence interval
+        spans on either side of the mean (3.0 for 99.7%).
+        :param kwargs: Any other parameter of the Simulator.
+        """
+
+        super().__init__(board=board, **kwargs)
+
+        processor = board.get_processor()
+        if not isinstance(processor, SimpleSwitchableProcessor):
+            raise Exception(
+                "Sampled simulation needs a SimpleSwitchableProcessor."
+            )
+
+        self._fast_cores = processor.get_cores()
+        self._detailed_cores = [
+            core for core in processor.cores if core not in self._fast_cores
+        ]
+        if any(
+            core.get_type() != CPUTypes.ATOMIC for core in self._fast_cores
+        ):
+            raise Exception(
+                "Sampled simulation must start with atomic cores, which "
+                "functionally warm the caches."
+            )
+
+        if min(functional_warming_insts, measurement_insts) <= 0:
+            raise Exception(
+                "Functional warming and measurement must run instructions."
+            )
+        if detailed_warming_insts < 0:
+            raise Exception("Detailed warming cannot run backwards.")
+        if target_error is not None and target_error <= 0:
+            raise Exception("The target error must be positive.")
+
+        self._processor = processor
+        self._functional_warming_insts = functional_warming_insts
+        self._detailed_warming_insts = detailed_warming_insts
+        self._measurement_insts = measurement_insts
+        self._max_samples = max_samples
+        self._target_error = target_error
+        self._min_samples = min_samples
+        self._phase = None
+
+        board.sampling_controller = SamplingController(
+            cpus=[core.get_simobject() for core in self._detailed_cores],
+            z_score=z_score,
+        )
+        self._controller = board.sampling_controller
+
+        for obj in board.descendants():
+            if isinstance(obj, BaseCache):
+                obj.functional_warming = True
+
+    def get_ipc_estimate(self) -> Tuple[float, float, int]:
+        """
+        Returns the estimated IPC, the half width of its confidence interval
+        and the number of windows it was estimated from.
+
+        **Warning:** Will throw an Exception if called before `run()`.
+        """
+        if not self._instantiated:
+            raise Exception(
+                "Cannot obtain the IPC estimate prior to inialization."
+            )
+        return (
+            self._controller.ipcMean(),
+            self._controller.ipcConfidence(),
+            self._controller.numSamples(),
+        )
+
+    def _schedule_phase(self, phase: _Phase, insts: int) -> None:
+        self._phase = phase
+        cpu = self._processor.get_cores()[0].get_simobject()
+        cpu.scheduleInstStop(0, insts, self._phase_cause)
+
+    def _start_window(self) -> None:
+        self._processor.switch()
+        if self._detailed_warming_insts > 0:
+            self._schedule_phase(
+                _Phase.DETAILED_WARMING, self._detailed_warming_insts
+            )
+        else:
+            self._start_measurement()
+
+    def _start_measurement(self) -> None:
+        self._controller.startMeasurement()
+        self._schedule_phase(_Phase.MEASUREMENT, self._measurement_insts)
+
+    def _done(self) -> bool:
+        samples = self._controller.numSamples()
+        if self._max_samples is not None and samples >= self._max_samples:
+            return True
+        if self._target_error is None or samples < self._min_samples:
+            return False
+        mean = self._controller.ipcMean()
+        return (
+            mean > 0
+            and self._controller.ipcConfidence() <= self._target_error * mean
+        )
+
+    def _report(self) -> None:
+        mean, confidence, samples = self.get_ipc_estimate()
+        inform(
+            f"Sampled IPC: {mean:.4f} +/- {confidence:.4f} "
+            f"({samples} windows)"
+        )
+
+    def run(self, max_ticks: int = m5.MaxTick) -> None:
+        """
+        This function will start or continue the sampled run, handling the
+        exit events other than the end of a phase like the Simulator does.
+
+        :param max_ticks: The maximum number of ticks to execute per
+        simulation run.
+        """
+
+        if not self._instantiated:
+            self._instantiate()
+
+            # The O3 cores learn load values from the atomic cores they
+            # replace
+            for fast, detailed in zip(self._fast_cores, self._detailed_cores):
+                if detailed.get_type() == CPUTypes.O3:
+                    detailed.get_simobject().warmLoadValuesFrom(
+                        fast.get_simobject()
+                    )
+
+            self._schedule_phase(
+                _Phase.FUNCTIONAL_WARMING, self._functional_warming_insts
+            )
+
+        while True:
+            self._last_exit_event = m5.simulate(max_ticks)
+
+            if self.get_last_exit_event_cause() != self._phase_cause:
+                if self._handle_exit_event():
+                    self._report()
+                    return
+                continue
+
+            if self._phase == _Phase.FUNCTIONAL_WARMING:
+                self._start_window()
+            elif self._phase == _Phase.DETAILED_WARMING:
+                self._start_measurement()
+            else:
+                self._controller.endMeasurement()
+                if self._done():
+                    self._report()
+                    return
+                self._processor.switch()
+                self._schedule_phase(
+                    _Phase.FUNCTIONAL_WARMING, self._functional_warming_insts
+                )
@@ -315,54 +315,63 @@ class Simulator:
 
             self._last_exit_event = m5.simulate(max_ticks)
 
-            # Translate the exit event cause to the exit event enum.
-            exit_enum = ExitEvent.translate_exit_status(
-                self.get_last_exit_event_cause()
-            )
+            # If the generator returned True we will return from the Simulator
+            # run loop.
+            if self._handle_exit_event():
+                return
 
-            # Check to see the run is corresponding to the expected execution
-            # order (assuming this check is demanded by the user).
-            if self._expected_execution_order:
-                expected_enum = self._expected_execution_order[
-                    self._exit_event_count
-                ]
-                if exit_enum.value != expected_enum.value:
-                    raise Exception(
-                        f"Expected a '{expected_enum.value}' exit event but a "
-                        f"'{exit_enum.value}' exit event was encountered."
-                    )
-
-            # Record the current tick and exit event enum.
-            self._tick_stopwatch.append((exit_enum, self.get_current_tick()))
-
-            try:
-                # If the user has specified their own generator for this exit
-                # event, use it.
-                exit_on_completion = next(self._on_exit_event[exit_enum])
-            except StopIteration:
-                # If the user's generator has ended, throw a warning and use
-                # the default generator for this exit event.
-                warn(
-                    "User-specified generator for the exit event "
-                    f"'{exit_enum.value}' has ended. Using the default "
-                    "generator."
-                )
-                exit_on_completion = next(
-                    self._default_on_exit_dict[exit_enum]
-                )
-            except KeyError:
-                # If the user has not specified their own generator for this
-                # exit event, use the default.
-                exit_on_completion = next(
-                    self._default_on_exit_dict[exit_enum]
+    def _handle_exit_event(self) -> bool:
+        """
+        Runs the generator for the last exit event.
+
+        :returns: True if the Simulator run loop should exit.
+        """
+
+        # Translate the exit event cause to the exit event enum.
+        exit_enum = ExitEvent.translate_exit_status(
+            self.get_last_exit_event_cause()
+        )
+
+        # Check to see the run is corresponding to the expected execution
+        # order (assuming this check is demanded by the user).
+        if self._expected_execution_order:
+            expected_enum = self._expected_execution_order[
+                self._exit_event_count
+            ]
+            if exit_enum.value != expected_enum.value:
+                raise Exception(
+                    f"Expected a '{expected_enum.value}' exit event but a "
+                    f"'{exit_enum.value}' exit event was encountered."
                 )
 
-            self._exit_event_count += 1
+        # Record the current tick and exit event enum.
+        self._tick_stopwatch.append((exit_enum, self.get_current_tick()))
+
+        try:
+            # If the user has specified their own generator for this exit
+            # event, use it.
+            exit_on_completion = next(self._on_exit_event[exit_enum])
+        except StopIteration:
+            # If the user's generator has ended, throw a warning and use
+            # the default generator for this exit event.
+            warn(
+                "User-specified generator for the exit event "
+                f"'{exit_enum.value}' has ended. Using the default "
+                "generator."
+            )
+            exit_on_completion = next(
+                self._default_on_exit_dict[exit_enum]
+            )
+        except KeyError:
+            # If the user has not specified their own generator for this
+            # exit event, use the default.
+            exit_on_completion = next(
+                self._default_on_exit_dict[exit_enum]
+            )
 
-            # If the generator returned True we will return from the Simulator
-            # run loop.
-            if exit_on_completion:
-                return
+        self._exit_event_count += 1
+
+        return exit_on_completion
 
     def save_checkpoint(self, checkpoint_dir: Path) -> None:
         """
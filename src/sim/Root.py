@@ -67,6 +67,14 @@ class Root(SimObject):
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
 
+    # Calendar organisation of the main event queues. With zero buckets
+    # the queues keep a single sorted list of event bins.
+    event_queue_buckets = Param.Unsigned(0,
+        "number of calendar buckets per main event queue (power of 2, "
+        "0 to use a sorted list)")
+    event_queue_bucket_width = Param.Tick(512,
+        "ticks covered by a calendar bucket (power of 2)")
+
     full_system = Param.Bool("if this is a full system simulation")
 
     # Time syncing prevents the simulation from running faster than real time.
@@ -48,6 +48,8 @@ from m5.objects.Workload import StubWorkload
 class MemoryMode(Enum): vals = ['invalid', 'atomic', 'timing',
                                 'atomic_noncaching']
 
+class MemoryCheckpointFormat(Enum): vals = ['gzip', 'mapped', 'dedup']
+
 class System(SimObject):
     type = 'System'
     cxx_header = "sim/system.hh"
@@ -91,6 +93,19 @@ class System(SimObject):
         "shmem segment file upon destruction. This is used only if "
         "shared_backstore is non-empty.")
 
+    # The memory is checkpointed compressed by default. The mapped format
+    # is uncompressed, and is mapped copy-on-write rather than read when it
+    # is restored, so that only the pages the simulation touches are read
+    # in, and simulations forked from the same checkpoint share them in
+    # the page cache. The dedup format only writes the pages that are not
+    # all zeros, and each distinct page once across all the memories,
+    # compressed by host threads. Checkpoints in any format can be restored
+    # whatever the format is set to.
+    memory_checkpoint_format = Param.MemoryCheckpointFormat('gzip',
+        "Format of the memory checkpoint files")
+    memory_checkpoint_threads = Param.Unsigned(0, "Host threads compressing "
+        "and decompressing dedup memory checkpoints, 0 for one per host core")
+
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
     redirect_paths = VectorParam.RedirectPath([], "Path redirections")
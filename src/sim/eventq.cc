@@ -30,6 +30,7 @@
 
 #include "sim/eventq.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <mutex>
@@ -37,6 +38,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/smt.hh"
@@ -58,6 +60,10 @@ std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+//! Calendar geometry applied to newly created main event queues.
+static unsigned mainQueueBuckets = 0;
+static Tick mainQueueBucketWidth = 0;
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
@@ -65,11 +71,25 @@ getEventQueue(uint32_t index)
         numMainEventQueues++;
         mainEventQueue.push_back(
             new EventQueue(csprintf("MainEventQueue-%d", index)));
+        if (mainQueueBuckets) {
+            mainEventQueue.back()->setCalendar(mainQueueBuckets,
+                                               mainQueueBucketWidth);
+        }
     }
 
     return mainEventQueue[index];
 }
 
+void
+setEventQueueCalendar(unsigned num_buckets, Tick bucket_width)
+{
+    mainQueueBuckets = num_buckets;
+    mainQueueBucketWidth = bucket_width;
+
+    for (EventQueue *eq : mainEventQueue)
+        eq->setCalendar(num_buckets, bucket_width);
+}
+
 #ifndef NDEBUG
 Counter Event::instanceCounter = 0;
 #endif
@@ -109,18 +129,18 @@ Event::insertBefore(Event *event, Event *curr)
 }
 
 void
-EventQueue::insert(Event *event)
+Event::insertBin(Event *&list, Event *event)
 {
     // Deal with the head case
-    if (!head || *event <= *head) {
-        head = Event::insertBefore(event, head);
+    if (!list || *event <= *list) {
+        list = Event::insertBefore(event, list);
         return;
     }
 
     // Figure out either which 'in bin' list we are on, or where a new list
     // needs to be inserted
-    Event *prev = head;
-    Event *curr = head->nextBin;
+    Event *prev = list;
+    Event *curr = list->nextBin;
     while (curr && *curr < *event) {
         prev = curr;
         curr = curr->nextBin;
@@ -131,6 +151,22 @@ EventQueue::insert(Event *event)
     prev->nextBin = Event::insertBefore(event, curr);
 }
 
+void
+EventQueue::insert(Event *event)
+{
+    if (calBuckets.empty()) {
+        Event::insertBin(head, event);
+        return;
+    }
+
+    Event::insertBin(calBuckets[calBucket(event->when())], event);
+
+    // An event that is not later than the head ends up on top of the
+    // earliest bin
+    if (!head || *event <= *head)
+        head = event;
+}
+
 Event *
 Event::removeItem(Event *event, Event *top)
 {
@@ -163,23 +199,21 @@ Event::removeItem(Event *event, Event *top)
 }
 
 void
-EventQueue::remove(Event *event)
+Event::removeBin(Event *&list, Event *event)
 {
-    if (head == NULL)
+    if (list == NULL)
         panic("event not found!");
 
-    assert(event->queue == this);
-
-    // deal with an event on the head's 'in bin' list (event has the same
-    // time as the head)
-    if (*head == *event) {
-        head = Event::removeItem(event, head);
+    // deal with an event on the list's 'in bin' list (event has the same
+    // time as the top of the list)
+    if (*list == *event) {
+        list = Event::removeItem(event, list);
         return;
     }
 
     // Find the 'in bin' list that this event belongs on
-    Event *prev = head;
-    Event *curr = head->nextBin;
+    Event *prev = list;
+    Event *curr = list->nextBin;
     while (curr && *curr < *event) {
         prev = curr;
         curr = curr->nextBin;
@@ -194,6 +228,167 @@ EventQueue::remove(Event *event)
     prev->nextBin = Event::removeItem(event, curr);
 }
 
+void
+EventQueue::remove(Event *event)
+{
+    assert(event->queue == this);
+
+    if (calBuckets.empty()) {
+        Event::removeBin(head, event);
+        return;
+    }
+
+    Event::removeBin(calBuckets[calBucket(event->when())], event);
+
+    // Removing from the earliest bin can change its top or empty it
+    if (*event == *head)
+        head = calFindHead(event->when());
+}
+
+Event *
+EventQueue::calFindHead(Tick from)
+{
+    // Walk the calendar one bucket at a time starting at the bucket
+    // 'from' falls into. Since nothing is scheduled before 'from', the
+    // first bin of a bucket is the earliest in the queue as soon as it
+    // belongs to the year currently being looked at.
+    Event *earliest = NULL;
+    const Tick window = from >> calShift;
+    size_t scanned = 0;
+    while (!earliest && scanned <= calMask) {
+        Event *bin = calBuckets[(window + scanned) & calMask];
+        if (bin && (bin->when() >> calShift) == window + scanned)
+            earliest = bin;
+        ++scanned;
+    }
+
+    // Nothing is scheduled within a year, search all buckets
+    if (!earliest) {
+        for (Event *bin : calBuckets) {
+            if (bin && (!earliest || *bin < *earliest))
+                earliest = bin;
+        }
+        scanned += calBuckets.size();
+    }
+
+    calAdapt(scanned);
+    return earliest;
+}
+
+void
+EventQueue::calAdapt(size_t scanned)
+{
+    // Only adapt over enough lookups to amortise moving the bins
+    calScanned += scanned;
+    if (++calSearches < std::max<size_t>(calBuckets.size(), 64))
+        return;
+
+    // Keep the lookups at a couple of buckets on average. Halving the
+    // width at most doubles the buckets a lookup scans, so the queue
+    // does not swing between the two.
+    unsigned shift = calShift;
+    if (calScanned > 4 * calSearches && shift < 8 * sizeof(Tick) - 2)
+        ++shift;
+    else if (4 * calScanned < 5 * calSearches && shift > 0)
+        --shift;
+    calScanned = 0;
+    calSearches = 0;
+
+    if (shift != calShift) {
+        Event *bins = detachBins();
+        calShift = shift;
+        attachBins(bins);
+    }
+}
+
+std::vector<Event *>
+EventQueue::sortedBins() const
+{
+    std::vector<Event *> bins;
+
+    if (calBuckets.empty()) {
+        for (Event *bin = head; bin; bin = bin->nextBin)
+            bins.push_back(bin);
+    } else {
+        for (Event *bin : calBuckets) {
+            for (; bin; bin = bin->nextBin)
+                bins.push_back(bin);
+        }
+        std::sort(bins.begin(), bins.end(),
+                  [](const Event *l, const Event *r) { return *l < *r; });
+    }
+
+    return bins;
+}
+
+Event *
+EventQueue::detachBins()
+{
+    if (calBuckets.empty()) {
+        Event *bins = head;
+        head = NULL;
+        return bins;
+    }
+
+    std::vector<Event *> bins = sortedBins();
+    Event *first = NULL;
+    for (auto it = bins.rbegin(); it != bins.rend(); ++it) {
+        (*it)->nextBin = first;
+        first = *it;
+    }
+
+    std::fill(calBuckets.begin(), calBuckets.end(), nullptr);
+    head = NULL;
+    return first;
+}
+
+void
+EventQueue::attachBins(Event *bins)
+{
+    assert(!head);
+
+    head = bins;
+    if (calBuckets.empty())
+        return;
+
+    // The bins are sorted, so appending them to their bucket keeps
+    // every bucket sorted as well
+    std::vector<Event *> tails(calBuckets.size(), nullptr);
+    while (bins) {
+        Event *bin = bins;
+        bins = bins->nextBin;
+        bin->nextBin = NULL;
+
+        const size_t idx = calBucket(bin->when());
+        if (tails[idx])
+            tails[idx]->nextBin = bin;
+        else
+            calBuckets[idx] = bin;
+        tails[idx] = bin;
+    }
+}
+
+void
+EventQueue::setCalendar(unsigned num_buckets, Tick bucket_width)
+{
+    fatal_if(num_buckets && !isPowerOf2(num_buckets),
+             "%s: number of event queue buckets (%d) is not a power of 2.",
+             name(), num_buckets);
+    fatal_if(num_buckets && !isPowerOf2(bucket_width),
+             "%s: event queue bucket width (%d) is not a power of 2.",
+             name(), bucket_width);
+
+    Event *bins = detachBins();
+
+    calBuckets.assign(num_buckets, nullptr);
+    calShift = num_buckets ? floorLog2(bucket_width) : 0;
+    calMask = num_buckets ? num_buckets - 1 : 0;
+    calScanned = 0;
+    calSearches = 0;
+
+    attachBins(bins);
+}
+
 Event *
 EventQueue::serviceOne()
 {
@@ -202,18 +397,26 @@ EventQueue::serviceOne()
     Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
+    // In calendar mode the head is the top of its bucket's bin list
+    Event *&list = calBuckets.empty() ?
+        head : calBuckets[calBucket(event->when())];
+    assert(list == event);
+
     if (next) {
         // update the next bin pointer since it could be stale
-        next->nextBin = head->nextBin;
+        next->nextBin = event->nextBin;
 
         // pop the stack
-        head = next;
+        list = next;
     } else {
         // this was the only element on the 'in bin' list, so get rid of
         // the 'in bin' list and point to the next bin list
-        head = head->nextBin;
+        list = event->nextBin;
     }
 
+    if (!calBuckets.empty())
+        head = next ? next : calFindHead(event->when());
+
     // handle action
     if (!event->squashed()) {
         // forward current cycle to the time when this event occurs.
@@ -295,15 +498,11 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
-            Event *nextInBin = nextBin;
+        for (Event *nextInBin : sortedBins()) {
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -315,38 +514,60 @@ EventQueue::debugVerify() const
 {
     std::unordered_map<long, bool> map;
 
-    Tick time = 0;
-    short priority = 0;
+    // Every bucket of a calendar is a separately sorted bin list
+    std::vector<Event *> lists = calBuckets;
+    if (calBuckets.empty())
+        lists.push_back(head);
 
-    Event *nextBin = head;
-    while (nextBin) {
-        Event *nextInBin = nextBin;
-        while (nextInBin) {
-            if (nextInBin->when() < time) {
-                cprintf("time goes backwards!");
-                nextInBin->dump();
-                return false;
-            } else if (nextInBin->when() == time &&
-                       nextInBin->priority() < priority) {
-                cprintf("priority inverted!");
-                nextInBin->dump();
-                return false;
-            }
+    for (size_t idx = 0; idx < lists.size(); ++idx) {
+        Tick time = 0;
+        short priority = 0;
 
-            if (map[reinterpret_cast<long>(nextInBin)]) {
-                cprintf("Node already seen");
-                nextInBin->dump();
-                return false;
-            }
-            map[reinterpret_cast<long>(nextInBin)] = true;
+        Event *nextBin = lists[idx];
+        while (nextBin) {
+            Event *nextInBin = nextBin;
+            while (nextInBin) {
+                if (nextInBin->when() < time) {
+                    cprintf("time goes backwards!");
+                    nextInBin->dump();
+                    return false;
+                } else if (nextInBin->when() == time &&
+                           nextInBin->priority() < priority) {
+                    cprintf("priority inverted!");
+                    nextInBin->dump();
+                    return false;
+                }
+
+                if (!calBuckets.empty() &&
+                    calBucket(nextInBin->when()) != idx) {
+                    cprintf("event in the wrong bucket!");
+                    nextInBin->dump();
+                    return false;
+                }
+
+                if (map[reinterpret_cast<long>(nextInBin)]) {
+                    cprintf("Node already seen");
+                    nextInBin->dump();
+                    return false;
+                }
+                map[reinterpret_cast<long>(nextInBin)] = true;
+
+                time = nextInBin->when();
+                priority = nextInBin->priority();
 
-            time = nextInBin->when();
-            priority = nextInBin->priority();
+                nextInBin = nextInBin->nextInBin;
+            }
 
-            nextInBin = nextInBin->nextInBin;
+            nextBin = nextBin->nextBin;
         }
+    }
 
-        nextBin = nextBin->nextBin;
+    if (!calBuckets.empty()) {
+        std::vector<Event *> bins = sortedBins();
+        if (head != (bins.empty() ? NULL : bins.front())) {
+            cprintf("head is not the earliest bin!");
+            return false;
+        }
     }
 
     return true;
@@ -355,8 +576,8 @@ EventQueue::debugVerify() const
 Event*
 EventQueue::replaceHead(Event* s)
 {
-    Event* t = head;
-    head = s;
+    Event* t = detachBins();
+    attachBins(s);
     return t;
 }
 
@@ -416,7 +637,8 @@ Event::dump() const
 }
 
 EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+    : objName(n), head(NULL), _curTick(0), calShift(0), calMask(0),
+      calScanned(0), calSearches(0)
 {
 }
 
@@ -38,11 +38,13 @@
 #include <algorithm>
 #include <cassert>
 #include <climits>
+#include <cstddef>
 #include <functional>
 #include <iosfwd>
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
@@ -85,6 +87,12 @@ extern bool inParallelMode;
 //! is with in bounds.
 EventQueue *getEventQueue(uint32_t index);
 
+//! Switch all main event queues, including the ones that are created
+//! later, to the calendar organisation with the given number of
+//! buckets and bucket width (both powers of two). Passing zero
+//! buckets reverts to the sorted bin list.
+void setEventQueueCalendar(unsigned num_buckets, Tick bucket_width);
+
 inline EventQueue *curEventQueue() { return _curEventQueue; }
 inline void curEventQueue(EventQueue *q);
 
@@ -262,11 +270,17 @@ class Event : public EventBase, public Serializable
     // linear/constant, and the lookup/removal in 'nextInBin' is
     // constant/constant.  Hopefully this is a significant improvement
     // over the current fully linear insertion.
+    //
+    // When the owning queue is in calendar mode, the bin lists are
+    // kept per bucket and 'nextBin' only links bins that hash to the
+    // same bucket.
     Event *nextBin;
     Event *nextInBin;
 
     static Event *insertBefore(Event *event, Event *curr);
     static Event *removeItem(Event *event, Event *last);
+    static void insertBin(Event *&list, Event *event);
+    static void removeBin(Event *&list, Event *event);
 
     Tick _when;         //!< timestamp when event should be processed
     Priority _priority; //!< event priority
@@ -628,6 +642,48 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
+    /**
+     * Calendar organisation of the queue. When calBuckets is not
+     * empty, every bin is hashed on its tick into one of the buckets,
+     * each bucket covering 2^calShift consecutive ticks of a "year"
+     * that wraps around the calendar. Each bucket holds a sorted bin
+     * list, so an insert only walks the bins of its own bucket. The
+     * head pointer is still the earliest bin in the whole queue and
+     * is looked up again when it is removed. The bucket width follows
+     * the spread of the events, so that this lookup only scans a few
+     * buckets.
+     */
+    std::vector<Event *> calBuckets;
+    unsigned calShift;
+    size_t calMask;
+
+    //! Buckets scanned by the head lookups since the bucket width was
+    //! last adapted, and number of these lookups.
+    size_t calScanned;
+    size_t calSearches;
+
+    size_t calBucket(Tick when) const { return (when >> calShift) & calMask; }
+
+    //! Find the earliest bin in calendar mode, given that no event is
+    //! scheduled before 'from'.
+    Event *calFindHead(Tick from);
+
+    //! Account for a head lookup that scanned the given number of
+    //! buckets, widening the buckets when the lookups scan many of
+    //! them, and narrowing them when the next bin is almost always in
+    //! the bucket of the previous one.
+    void calAdapt(size_t scanned);
+
+    //! Unlink every bin from the queue and return them as a single
+    //! bin list sorted in time order.
+    Event *detachBins();
+
+    //! Insert a sorted bin list produced by detachBins().
+    void attachBins(Event *bins);
+
+    //! Return the top of every bin in time order.
+    std::vector<Event *> sortedBins() const;
+
     //! Mutex to protect async queue.
     UncontendedMutex async_queue_mutex;
 
@@ -955,6 +1011,26 @@ class EventQueue
     void unlock() { service_mutex.unlock(); }
     /**@}*/
 
+    /**
+     * Switch the organisation of the queue. With a non-zero number of
+     * buckets the queue uses a calendar of num_buckets buckets that
+     * are initially bucket_width ticks wide, otherwise a single sorted
+     * bin list. Events that are already scheduled are kept.
+     *
+     * @param num_buckets Number of buckets, a power of two or zero.
+     * @param bucket_width Ticks covered by a bucket, a power of two.
+     */
+    void setCalendar(unsigned num_buckets, Tick bucket_width);
+
+    bool calendarMode() const { return !calBuckets.empty(); }
+
+    //! @return The ticks currently covered by a calendar bucket.
+    Tick
+    bucketWidth() const
+    {
+        return calBuckets.empty() ? 0 : Tick(1) << calShift;
+    }
+
     /**
      * Reschedule an event after a checkpoint.
      *
@@ -1080,6 +1156,56 @@ class EventManager
     void setCurTick(Tick newVal) { eventq->setCurTick(newVal); }
 };
 
+/**
+ * Mix-in for event classes that are allocated with new for a single
+ * use, typically with the AutoDelete flag set. The storage of
+ * released events is kept on a per-thread free list and handed out
+ * again on the next allocation instead of going through the heap.
+ * Classes derived from T that are larger than T fall back to the
+ * global allocator.
+ */
+template <class T>
+class PooledEvent
+{
+  private:
+    struct FreeNode
+    {
+        FreeNode *next;
+    };
+
+    static thread_local FreeNode *freeList;
+
+  public:
+    static void *
+    operator new(std::size_t size)
+    {
+        static_assert(sizeof(T) >= sizeof(FreeNode));
+        if (size != sizeof(T) || !freeList)
+            return ::operator new(size);
+
+        FreeNode *node = freeList;
+        freeList = node->next;
+        return node;
+    }
+
+    static void
+    operator delete(void *ptr, std::size_t size)
+    {
+        if (size != sizeof(T)) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        FreeNode *node = static_cast<FreeNode *>(ptr);
+        node->next = freeList;
+        freeList = node;
+    }
+};
+
+template <class T>
+thread_local typename PooledEvent<T>::FreeNode *PooledEvent<T>::freeList =
+    nullptr;
+
 template <class T, void (T::* F)()>
 class EventWrapper : public Event
 {
@@ -1112,7 +1238,8 @@ class EventWrapper : public Event
     const char *description() const { return "EventWrapped"; }
 };
 
-class EventFunctionWrapper : public Event
+class EventFunctionWrapper : public Event,
+                             public PooledEvent<EventFunctionWrapper>
 {
   private:
       std::function<void(void)> callback;
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+// The event queues keep their own tick, but tracing reads the global one
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+/** Events that log their ids in the order they are processed. */
+class EventLog
+{
+  public:
+    /** @return A new event logging the given id. */
+    Event *
+    make(int id, Event::Priority priority = Event::Default_Pri)
+    {
+        events.emplace_back(new EventFunctionWrapper(
+            [this, id]() { order.push_back(id); },
+            "event " + std::to_string(id), false, priority));
+        return events.back().get();
+    }
+
+    /** Service a queue until it is empty, checking it on the way. */
+    void
+    run(EventQueue &eq)
+    {
+        while (!eq.empty()) {
+            ASSERT_TRUE(eq.debugVerify());
+            const Tick next = eq.nextTick();
+            eq.serviceOne();
+            ASSERT_EQ(eq.getCurTick(), next);
+        }
+    }
+
+    std::vector<int> order;
+
+  private:
+    std::vector<std::unique_ptr<Event>> events;
+};
+
+/** Organisations a queue is tested with: a sorted list, and calendars
+ * of which a year is shorter, and longer, than the spread of the
+ * scheduled ticks. */
+struct Calendar
+{
+    unsigned buckets;
+    Tick width;
+};
+
+const Calendar calendars[] = {{0, 0}, {1, 1}, {4, 4}, {8, 1}, {64, 16}};
+
+} // anonymous namespace
+
+/** The events are processed in the order of their ticks, whichever
+ * bucket and year of the calendar they fall in. */
+TEST(EventQueueTest, Ordering)
+{
+    const std::vector<Tick> ticks =
+        {5, 1, 1000, 17, 3, 64, 2, 4096 + 5, 33, 16, 15, 4, 100000, 0};
+    for (const Calendar &cal : calendars) {
+        SCOPED_TRACE(cal.buckets);
+        EventQueue eq("eq");
+        eq.setCalendar(cal.buckets, cal.width);
+        ASSERT_EQ(eq.calendarMode(), cal.buckets != 0);
+
+        EventLog log;
+        for (int id = 0; id < int(ticks.size()); ++id)
+            eq.schedule(log.make(id), ticks[id]);
+
+        log.run(eq);
+        ASSERT_EQ(log.order, std::vector<int>(
+                      {13, 1, 6, 4, 11, 0, 10, 9, 3, 8, 5, 2, 7, 12}));
+    }
+}
+
+/** The events of a tick are processed by priority, and the ones of a
+ * same priority in the reverse order of their scheduling. */
+TEST(EventQueueTest, TieBreaking)
+{
+    for (const Calendar &cal : calendars) {
+        SCOPED_TRACE(cal.buckets);
+        EventQueue eq("eq");
+        eq.setCalendar(cal.buckets, cal.width);
+
+        EventLog log;
+        eq.schedule(log.make(0), 8);
+        eq.schedule(log.make(1, Event::CPU_Tick_Pri), 8);
+        eq.schedule(log.make(2, Event::Sim_Exit_Pri), 8);
+        eq.schedule(log.make(3), 8);
+        eq.schedule(log.make(4, Event::CPU_Tick_Pri), 8);
+        eq.schedule(log.make(5), 7);
+        eq.schedule(log.make(6, Event::Minimum_Pri), 8);
+        eq.schedule(log.make(7), 8);
+
+        log.run(eq);
+        ASSERT_EQ(log.order, std::vector<int>({5, 6, 7, 3, 0, 4, 1, 2}));
+    }
+}
+
+/** Events descheduled and rescheduled, including the head and the other
+ * events of its bin, leave the rest in order. */
+TEST(EventQueueTest, Deschedule)
+{
+    for (const Calendar &cal : calendars) {
+        SCOPED_TRACE(cal.buckets);
+        EventQueue eq("eq");
+        eq.setCalendar(cal.buckets, cal.width);
+
+        EventLog log;
+        std::vector<Event *> events;
+        for (int id = 0; id < 6; ++id) {
+            events.push_back(log.make(id));
+            eq.schedule(events.back(), 10 + id / 2);
+        }
+
+        // The head, and the top of another bin
+        eq.deschedule(events[1]);
+        ASSERT_EQ(eq.getHead(), events[0]);
+        eq.deschedule(events[3]);
+        ASSERT_TRUE(eq.debugVerify());
+
+        // Move the head a year later, and a later event before it
+        eq.reschedule(events[0], 1000);
+        eq.reschedule(events[5], 3);
+        ASSERT_EQ(eq.getHead(), events[5]);
+        ASSERT_EQ(eq.nextTick(), 3);
+
+        log.run(eq);
+        ASSERT_EQ(log.order, std::vector<int>({5, 2, 4, 0}));
+    }
+}
+
+/** A calendar processes random schedules in the same order as a sorted
+ * list, and keeps the events it is switched with. */
+TEST(EventQueueTest, MatchesList)
+{
+    std::mt19937 rng(1);
+    for (const Calendar &cal : calendars) {
+        SCOPED_TRACE(cal.buckets);
+        EventQueue list("list");
+        EventQueue calendar("calendar");
+        EventLog list_log;
+        EventLog calendar_log;
+        std::vector<std::pair<Event *, Event *>> events;
+
+        for (int id = 0; id < 1000; ++id) {
+            // Switch to the calendar with events in the queue
+            if (id == 100)
+                calendar.setCalendar(cal.buckets, cal.width);
+
+            const unsigned action = rng() % 8;
+            if (action < 5 || events.empty()) {
+                const Tick when = list.getCurTick() + rng() % 300;
+                const auto priority = Event::Priority(rng() % 3);
+                events.emplace_back(list_log.make(id, priority),
+                                    calendar_log.make(id, priority));
+                list.schedule(events.back().first, when);
+                calendar.schedule(events.back().second, when);
+            } else if (action < 7) {
+                auto &pair = events[rng() % events.size()];
+                const Tick when = list.getCurTick() + rng() % 300;
+                list.reschedule(pair.first, when, true);
+                calendar.reschedule(pair.second, when, true);
+            } else if (!list.empty()) {
+                ASSERT_FALSE(calendar.empty());
+                ASSERT_EQ(calendar.nextTick(), list.nextTick());
+                list.serviceOne();
+                calendar.serviceOne();
+            }
+            ASSERT_TRUE(calendar.debugVerify());
+        }
+        ASSERT_EQ(calendar_log.order, list_log.order);
+
+        // And back to the list, before draining both
+        calendar.setCalendar(0, 0);
+        list_log.run(list);
+        calendar_log.run(calendar);
+        ASSERT_EQ(calendar_log.order, list_log.order);
+    }
+}
+
+/** The buckets of a calendar widen when the events are spread over more
+ * than a year, and narrow when they pile up in a few buckets. */
+TEST(EventQueueTest, AdaptsBucketWidth)
+{
+    EventQueue sparse("sparse");
+    sparse.setCalendar(16, 1);
+    EventLog sparse_log;
+    for (int id = 0; id < 1000; ++id)
+        sparse.schedule(sparse_log.make(id), 1024 * (id + 1));
+    sparse_log.run(sparse);
+    ASSERT_GT(sparse.bucketWidth(), 64);
+
+    EventQueue dense("dense");
+    dense.setCalendar(16, 1024);
+    EventLog dense_log;
+    for (int id = 0; id < 1000; ++id)
+        dense.schedule(dense_log.make(id), id + 1);
+    dense_log.run(dense);
+    ASSERT_LT(dense.bucketWidth(), 1024);
+
+    // Either way, the events are processed in order
+    std::vector<int> order(1000);
+    for (int id = 0; id < 1000; ++id)
+        order[id] = id;
+    ASSERT_EQ(sparse_log.order, order);
+    ASSERT_EQ(dense_log.order, order);
+}
@@ -109,6 +109,47 @@ struct PacketInfo
 typedef ProbePointArg<PacketInfo> Packet;
 typedef std::unique_ptr<Packet> PacketUPtr;
 
+/**
+ * A load whose value a core's value predictor has found to be constant,
+ * reported through the ConstantLoad probe point of the core.
+ */
+struct ConstantLoadInfo
+{
+    /** Data address of the load. */
+    Addr addr;
+    /** PC of the load. */
+    Addr pc;
+    /** The loaded value, only the lowest size bytes are meaningful. */
+    uint64_t value;
+    /** Size of the load, in bytes. */
+    unsigned size;
+};
+
+typedef ProbePointArg<ConstantLoadInfo> ConstantLoad;
+
+/**
+ * A load value seen by a core's value predictor, reported through the
+ * LoadValue probe point of the core: either the value predicted for a
+ * load at decode, or the value the load returned.
+ */
+struct LoadValueInfo
+{
+    /** Thread of the load. */
+    ThreadID tid;
+    /** PC of the load. */
+    Addr pc;
+    /** Data address of the load, unknown (0) for predictions. */
+    Addr addr;
+    /** The value. */
+    uint64_t value;
+    /** Size of the load, in bytes, unknown (0) for predictions. */
+    unsigned size;
+    /** Whether the value is a prediction rather than the loaded value. */
+    bool predicted;
+};
+
+typedef ProbePointArg<LoadValueInfo> LoadValue;
+
 } // namespace probing
 
 } // namespace gem5
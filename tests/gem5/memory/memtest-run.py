@@ -29,9 +29,21 @@ from m5.objects import *
 m5.util.addToPath('../../../configs/')
 from common.Caches import *
 
+import argparse
+
+parser = argparse.ArgumentParser(description='Multi-core memory tester')
+parser.add_argument('--percent-clean', type=int, default=0,
+                    help='Percentage of the accesses that are cache cleans')
+parser.add_argument('--functional-warming', action='store_true',
+                    help='Run atomic accesses, functionally warming the '
+                    'caches')
+
+args = parser.parse_args()
+
 #MAX CORES IS 8 with the fals sharing method
 nb_cores = 8
-cpus = [MemTest(max_loads = 1e5, progress_interval = 1e4)
+cpus = [MemTest(max_loads = 1e5, progress_interval = 1e4,
+                percent_clean = args.percent_clean)
         for i in range(nb_cores) ]
 
 # system simulated
@@ -49,7 +61,8 @@ system.cpu_clk_domain = SrcClockDomain(clock = '2GHz',
                                        voltage_domain = system.voltage_domain)
 
 system.toL2Bus = L2XBar(clk_domain = system.cpu_clk_domain)
-system.l2c = L2Cache(clk_domain = system.cpu_clk_domain, size='64kB', assoc=8)
+system.l2c = L2Cache(clk_domain = system.cpu_clk_domain, size='64kB', assoc=8,
+                     functional_warming = args.functional_warming)
 system.l2c.cpu_side = system.toL2Bus.mem_side_ports
 
 # connect l2c to membus
@@ -59,7 +72,8 @@ system.l2c.mem_side = system.membus.cpu_side_ports
 for cpu in cpus:
     # All cpus are associated with cpu_clk_domain
     cpu.clk_domain = system.cpu_clk_domain
-    cpu.l1c = L1Cache(size = '32kB', assoc = 4)
+    cpu.l1c = L1Cache(size = '32kB', assoc = 4,
+                      functional_warming = args.functional_warming)
     cpu.l1c.cpu_side = cpu.port
     cpu.l1c.mem_side = system.toL2Bus.cpu_side_ports
 
@@ -74,7 +88,7 @@ system.physmem.port = system.membus.mem_side_ports
 # -----------------------
 
 root = Root( full_system = False, system = system )
-root.system.mem_mode = 'timing'
+root.system.mem_mode = 'atomic' if args.functional_warming else 'timing'
 
 m5.instantiate()
 exit_event = m5.simulate()
@@ -29,6 +29,8 @@ Test file for simple memory test
 TODO: Add stats checking
 '''
 
+import re
+
 from testlib import *
 
 gem5_verify_config(
@@ -67,6 +69,27 @@ gem5_verify_config(
     valid_isas=(constants.null_tag,),
 )
 
+# Cache cleans snoop the dirty blocks, and the writebacks of the other
+# caches, and complete only once the dirty data reaches the PoC
+gem5_verify_config(
+    name='memtest-clean',
+    verifiers=(), # No need for verfiers this will return non-zero on fail
+    config=joinpath(getcwd(), 'memtest-run.py'),
+    config_args = ['--percent-clean', '10'],
+    valid_isas=(constants.null_tag,),
+)
+
+# The L2 only sees coherent reads and writebacks, which still have to be
+# serviced on the functional warming fast path
+gem5_verify_config(
+    name='memtest-functional-warming',
+    verifiers=(verifier.MatchFileRegex(
+        re.compile(r'system\.l2c\.warmHits\s+[1-9]'), ['stats.txt']),),
+    config=joinpath(getcwd(), 'memtest-run.py'),
+    config_args = ['--functional-warming'],
+    valid_isas=(constants.null_tag,),
+)
+
 null_tests = [
     ('garnet_synth_traffic', None, ['--sim-cycles', '5000000']),
     ('memcheck', None, ['--maxtick', '2000000000', '--prefetchers']),
@@ -0,0 +1,251 @@
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import unittest
+from unittest import mock
+
+try:
+    from gem5.components.processors.cpu_types import CPUTypes
+    from gem5.simulate import sampled_simulator
+    from gem5.simulate.sampled_simulator import SampledSimulator
+except ImportError:
+    # The CPU models, and the sampling controller, are not built for the
+    # NULL ISA
+    sampled_simulator = None
+
+
+class _Log:
+    """The calls the simulator makes on the fakes, in order."""
+
+    def __init__(self):
+        self.calls = []
+
+
+class _FakeCPU:
+    def __init__(self, log, name):
+        self._log = log
+        self._name = name
+
+    def scheduleInstStop(self, tid, insts, cause):
+        self._log.calls.append((self._name, insts))
+
+    def warmLoadValuesFrom(self, cpu):
+        self._log.calls.append(("warm", cpu._name))
+
+
+class _FakeCore:
+    def __init__(self, log, name, cpu_type):
+        self._cpu = _FakeCPU(log, name)
+        self._type = cpu_type
+
+    def get_simobject(self):
+        return self._cpu
+
+    def get_type(self):
+        return self._type
+
+
+class _FakeProcessor:
+    def __init__(self, log, fast, detailed):
+        self._log = log
+        self._cores = [fast, detailed]
+
+    def get_cores(self):
+        return [self._cores[0]]
+
+    def switch(self):
+        self._cores.reverse()
+        self._log.calls.append("switch")
+
+
+class _FakeController:
+    """Gives the IPCs of the windows in turn, with a fixed interval."""
+
+    def __init__(self, log, ipcs, confidence):
+        self._log = log
+        self._ipcs = list(ipcs)
+        self._measured = []
+        self._confidence = confidence
+
+    def startMeasurement(self):
+        self._log.calls.append("start")
+
+    def endMeasurement(self):
+        self._log.calls.append("end")
+        self._measured.append(self._ipcs.pop(0))
+        return self._measured[-1]
+
+    def numSamples(self):
+        return len(self._measured)
+
+    def ipcMean(self):
+        if not self._measured:
+            return 0
+        return sum(self._measured) / len(self._measured)
+
+    def ipcConfidence(self):
+        return self._confidence
+
+
+class _FakeExitEvent:
+    def __init__(self, cause):
+        self._cause = cause
+
+    def getCause(self):
+        return self._cause
+
+
+@unittest.skipIf(sampled_simulator is None, "needs the CPU models")
+class SampledSimulatorTestSuite(unittest.TestCase):
+    """Test cases for the phase loop of the SampledSimulator."""
+
+    def _make_simulator(
+        self,
+        detailed_warming_insts=20,
+        max_samples=None,
+        target_error=None,
+        min_samples=2,
+        ipcs=(1.0, 2.0, 3.0, 4.0),
+        confidence=0.5,
+    ):
+        # Set up what __init__ would, without a board to simulate
+        self.log = _Log()
+        fast = _FakeCore(self.log, "atomic", CPUTypes.ATOMIC)
+        detailed = _FakeCore(self.log, "o3", CPUTypes.O3)
+        simulator = SampledSimulator.__new__(SampledSimulator)
+        simulator._instantiated = False
+        simulator._last_exit_event = None
+        simulator._fast_cores = [fast]
+        simulator._detailed_cores = [detailed]
+        simulator._processor = _FakeProcessor(self.log, fast, detailed)
+        simulator._controller = _FakeController(self.log, ipcs, confidence)
+        simulator._functional_warming_insts = 100
+        simulator._detailed_warming_insts = detailed_warming_insts
+        simulator._measurement_insts = 10
+        simulator._max_samples = max_samples
+        simulator._target_error = target_error
+        simulator._min_samples = min_samples
+        simulator._phase = None
+
+        def instantiate():
+            simulator._instantiated = True
+
+        simulator._instantiate = instantiate
+        return simulator
+
+    def _run(self, simulator, causes=None):
+        """Runs the simulator, every phase ending at its stop."""
+        causes = list(causes or [])
+
+        def simulate(max_ticks):
+            if causes:
+                return _FakeExitEvent(causes.pop(0))
+            return _FakeExitEvent(SampledSimulator._phase_cause)
+
+        with mock.patch.object(sampled_simulator.m5, "simulate", simulate):
+            simulator.run()
+
+    def test_phases(self) -> None:
+        simulator = self._make_simulator(max_samples=2)
+        self._run(simulator)
+
+        window = [
+            "switch",
+            ("o3", 20),
+            "start",
+            ("o3", 10),
+            "end",
+            "switch",
+        ]
+        self.assertEqual(
+            [("warm", "atomic"), ("atomic", 100)]
+            + window
+            + [("atomic", 100)]
+            + window[:-1],
+            self.log.calls,
+        )
+        self.assertEqual((1.5, 0.5, 2), simulator.get_ipc_estimate())
+
+    def test_no_detailed_warming(self) -> None:
+        simulator = self._make_simulator(
+            detailed_warming_insts=0, max_samples=1
+        )
+        self._run(simulator)
+
+        self.assertEqual(
+            [
+                ("warm", "atomic"),
+                ("atomic", 100),
+                "switch",
+                "start",
+                ("o3", 10),
+                "end",
+            ],
+            self.log.calls,
+        )
+
+    def test_target_error(self) -> None:
+        # A 0.5 interval is within 25% of a mean of 2 or more, which the
+        # third window gets to, being past the minimum of 2
+        simulator = self._make_simulator(target_error=0.25)
+        self._run(simulator)
+        self.assertEqual(3, simulator.get_ipc_estimate()[2])
+
+        # But not within 10% of it
+        simulator = self._make_simulator(target_error=0.1, max_samples=4)
+        self._run(simulator)
+        self.assertEqual(4, simulator.get_ipc_estimate()[2])
+
+    def test_min_samples(self) -> None:
+        # The interval is within the target right away, but the estimate
+        # needs the minimum number of windows
+        simulator = self._make_simulator(
+            target_error=0.5, min_samples=3, confidence=0.0
+        )
+        self._run(simulator)
+        self.assertEqual(3, simulator.get_ipc_estimate()[2])
+
+    def test_other_exit_events(self) -> None:
+        # The exits other than the end of a phase go to the exit event
+        # handlers, without moving on to the next phase
+        simulator = self._make_simulator(max_samples=1)
+        handled = []
+
+        def handle_exit_event():
+            handled.append(simulator.get_last_exit_event_cause())
+            return False
+
+        simulator._handle_exit_event = handle_exit_event
+        self._run(simulator, causes=["checkpoint", "dump stats"])
+
+        self.assertEqual(["checkpoint", "dump stats"], handled)
+        self.assertEqual(1, simulator.get_ipc_estimate()[2])
+
+        # And the run ends if a handler says so
+        simulator = self._make_simulator(max_samples=1)
+        simulator._handle_exit_event = lambda: True
+        self._run(simulator, causes=["user interrupt"])
+        self.assertEqual(0, simulator.get_ipc_estimate()[2])